@@ -4,6 +4,8 @@
 #include "Camera/CameraComponent.h"
 #include "Core/VCCharacterBase.h"
 #include "VoxelCharacterPlugin.h"
+#include "Core/VCBudgetWatchdog.h"
+#include "Core/VCPerfReport.h"
 
 UVCCameraManager::UVCCameraManager()
 {
@@ -52,6 +54,9 @@ void UVCCameraManager::PopCameraMode()
 
 void UVCCameraManager::UpdateCamera(float DeltaTime)
 {
+	VC_PERF_SCOPE(VCCamera, UpdateCamera);
+	FVCBudgetScope Budget(EVCBudget::Camera, GetOwner());
+
 	if (CameraModeStack.Num() == 0)
 	{
 		return;
@@ -162,6 +167,8 @@ float UVCCameraManager::GetTopModeBlendWeight() const
 
 FVector UVCCameraManager::ResolveVoxelCameraCollision(const FVector& IdealLocation, const FVector& PivotLocation) const
 {
+	VC_PERF_SCOPE(VCCamera, Collision);
+
 	const UWorld* World = GetWorld();
 	if (!World)
 	{
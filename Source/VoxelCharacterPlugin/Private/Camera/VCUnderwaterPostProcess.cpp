@@ -8,6 +8,7 @@
 #include "GameFramework/Character.h"
 #include "GameFramework/PlayerController.h"
 #include "VoxelCharacterPlugin.h"
+#include "Core/VCBudgetWatchdog.h"
 
 UVCUnderwaterPostProcess::UVCUnderwaterPostProcess()
 {
@@ -79,6 +80,7 @@ void UVCUnderwaterPostProcess::TickComponent(float DeltaTime, ELevelTick TickTyp
 	{
 		return;
 	}
+	FVCBudgetScope Budget(EVCBudget::UnderwaterPP, GetOwner());
 
 	const bool bUnderwater = IsCameraUnderwater();
 
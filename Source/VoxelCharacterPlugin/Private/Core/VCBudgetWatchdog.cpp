@@ -0,0 +1,198 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#include "Core/VCBudgetWatchdog.h"
+#include "Core/VCPerfReport.h"
+#include "Movement/VCVoxelNavigationHelper.h"
+#include "VoxelChunkManager.h"
+#include "VoxelCoordinates.h"
+#include "VoxelWorldConfiguration.h"
+#include "VoxelCharacterPlugin.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+// Read on every watched scope, so plain variables behind console refs rather than CVar lookups.
+static int32 GVCBudgetEnable = 1;
+static float GVCBudgetMs[static_cast<int32>(EVCBudget::Num)] = { 0.5f, 0.5f, 0.25f, 2.0f, 1.0f, 2.0f };
+
+static FAutoConsoleVariableRef CVarVCBudgetEnable(
+	TEXT("vc.Budget.Enable"), GVCBudgetEnable,
+	TEXT("Record plugin systems that exceed their per-frame budget (vc.Budget.Dump)."), ECVF_Default);
+static FAutoConsoleVariableRef CVarVCBudgetTerrainRefresh(
+	TEXT("vc.Budget.TerrainRefreshMs"), GVCBudgetMs[static_cast<int32>(EVCBudget::TerrainRefresh)],
+	TEXT("Budget (ms) for one movement terrain context refresh. 0 = unwatched."), ECVF_Default);
+static FAutoConsoleVariableRef CVarVCBudgetCamera(
+	TEXT("vc.Budget.CameraMs"), GVCBudgetMs[static_cast<int32>(EVCBudget::Camera)],
+	TEXT("Budget (ms) for one camera update. 0 = unwatched."), ECVF_Default);
+static FAutoConsoleVariableRef CVarVCBudgetUnderwaterPP(
+	TEXT("vc.Budget.UnderwaterPPMs"), GVCBudgetMs[static_cast<int32>(EVCBudget::UnderwaterPP)],
+	TEXT("Budget (ms) for one underwater post-process update. 0 = unwatched."), ECVF_Default);
+static FAutoConsoleVariableRef CVarVCBudgetMapRefresh(
+	TEXT("vc.Budget.MapRefreshMs"), GVCBudgetMs[static_cast<int32>(EVCBudget::MapRefresh)],
+	TEXT("Budget (ms) for one minimap / world map texture refresh. 0 = unwatched."), ECVF_Default);
+static FAutoConsoleVariableRef CVarVCBudgetMarkerGather(
+	TEXT("vc.Budget.MarkerGatherMs"), GVCBudgetMs[static_cast<int32>(EVCBudget::MarkerGather)],
+	TEXT("Budget (ms) for one map marker gather + layout. 0 = unwatched."), ECVF_Default);
+static FAutoConsoleVariableRef CVarVCBudgetEditApply(
+	TEXT("vc.Budget.EditApplyMs"), GVCBudgetMs[static_cast<int32>(EVCBudget::EditApply)],
+	TEXT("Budget (ms) for applying one voxel edit on the server. 0 = unwatched."), ECVF_Default);
+
+static FAutoConsoleCommand GVCBudgetDumpCmd(
+	TEXT("vc.Budget.Dump"),
+	TEXT("Log recent over-budget events (newest first) and per-system totals. Args: [MaxEvents]."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		FVCBudgetWatchdog::DumpToLog(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : FVCBudgetWatchdog::RingCapacity);
+	}));
+
+static FAutoConsoleCommand GVCBudgetResetCmd(
+	TEXT("vc.Budget.Reset"),
+	TEXT("Clear recorded over-budget events."),
+	FConsoleCommandDelegate::CreateStatic(&FVCBudgetWatchdog::Reset));
+
+// ---------------------------------------------------------------------------
+// Watchdog
+// ---------------------------------------------------------------------------
+
+TArray<FVCBudgetEvent> FVCBudgetWatchdog::Ring;
+int32 FVCBudgetWatchdog::RingNext = 0;
+int64 FVCBudgetWatchdog::OverrunCounts[static_cast<int32>(EVCBudget::Num)] = {};
+float FVCBudgetWatchdog::WorstMs[static_cast<int32>(EVCBudget::Num)] = {};
+
+const TCHAR* FVCBudgetWatchdog::GetBudgetName(EVCBudget Budget)
+{
+	switch (Budget)
+	{
+	case EVCBudget::TerrainRefresh: return TEXT("TerrainRefresh");
+	case EVCBudget::Camera:         return TEXT("Camera");
+	case EVCBudget::UnderwaterPP:   return TEXT("UnderwaterPP");
+	case EVCBudget::MapRefresh:     return TEXT("MapRefresh");
+	case EVCBudget::MarkerGather:   return TEXT("MarkerGather");
+	case EVCBudget::EditApply:      return TEXT("EditApply");
+	default:                        return TEXT("?");
+	}
+}
+
+float FVCBudgetWatchdog::GetBudgetMs(EVCBudget Budget)
+{
+	return GVCBudgetEnable != 0 && Budget < EVCBudget::Num ? FMath::Max(GVCBudgetMs[static_cast<int32>(Budget)], 0.0f) : 0.0f;
+}
+
+void FVCBudgetWatchdog::RecordOverrun(FVCBudgetEvent&& Event)
+{
+	const int32 Index = static_cast<int32>(Event.Budget);
+	++OverrunCounts[Index];
+	WorstMs[Index] = FMath::Max(WorstMs[Index], Event.Milliseconds);
+
+	CSV_EVENT_GLOBAL(TEXT("VCBudget %s %.2fms"), GetBudgetName(Event.Budget), Event.Milliseconds);
+	if (FVCPerfCapture::IsCapturing())
+	{
+		FVCPerfCapture::RecordValue(*FString::Printf(TEXT("VCBudget/%s"), GetBudgetName(Event.Budget)), Event.Milliseconds);
+	}
+
+	if (Ring.Num() < RingCapacity)
+	{
+		Ring.Add(MoveTemp(Event));
+	}
+	else
+	{
+		Ring[RingNext] = MoveTemp(Event);
+	}
+	RingNext = (RingNext + 1) % RingCapacity;
+}
+
+void FVCBudgetWatchdog::DumpToLog(int32 MaxEvents)
+{
+	UE_LOG(LogVoxelCharacter, Log, TEXT("=== Budget overruns (frame %llu) ==="), GFrameCounter);
+	for (int32 i = 0; i < static_cast<int32>(EVCBudget::Num); ++i)
+	{
+		const EVCBudget Budget = static_cast<EVCBudget>(i);
+		UE_LOG(LogVoxelCharacter, Log, TEXT("  %-15s budget %.2f ms  overruns %lld  worst %.2f ms"),
+			GetBudgetName(Budget), GetBudgetMs(Budget), OverrunCounts[i], WorstMs[i]);
+	}
+
+	// Newest first: walk back from the slot before RingNext.
+	const int32 NumShown = FMath::Clamp(MaxEvents, 0, Ring.Num());
+	for (int32 n = 0; n < NumShown; ++n)
+	{
+		const FVCBudgetEvent& Event = Ring[(RingNext - 1 - n + RingCapacity) % RingCapacity];
+		FString Details;
+		if (!Event.Context.IsEmpty())
+		{
+			Details += FString::Printf(TEXT("  %s"), *Event.Context);
+		}
+		if (Event.bHasChunk)
+		{
+			Details += FString::Printf(TEXT("  chunk (%d,%d,%d)"), Event.Chunk.X, Event.Chunk.Y, Event.Chunk.Z);
+		}
+		if (Event.Count != INDEX_NONE)
+		{
+			Details += FString::Printf(TEXT("  count %d"), Event.Count);
+		}
+		UE_LOG(LogVoxelCharacter, Log, TEXT("  [frame %llu] %-15s %.2f / %.2f ms%s"),
+			Event.Frame, GetBudgetName(Event.Budget), Event.Milliseconds, Event.BudgetMilliseconds, *Details);
+	}
+}
+
+void FVCBudgetWatchdog::Reset()
+{
+	Ring.Reset();
+	RingNext = 0;
+	for (int32 i = 0; i < static_cast<int32>(EVCBudget::Num); ++i)
+	{
+		OverrunCounts[i] = 0;
+		WorstMs[i] = 0.0f;
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Scope
+// ---------------------------------------------------------------------------
+
+FVCBudgetScope::FVCBudgetScope(EVCBudget InBudget, const UObject* InContext)
+	: Context(InContext)
+	, Budget(InBudget)
+{
+	if (FVCBudgetWatchdog::GetBudgetMs(Budget) > 0.0f && IsInGameThread())
+	{
+		StartCycles = FPlatformTime::Cycles64();
+	}
+}
+
+FVCBudgetScope::~FVCBudgetScope()
+{
+	if (StartCycles == 0)
+	{
+		return;
+	}
+
+	const float BudgetMs = FVCBudgetWatchdog::GetBudgetMs(Budget);
+	const float Ms = static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles));
+	if (BudgetMs <= 0.0f || Ms <= BudgetMs)
+	{
+		return;
+	}
+
+	// Over budget: resolve the context now (the rare path).
+	FVCBudgetEvent Event;
+	Event.Budget = Budget;
+	Event.Milliseconds = Ms;
+	Event.BudgetMilliseconds = BudgetMs;
+	Event.Frame = GFrameCounter;
+	Event.Time = FPlatformTime::Seconds();
+	Event.Count = Count;
+	if (Context)
+	{
+		Event.Context = Context->GetName();
+	}
+	if (Location.IsSet() && Context)
+	{
+		UVoxelChunkManager* ChunkMgr = FVCVoxelNavigationHelper::FindChunkManager(Context->GetWorld());
+		const UVoxelWorldConfiguration* Config = ChunkMgr ? ChunkMgr->GetConfiguration() : nullptr;
+		if (Config)
+		{
+			Event.Chunk = FVoxelCoordinates::WorldToChunk(Location.GetValue() - Config->WorldOrigin, Config->ChunkSize, Config->VoxelSize);
+			Event.bHasChunk = true;
+		}
+	}
+	FVCBudgetWatchdog::RecordOverrun(MoveTemp(Event));
+}
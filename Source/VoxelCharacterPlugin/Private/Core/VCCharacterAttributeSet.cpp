@@ -1,6 +1,7 @@
 // Copyright Daniel Raquel. All Rights Reserved.
 
 #include "Core/VCCharacterAttributeSet.h"
+#include "Core/VCNetTrafficTracker.h"
 #include "Net/UnrealNetwork.h"
 #include "GameplayEffectExtension.h"
 #include "VoxelCharacterPlugin.h"
@@ -84,6 +85,51 @@ void UVCCharacterAttributeSet::PostGameplayEffectExecute(const FGameplayEffectMo
 	}
 }
 
+// ---------------------------------------------------------------------------
+// Post-change (bandwidth accounting)
+// ---------------------------------------------------------------------------
+
+void UVCCharacterAttributeSet::PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue)
+{
+	Super::PostAttributeChange(Attribute, OldValue, NewValue);
+	if (OldValue != NewValue)
+	{
+		RecordReplicatedChange(Attribute, /*bBaseValue=*/false);
+	}
+}
+
+void UVCCharacterAttributeSet::PostAttributeBaseChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue) const
+{
+	Super::PostAttributeBaseChange(Attribute, OldValue, NewValue);
+	if (OldValue != NewValue)
+	{
+		RecordReplicatedChange(Attribute, /*bBaseValue=*/true);
+	}
+}
+
+void UVCCharacterAttributeSet::RecordReplicatedChange(const FGameplayAttribute& Attribute, bool bBaseValue) const
+{
+	// IncomingDamage is a meta attribute and never replicates.
+	const FProperty* Property = Attribute.GetUProperty();
+	if (!Property || Attribute == GetIncomingDamageAttribute())
+	{
+		return;
+	}
+
+	const AActor* Owner = GetOwningActor();
+	if (!Owner || !Owner->HasAuthority())
+	{
+		return;
+	}
+
+	// FGameplayAttributeData replicates BaseValue and CurrentValue as separate float fields; the
+	// FName number keeps them apart without building a string.
+	if (UVCNetTrafficTracker* NetTraffic = UVCNetTrafficTracker::Get(Owner))
+	{
+		NetTraffic->RecordPropertyChange(Owner, EVCNetTraffic::Attributes, FName(Property->GetFName(), bBaseValue ? 2 : 1), 32);
+	}
+}
+
 // ---------------------------------------------------------------------------
 // OnRep
 // ---------------------------------------------------------------------------
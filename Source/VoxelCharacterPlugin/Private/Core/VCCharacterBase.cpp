@@ -4,6 +4,9 @@
 #include "Core/VCPlayerState.h"
 #include "Core/VCCharacterAttributeSet.h"
 #include "Core/VCPlayerController.h"
+#include "Core/VCEditLatencyTracker.h"
+#include "Core/VCNetTrafficTracker.h"
+#include "Core/VCPerfReport.h"
 #include "Camera/VCCameraManager.h"
 #include "Camera/VCFirstPersonCameraMode.h"
 #include "Camera/VCThirdPersonCameraMode.h"
@@ -231,6 +234,8 @@ void AVCCharacterBase::Tick(float DeltaSeconds)
 	if (bIsWaitingForTerrain)
 	{
 		TerrainWaitElapsed += DeltaSeconds;
+		CSV_CUSTOM_STAT(VCSpawn, TerrainWaitSeconds, TerrainWaitElapsed, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(VCSpawn, PendingChunks, PendingTerrainChunks.Num(), ECsvCustomStatOp::Set);
 
 		// Periodic poll every 2s: re-check HasCollision and re-request dropped chunks
 		if (PendingTerrainChunks.Num() > 0 && FMath::Fmod(TerrainWaitElapsed, 2.0f) < DeltaSeconds)
@@ -379,6 +384,12 @@ void AVCCharacterBase::BindAttributeChangeDelegates(UAbilitySystemComponent* ASC
 			UVCCharacterAttributeSet::GetMoveSpeedMultiplierAttribute()
 		).AddUObject(MovComp, &UVCMovementComponent::OnMoveSpeedAttributeChanged);
 	}
+
+	// Input -> activation latency (tracker ignores ASCs it already watches)
+	if (UVCEditLatencyTracker* LatencyTracker = UVCEditLatencyTracker::Get(this))
+	{
+		LatencyTracker->ObserveAbilitySystem(ASC);
+	}
 }
 
 void AVCCharacterBase::GrantDefaultAbilities(UAbilitySystemComponent* ASC)
@@ -479,6 +490,13 @@ void AVCCharacterBase::SetViewMode(EVCViewMode NewMode)
 	if (HasAuthority())
 	{
 		OnRep_ViewMode();
+
+		// An enum replicates in just enough bits for its values.
+		static const int32 ViewModeBits = FMath::CeilLogTwo(static_cast<uint32>(StaticEnum<EVCViewMode>()->GetMaxEnumValue()) + 1);
+		if (UVCNetTrafficTracker* NetTraffic = UVCNetTrafficTracker::Get(this))
+		{
+			NetTraffic->RecordPropertyChange(this, EVCNetTraffic::ViewMode, GET_MEMBER_NAME_CHECKED(AVCCharacterBase, CurrentViewMode), ViewModeBits);
+		}
 	}
 }
 
@@ -690,6 +708,9 @@ void AVCCharacterBase::PlaceOnTerrainAndResume()
 	GetCharacterMovement()->SetMovementMode(MOVE_Walking);
 	bIsWaitingForTerrain = false;
 
+	CSV_EVENT(VCSpawn, TEXT("TerrainReady %.2fs"), TerrainWaitElapsed);
+	FVCPerfCapture::RecordValue(TEXT("VCSpawn/TerrainWait"), TerrainWaitElapsed * 1000.0);
+
 	UE_LOG(LogVoxelCharacter, Log,
 		TEXT("Terrain ready — ActorCollision=%s, CapsuleCollision=%s, MovementMode=%d"),
 		GetActorEnableCollision() ? TEXT("Enabled") : TEXT("DISABLED"),
@@ -1205,6 +1226,11 @@ void AVCCharacterBase::Input_StopJump(const FInputActionValue& Value)
 
 void AVCCharacterBase::Input_Interact(const FInputActionValue& Value)
 {
+	if (UVCEditLatencyTracker* LatencyTracker = UVCEditLatencyTracker::Get(this))
+	{
+		LatencyTracker->RecordActionInput();
+	}
+
 #if WITH_INTERACTION_PLUGIN
 	if (InteractionComponent)
 	{
@@ -1224,6 +1250,11 @@ void AVCCharacterBase::Input_ToggleView(const FInputActionValue& Value)
 
 void AVCCharacterBase::Input_PrimaryAction(const FInputActionValue& Value)
 {
+	if (UVCEditLatencyTracker* LatencyTracker = UVCEditLatencyTracker::Get(this))
+	{
+		LatencyTracker->RecordActionInput();
+	}
+
 	// Priority chain: GAS ability -> equipped item action -> voxel dig -> fallback
 #if WITH_EQUIPMENT_PLUGIN
 	if (EquipmentManager)
@@ -1242,7 +1273,7 @@ void AVCCharacterBase::Input_PrimaryAction(const FInputActionValue& Value)
 					{
 						const FVector RelPos = Hit.ImpactPoint - ChunkMgr->GetConfiguration()->WorldOrigin;
 						const FIntVector VoxelCoord = FVoxelCoordinates::WorldToVoxel(RelPos, ChunkMgr->GetConfiguration()->VoxelSize);
-						PC->Server_RequestVoxelModification(VoxelCoord, EVoxelModificationType::Destroy, 0);
+						PC->RequestVoxelModification(VoxelCoord, EVoxelModificationType::Destroy, 0);
 					}
 				}
 			}
@@ -1262,7 +1293,7 @@ void AVCCharacterBase::Input_PrimaryAction(const FInputActionValue& Value)
 			{
 				const FVector RelPos = Hit.ImpactPoint - ChunkMgr->GetConfiguration()->WorldOrigin;
 				const FIntVector VoxelCoord = FVoxelCoordinates::WorldToVoxel(RelPos, ChunkMgr->GetConfiguration()->VoxelSize);
-				PC->Server_RequestVoxelModification(VoxelCoord, EVoxelModificationType::Destroy, 0);
+				PC->RequestVoxelModification(VoxelCoord, EVoxelModificationType::Destroy, 0);
 			}
 		}
 	}
@@ -1270,6 +1301,11 @@ void AVCCharacterBase::Input_PrimaryAction(const FInputActionValue& Value)
 
 void AVCCharacterBase::Input_SecondaryAction(const FInputActionValue& Value)
 {
+	if (UVCEditLatencyTracker* LatencyTracker = UVCEditLatencyTracker::Get(this))
+	{
+		LatencyTracker->RecordActionInput();
+	}
+
 	// Priority chain: GAS ability -> equipped item alt -> voxel place -> fallback
 #if WITH_EQUIPMENT_PLUGIN
 	if (EquipmentManager)
@@ -1291,7 +1327,7 @@ void AVCCharacterBase::Input_SecondaryAction(const FInputActionValue& Value)
 						const FVector PlacePos = Hit.ImpactPoint + Hit.ImpactNormal * (VoxelSize * 0.5f);
 						const FVector RelPos = PlacePos - ChunkMgr->GetConfiguration()->WorldOrigin;
 						const FIntVector VoxelCoord = FVoxelCoordinates::WorldToVoxel(RelPos, VoxelSize);
-						PC->Server_RequestVoxelModification(VoxelCoord, EVoxelModificationType::Place, 2); // Stone
+						PC->RequestVoxelModification(VoxelCoord, EVoxelModificationType::Place, 2); // Stone
 					}
 				}
 			}
@@ -1313,7 +1349,7 @@ void AVCCharacterBase::Input_SecondaryAction(const FInputActionValue& Value)
 				const FVector PlacePos = Hit.ImpactPoint + Hit.ImpactNormal * (VoxelSize * 0.5f);
 				const FVector RelPos = PlacePos - ChunkMgr->GetConfiguration()->WorldOrigin;
 				const FIntVector VoxelCoord = FVoxelCoordinates::WorldToVoxel(RelPos, VoxelSize);
-				PC->Server_RequestVoxelModification(VoxelCoord, EVoxelModificationType::Place, 2); // Stone
+				PC->RequestVoxelModification(VoxelCoord, EVoxelModificationType::Place, 2); // Stone
 			}
 		}
 	}
@@ -0,0 +1,332 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#include "Core/VCEditLatencyTracker.h"
+#include "Movement/VCVoxelNavigationHelper.h"
+#include "VoxelChunkManager.h"
+#include "VoxelCollisionManager.h"
+#include "Core/VCPerfReport.h"
+#include "VoxelCharacterPlugin.h"
+#include "AbilitySystemComponent.h"
+#include "Abilities/GameplayAbility.h"
+#include "GameFramework/GameStateBase.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Edit Queue Wait p50 (ms)"), STAT_VCEditQueueWaitP50, STATGROUP_VoxelCharacter);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Edit Queue Wait p95 (ms)"), STAT_VCEditQueueWaitP95, STATGROUP_VoxelCharacter);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Edit Queue Wait p99 (ms)"), STAT_VCEditQueueWaitP99, STATGROUP_VoxelCharacter);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Edit Server Apply p50 (ms)"), STAT_VCEditServerApplyP50, STATGROUP_VoxelCharacter);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Edit Server Apply p95 (ms)"), STAT_VCEditServerApplyP95, STATGROUP_VoxelCharacter);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Edit Server Apply p99 (ms)"), STAT_VCEditServerApplyP99, STATGROUP_VoxelCharacter);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Edit Remesh p50 (ms)"), STAT_VCEditRemeshP50, STATGROUP_VoxelCharacter);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Edit Remesh p95 (ms)"), STAT_VCEditRemeshP95, STATGROUP_VoxelCharacter);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Edit Remesh p99 (ms)"), STAT_VCEditRemeshP99, STATGROUP_VoxelCharacter);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Edit Input->Visible p50 (ms)"), STAT_VCEditInputToVisibleP50, STATGROUP_VoxelCharacter);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Edit Input->Visible p95 (ms)"), STAT_VCEditInputToVisibleP95, STATGROUP_VoxelCharacter);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Edit Input->Visible p99 (ms)"), STAT_VCEditInputToVisibleP99, STATGROUP_VoxelCharacter);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Ability Input->Activate p50 (ms)"), STAT_VCEditInputToAbilityP50, STATGROUP_VoxelCharacter);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Ability Input->Activate p95 (ms)"), STAT_VCEditInputToAbilityP95, STATGROUP_VoxelCharacter);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Ability Input->Activate p99 (ms)"), STAT_VCEditInputToAbilityP99, STATGROUP_VoxelCharacter);
+
+static const TCHAR* GetStageName(EVCEditLatencyStage Stage)
+{
+	switch (Stage)
+	{
+	case EVCEditLatencyStage::QueueWait:      return TEXT("QueueWait");
+	case EVCEditLatencyStage::ServerApply:    return TEXT("ServerApply");
+	case EVCEditLatencyStage::Remesh:         return TEXT("Remesh");
+	case EVCEditLatencyStage::InputToVisible: return TEXT("InputToVisible");
+	case EVCEditLatencyStage::InputToAbility: return TEXT("InputToAbility");
+	default:                                  return TEXT("?");
+	}
+}
+
+static FAutoConsoleCommandWithWorld GVCEditLatencyDumpCmd(
+	TEXT("vc.EditLatency.Dump"),
+	TEXT("Log voxel edit / ability activation latency percentiles for this world."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UVCEditLatencyTracker* Tracker = UVCEditLatencyTracker::Get(World))
+		{
+			Tracker->DumpToLog();
+		}
+	}));
+
+// ---------------------------------------------------------------------------
+// Lookup / Lifecycle
+// ---------------------------------------------------------------------------
+
+UVCEditLatencyTracker* UVCEditLatencyTracker::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UVCEditLatencyTracker>() : nullptr;
+}
+
+void UVCEditLatencyTracker::Deinitialize()
+{
+	if (UVoxelCollisionManager* ColMgr = BoundCollisionManager.Get())
+	{
+		ColMgr->OnCollisionReady.Remove(CollisionReadyHandle);
+	}
+	BoundCollisionManager.Reset();
+	CollisionReadyHandle.Reset();
+
+	for (const TWeakObjectPtr<UAbilitySystemComponent>& WeakASC : ObservedAbilitySystems)
+	{
+		if (UAbilitySystemComponent* ASC = WeakASC.Get())
+		{
+			ASC->AbilityActivatedCallbacks.RemoveAll(this);
+		}
+	}
+	ObservedAbilitySystems.Empty();
+	PendingEdits.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UVCEditLatencyTracker::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UVCEditLatencyTracker, STATGROUP_Tickables);
+}
+
+// ---------------------------------------------------------------------------
+// Client
+// ---------------------------------------------------------------------------
+
+FVCEditRequestStamp UVCEditLatencyTracker::BeginClientEdit(const FIntVector& ChunkCoord)
+{
+	FVCEditRequestStamp Stamp;
+	Stamp.Sequence = NextSequence++;
+	if (NextSequence == 0)
+	{
+		NextSequence = 1; // 0 is reserved for "unstamped"
+	}
+	Stamp.ClientSendServerTime = GetSyncedServerTime();
+
+	AddPending(ChunkCoord, FPlatformTime::Seconds(), /*bClient=*/true);
+	return Stamp;
+}
+
+void UVCEditLatencyTracker::RecordActionInput()
+{
+	LastActionInputTime = FPlatformTime::Seconds();
+}
+
+void UVCEditLatencyTracker::ObserveAbilitySystem(UAbilitySystemComponent* ASC)
+{
+	if (!ASC || ObservedAbilitySystems.Contains(ASC))
+	{
+		return;
+	}
+
+	ObservedAbilitySystems.RemoveAll([](const TWeakObjectPtr<UAbilitySystemComponent>& Weak) { return !Weak.IsValid(); });
+	ObservedAbilitySystems.Add(ASC);
+	ASC->AbilityActivatedCallbacks.AddUObject(this, &UVCEditLatencyTracker::HandleAbilityActivated);
+}
+
+void UVCEditLatencyTracker::HandleAbilityActivated(UGameplayAbility* Ability)
+{
+	// Only the locally controlled avatar's activations pair with this machine's input; on a
+	// listen server the same delegate also fires for remote players' abilities.
+	const FGameplayAbilityActorInfo* ActorInfo = Ability ? Ability->GetCurrentActorInfo() : nullptr;
+	if (!ActorInfo || !ActorInfo->IsLocallyControlled() || LastActionInputTime < 0.0)
+	{
+		return;
+	}
+
+	const double Elapsed = FPlatformTime::Seconds() - LastActionInputTime;
+	if (Elapsed <= AbilityInputWindowSeconds)
+	{
+		AddSample(EVCEditLatencyStage::InputToAbility, Elapsed);
+	}
+	LastActionInputTime = -1.0;
+}
+
+// ---------------------------------------------------------------------------
+// Server
+// ---------------------------------------------------------------------------
+
+double UVCEditLatencyTracker::RecordServerReceipt(const FVCEditRequestStamp& Stamp)
+{
+	if (Stamp.IsValid())
+	{
+		// Both ends read GameState server time, so the difference is transit + reliable queue
+		// (quantized to the server frame the RPC was dispatched in). Clock-sync error can make it
+		// slightly negative on a LAN; clamp rather than skew the window.
+		const double Wait = GetSyncedServerTime() - Stamp.ClientSendServerTime;
+		AddSample(EVCEditLatencyStage::QueueWait, FMath::Max(0.0, Wait));
+	}
+	return FPlatformTime::Seconds();
+}
+
+void UVCEditLatencyTracker::RecordServerApplied(const FVCEditRequestStamp& Stamp, double ReceiptTime, const FIntVector& ChunkCoord)
+{
+	const double Now = FPlatformTime::Seconds();
+	AddSample(EVCEditLatencyStage::ServerApply, Now - ReceiptTime);
+	AddPending(ChunkCoord, Now, /*bClient=*/false);
+}
+
+// ---------------------------------------------------------------------------
+// Remesh / Visible Detection
+// ---------------------------------------------------------------------------
+
+void UVCEditLatencyTracker::AddPending(const FIntVector& ChunkCoord, double StartTime, bool bClient)
+{
+	EnsureCollisionBinding();
+
+	FPendingChunkEdit& Pending = PendingEdits.AddDefaulted_GetRef();
+	Pending.ChunkCoord = ChunkCoord;
+	Pending.StartTime = StartTime;
+	Pending.bClient = bClient;
+}
+
+void UVCEditLatencyTracker::EnsureCollisionBinding()
+{
+	if (BoundCollisionManager.IsValid())
+	{
+		return;
+	}
+
+	UVoxelChunkManager* ChunkMgr = FVCVoxelNavigationHelper::FindChunkManager(GetWorld());
+	UVoxelCollisionManager* ColMgr = ChunkMgr ? ChunkMgr->GetCollisionManager() : nullptr;
+	if (!ColMgr)
+	{
+		return;
+	}
+
+	BoundCollisionManager = ColMgr;
+	CollisionReadyHandle = ColMgr->OnCollisionReady.AddUObject(this, &UVCEditLatencyTracker::HandleCollisionReady);
+}
+
+void UVCEditLatencyTracker::HandleCollisionReady(const FIntVector& ChunkCoord)
+{
+	if (PendingEdits.Num() == 0)
+	{
+		return;
+	}
+
+	// One rebuild completes every edit queued against that chunk (rapid digging coalesces).
+	const double Now = FPlatformTime::Seconds();
+	for (int32 i = PendingEdits.Num() - 1; i >= 0; --i)
+	{
+		const FPendingChunkEdit& Pending = PendingEdits[i];
+		if (Pending.ChunkCoord != ChunkCoord)
+		{
+			continue;
+		}
+
+		AddSample(Pending.bClient ? EVCEditLatencyStage::InputToVisible : EVCEditLatencyStage::Remesh,
+			Now - Pending.StartTime);
+		PendingEdits.RemoveAtSwap(i);
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Aggregation
+// ---------------------------------------------------------------------------
+
+void UVCEditLatencyTracker::AddSample(EVCEditLatencyStage Stage, double Seconds)
+{
+	const float Ms = static_cast<float>(Seconds * 1000.0);
+	Windows[static_cast<int32>(Stage)].Add(Ms);
+	if (FVCPerfCapture::IsCapturing())
+	{
+		FVCPerfCapture::RecordValue(*FString::Printf(TEXT("VCEdits/%s"), GetStageName(Stage)), Ms);
+	}
+
+	UE_LOG(LogVoxelCharacter, VeryVerbose, TEXT("EditLatency %s: %.2f ms"), GetStageName(Stage), Ms);
+}
+
+float UVCEditLatencyTracker::GetPercentileMs(EVCEditLatencyStage Stage, float Fraction) const
+{
+	return Windows[static_cast<int32>(Stage)].GetPercentile(Fraction);
+}
+
+double UVCEditLatencyTracker::GetSyncedServerTime() const
+{
+	const UWorld* World = GetWorld();
+	if (!World)
+	{
+		return 0.0;
+	}
+	const AGameStateBase* GameState = World->GetGameState();
+	return GameState ? GameState->GetServerWorldTimeSeconds() : World->GetTimeSeconds();
+}
+
+void UVCEditLatencyTracker::Tick(float DeltaTime)
+{
+	// Expire edits whose chunk never rebuilt (vetoed, out of collision range, chunk unloaded).
+	if (PendingEdits.Num() > 0)
+	{
+		const double Now = FPlatformTime::Seconds();
+		PendingEdits.RemoveAllSwap([Now](const FPendingChunkEdit& Pending)
+		{
+			return Now - Pending.StartTime > PendingTimeoutSeconds;
+		});
+	}
+
+	// Nobody reads the percentiles unless `stat VoxelCharacter` or a CSV capture is on.
+	bool bPublish = false;
+#if STATS
+	bPublish |= FThreadStats::IsCollectingData();
+#endif
+#if CSV_PROFILER
+	bPublish |= FCsvProfiler::Get() && FCsvProfiler::Get()->IsCapturing();
+#endif
+	if (!bPublish)
+	{
+		return;
+	}
+
+	// Percentiles sort the window — recompute only for stages that took samples since the last
+	// publish; the counters are re-set from the cached values every frame.
+	for (int32 i = 0; i < static_cast<int32>(EVCEditLatencyStage::Num); ++i)
+	{
+		const FVCSampleWindow& Window = Windows[i];
+		FStagePercentiles& Cached = Published[i];
+		if (Window.Num() > 0 && Cached.TotalCount != Window.GetTotalCount())
+		{
+			Cached.TotalCount = Window.GetTotalCount();
+			Cached.P50 = Window.GetPercentile(0.50f);
+			Cached.P95 = Window.GetPercentile(0.95f);
+			Cached.P99 = Window.GetPercentile(0.99f);
+		}
+	}
+
+#define VC_PUBLISH_EDIT_LATENCY(StageName) \
+	{ \
+		const FStagePercentiles& Cached = Published[static_cast<int32>(EVCEditLatencyStage::StageName)]; \
+		if (Cached.TotalCount > 0) \
+		{ \
+			SET_FLOAT_STAT(STAT_VCEdit##StageName##P50, Cached.P50); \
+			SET_FLOAT_STAT(STAT_VCEdit##StageName##P95, Cached.P95); \
+			SET_FLOAT_STAT(STAT_VCEdit##StageName##P99, Cached.P99); \
+			CSV_CUSTOM_STAT(VCEdits, StageName##P50, Cached.P50, ECsvCustomStatOp::Set); \
+			CSV_CUSTOM_STAT(VCEdits, StageName##P95, Cached.P95, ECsvCustomStatOp::Set); \
+			CSV_CUSTOM_STAT(VCEdits, StageName##P99, Cached.P99, ECsvCustomStatOp::Set); \
+		} \
+	}
+
+	VC_PUBLISH_EDIT_LATENCY(QueueWait)
+	VC_PUBLISH_EDIT_LATENCY(ServerApply)
+	VC_PUBLISH_EDIT_LATENCY(Remesh)
+	VC_PUBLISH_EDIT_LATENCY(InputToVisible)
+	VC_PUBLISH_EDIT_LATENCY(InputToAbility)
+
+#undef VC_PUBLISH_EDIT_LATENCY
+
+	CSV_CUSTOM_STAT(VCEdits, PendingEdits, PendingEdits.Num(), ECsvCustomStatOp::Set);
+}
+
+void UVCEditLatencyTracker::DumpToLog() const
+{
+	UE_LOG(LogVoxelCharacter, Log, TEXT("=== Edit latency (%s) ==="), *GetWorld()->GetName());
+	for (int32 i = 0; i < static_cast<int32>(EVCEditLatencyStage::Num); ++i)
+	{
+		const FVCSampleWindow& Window = Windows[i];
+		UE_LOG(LogVoxelCharacter, Log, TEXT("  %-15s n=%lld  p50=%.2f  p95=%.2f  p99=%.2f ms"),
+			GetStageName(static_cast<EVCEditLatencyStage>(i)), Window.GetTotalCount(),
+			Window.GetPercentile(0.50f), Window.GetPercentile(0.95f), Window.GetPercentile(0.99f));
+	}
+	UE_LOG(LogVoxelCharacter, Log, TEXT("  %d edit(s) awaiting chunk rebuild"), PendingEdits.Num());
+}
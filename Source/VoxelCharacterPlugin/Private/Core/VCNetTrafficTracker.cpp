@@ -0,0 +1,387 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#include "Core/VCNetTrafficTracker.h"
+#include "Core/VCPerfReport.h"
+#include "VoxelCharacterStats.h"
+#include "VoxelCharacterPlugin.h"
+#include "Engine/ActorChannel.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Net Edit Requests (B/s, all connections)"), STAT_VCNetEditRequestBps, STATGROUP_VoxelCharacter);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Net Edit Blocked (B/s, all connections)"), STAT_VCNetEditBlockedBps, STATGROUP_VoxelCharacter);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Net View Mode (B/s, all connections)"), STAT_VCNetViewModeBps, STATGROUP_VoxelCharacter);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Net Attributes (B/s, all connections)"), STAT_VCNetAttributesBps, STATGROUP_VoxelCharacter);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Net Plugin Max Per Connection (B/s)"), STAT_VCNetMaxConnectionBps, STATGROUP_VoxelCharacter);
+
+namespace VCNetTraffic
+{
+	/**
+	 * Wire size model, used where a size cannot be measured. Approximate for the default
+	 * (non-Iris) replication path; refine against Networking Insights when changing it.
+	 */
+
+	/** Reliable actor-channel bunch header plus the RPC's field header and payload length. */
+	constexpr int64 RpcHeaderBits = 56;
+
+	/** Replicated property handle (packed, small handle). */
+	constexpr int32 PropertyHandleBits = 8;
+
+	/** Per-object content block header, charged once per frame an object had changes. */
+	constexpr int32 ContentBlockHeaderBits = 16;
+
+	/** Server_RequestVoxelModification: FIntVector (3 x 32), ModType, MaterialID, stamp (32 + 64). */
+	constexpr int64 EditRequestParamBits = 96 + 8 + 8 + 96;
+
+	/** Client_NotifyVoxelEditBlocked: int32. */
+	constexpr int64 EditBlockedParamBits = 32;
+}
+
+static FAutoConsoleCommandWithWorld GVCNetDumpCmd(
+	TEXT("vc.Net.Dump"),
+	TEXT("Log plugin RPC / property bandwidth per connection for this world."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UVCNetTrafficTracker* Tracker = UVCNetTrafficTracker::Get(World))
+		{
+			Tracker->DumpToLog();
+		}
+	}));
+
+static FAutoConsoleCommandWithWorld GVCNetResetCmd(
+	TEXT("vc.Net.Reset"),
+	TEXT("Clear plugin bandwidth totals for this world."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UVCNetTrafficTracker* Tracker = UVCNetTrafficTracker::Get(World))
+		{
+			Tracker->Reset();
+		}
+	}));
+
+// ---------------------------------------------------------------------------
+// Lookup / Lifecycle
+// ---------------------------------------------------------------------------
+
+UVCNetTrafficTracker* UVCNetTrafficTracker::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UVCNetTrafficTracker>() : nullptr;
+}
+
+const TCHAR* UVCNetTrafficTracker::GetTrafficName(EVCNetTraffic Traffic)
+{
+	switch (Traffic)
+	{
+	case EVCNetTraffic::EditRequest: return TEXT("EditRequest");
+	case EVCNetTraffic::EditBlocked: return TEXT("EditBlocked");
+	case EVCNetTraffic::ViewMode:    return TEXT("ViewMode");
+	case EVCNetTraffic::Attributes:  return TEXT("Attributes");
+	default:                         return TEXT("?");
+	}
+}
+
+int64 UVCNetTrafficTracker::GetRpcModelBits(EVCNetTraffic Traffic)
+{
+	switch (Traffic)
+	{
+	case EVCNetTraffic::EditRequest: return VCNetTraffic::RpcHeaderBits + VCNetTraffic::EditRequestParamBits;
+	case EVCNetTraffic::EditBlocked: return VCNetTraffic::RpcHeaderBits + VCNetTraffic::EditBlockedParamBits;
+	default:                         return 0;
+	}
+}
+
+void UVCNetTrafficTracker::Deinitialize()
+{
+	Connections.Empty();
+	PendingFields.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UVCNetTrafficTracker::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UVCNetTrafficTracker, STATGROUP_Tickables);
+}
+
+// ---------------------------------------------------------------------------
+// Recording
+// ---------------------------------------------------------------------------
+
+UVCNetTrafficTracker::FConnectionTraffic& UVCNetTrafficTracker::FindOrAddConnection(const UNetConnection* Connection)
+{
+	FConnectionTraffic& Entry = Connections.FindOrAdd(Connection);
+	if (!Entry.Connection.IsValid())
+	{
+		// New entry, or a recycled address of a closed connection: start clean.
+		Entry = FConnectionTraffic();
+		Entry.Connection = Connection;
+	}
+	return Entry;
+}
+
+void UVCNetTrafficTracker::RecordBits(const UNetConnection* Connection, EVCNetTraffic Traffic, int64 Bits)
+{
+	if (!Connection || Traffic >= EVCNetTraffic::Num)
+	{
+		return;
+	}
+
+	FConnectionTraffic& Entry = FindOrAddConnection(Connection);
+	const int32 Index = static_cast<int32>(Traffic);
+	Entry.WindowBits[Index] += Bits;
+	++Entry.WindowCount[Index];
+	Entry.TotalBits[Index] += Bits;
+	++Entry.TotalCount[Index];
+}
+
+void UVCNetTrafficTracker::RecordPropertyChange(const AActor* Actor, EVCNetTraffic Traffic, FName Field, int32 ValueBits)
+{
+	// Only a server with clients replicates anything.
+	const UWorld* World = GetWorld();
+	if (!Actor || !Actor->HasAuthority() || World->GetNetMode() == NM_Standalone || World->GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	FPendingField& Pending = PendingFields.FindOrAdd(TPair<FObjectKey, FName>(FObjectKey(Actor), Field));
+	Pending.Actor = Actor;
+	Pending.Traffic = Traffic;
+	Pending.ValueBits = ValueBits;
+}
+
+void UVCNetTrafficTracker::FlushPropertyChanges()
+{
+	if (PendingFields.Num() == 0)
+	{
+		return;
+	}
+
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	if (!NetDriver)
+	{
+		PendingFields.Reset();
+		return;
+	}
+
+	// Group by actor and traffic: each object with changes also costs one content block header.
+	TMap<TPair<FObjectKey, EVCNetTraffic>, int64> ChangedBits;
+	for (const TPair<TPair<FObjectKey, FName>, FPendingField>& Pair : PendingFields)
+	{
+		const FPendingField& Pending = Pair.Value;
+		if (Pending.Actor.IsValid())
+		{
+			int64& Bits = ChangedBits.FindOrAdd(TPair<FObjectKey, EVCNetTraffic>(Pair.Key.Key, Pending.Traffic), VCNetTraffic::ContentBlockHeaderBits);
+			Bits += VCNetTraffic::PropertyHandleBits + Pending.ValueBits;
+		}
+	}
+	PendingFields.Reset();
+
+	for (const TPair<TPair<FObjectKey, EVCNetTraffic>, int64>& Pair : ChangedBits)
+	{
+		AActor* Actor = Cast<AActor>(Pair.Key.Key.ResolveObjectPtr());
+		if (!Actor)
+		{
+			continue;
+		}
+		const TWeakObjectPtr<AActor> WeakActor(Actor);
+		for (const UNetConnection* Connection : NetDriver->ClientConnections)
+		{
+			if (Connection && Connection->FindActorChannelRef(WeakActor))
+			{
+				RecordBits(Connection, Pair.Key.Value, Pair.Value);
+			}
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Tick / Publishing
+// ---------------------------------------------------------------------------
+
+void UVCNetTrafficTracker::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	FlushPropertyChanges();
+
+	const double Now = FPlatformTime::Seconds();
+	if (WindowStart == 0.0)
+	{
+		WindowStart = Now;
+	}
+	else if (Now - WindowStart >= WindowSeconds)
+	{
+		RollWindow(Now);
+	}
+
+	PublishRates();
+}
+
+void UVCNetTrafficTracker::RollWindow(double Now)
+{
+	const double Elapsed = Now - WindowStart;
+	WindowStart = Now;
+
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	double TotalBytesPerSecond[NumTraffic] = {};
+	for (auto It = Connections.CreateIterator(); It; ++It)
+	{
+		FConnectionTraffic& Entry = It.Value();
+		const UNetConnection* Connection = Entry.Connection.Get();
+		if (!Connection)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		// Name by player once known (the player state arrives after the connection).
+		FString Name = TEXT("Server");
+		if (!NetDriver || Connection != NetDriver->ServerConnection)
+		{
+			const APlayerState* PlayerState = Connection->PlayerController ? Connection->PlayerController->PlayerState.Get() : nullptr;
+			Name = PlayerState ? PlayerState->GetPlayerName() : Connection->LowLevelGetRemoteAddress(/*bAppendPort=*/true);
+		}
+		if (Name != Entry.Name)
+		{
+			Entry.Name = MoveTemp(Name);
+			for (int32 i = 0; i < NumTraffic; ++i)
+			{
+				Entry.CsvNames[i] = FName(*FString::Printf(TEXT("%s/%s"), *Entry.Name, GetTrafficName(static_cast<EVCNetTraffic>(i))));
+			}
+		}
+
+		for (int32 i = 0; i < NumTraffic; ++i)
+		{
+			Entry.BytesPerSecond[i] = static_cast<float>(Entry.WindowBits[i] / 8.0 / Elapsed);
+			Entry.CountPerSecond[i] = static_cast<float>(Entry.WindowCount[i] / Elapsed);
+			Entry.WindowBits[i] = 0;
+			Entry.WindowCount[i] = 0;
+			TotalBytesPerSecond[i] += Entry.BytesPerSecond[i];
+		}
+	}
+
+	// One sample per window, so report percentiles are over per-second rates.
+	if (FVCPerfCapture::IsCapturing() && Connections.Num() > 0)
+	{
+		for (int32 i = 0; i < NumTraffic; ++i)
+		{
+			FVCPerfCapture::RecordValue(*FString::Printf(TEXT("VCNet/%sBps"), GetTrafficName(static_cast<EVCNetTraffic>(i))), TotalBytesPerSecond[i]);
+		}
+	}
+}
+
+void UVCNetTrafficTracker::PublishRates() const
+{
+	float Totals[NumTraffic] = {};
+	float MaxConnection = 0.0f;
+	for (const TPair<const UNetConnection*, FConnectionTraffic>& Pair : Connections)
+	{
+		const FConnectionTraffic& Entry = Pair.Value;
+		float ConnectionTotal = 0.0f;
+		for (int32 i = 0; i < NumTraffic; ++i)
+		{
+			Totals[i] += Entry.BytesPerSecond[i];
+			ConnectionTotal += Entry.BytesPerSecond[i];
+#if CSV_PROFILER
+			if (!Entry.CsvNames[i].IsNone())
+			{
+				FCsvProfiler::RecordCustomStat(Entry.CsvNames[i], CSV_CATEGORY_INDEX(VCNet), Entry.BytesPerSecond[i], ECsvCustomStatOp::Set);
+			}
+#endif
+		}
+		MaxConnection = FMath::Max(MaxConnection, ConnectionTotal);
+	}
+
+	SET_FLOAT_STAT(STAT_VCNetEditRequestBps, Totals[static_cast<int32>(EVCNetTraffic::EditRequest)]);
+	SET_FLOAT_STAT(STAT_VCNetEditBlockedBps, Totals[static_cast<int32>(EVCNetTraffic::EditBlocked)]);
+	SET_FLOAT_STAT(STAT_VCNetViewModeBps, Totals[static_cast<int32>(EVCNetTraffic::ViewMode)]);
+	SET_FLOAT_STAT(STAT_VCNetAttributesBps, Totals[static_cast<int32>(EVCNetTraffic::Attributes)]);
+	SET_FLOAT_STAT(STAT_VCNetMaxConnectionBps, MaxConnection);
+
+	if (Connections.Num() > 0)
+	{
+		CSV_CUSTOM_STAT(VCNet, EditRequestBps, Totals[static_cast<int32>(EVCNetTraffic::EditRequest)], ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(VCNet, EditBlockedBps, Totals[static_cast<int32>(EVCNetTraffic::EditBlocked)], ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(VCNet, ViewModeBps, Totals[static_cast<int32>(EVCNetTraffic::ViewMode)], ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(VCNet, AttributesBps, Totals[static_cast<int32>(EVCNetTraffic::Attributes)], ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(VCNet, MaxConnectionBps, MaxConnection, ECsvCustomStatOp::Set);
+	}
+}
+
+void UVCNetTrafficTracker::DumpToLog() const
+{
+	UE_LOG(LogVoxelCharacter, Log, TEXT("=== Plugin net traffic (%d connections; B/s over the last %.0fs, msg/s, total KB) ==="),
+		Connections.Num(), WindowSeconds);
+	for (const TPair<const UNetConnection*, FConnectionTraffic>& Pair : Connections)
+	{
+		const FConnectionTraffic& Entry = Pair.Value;
+		UE_LOG(LogVoxelCharacter, Log, TEXT("  %s"), Entry.Name.IsEmpty() ? TEXT("(unnamed)") : *Entry.Name);
+		for (int32 i = 0; i < NumTraffic; ++i)
+		{
+			if (Entry.TotalCount[i] == 0)
+			{
+				continue;
+			}
+			UE_LOG(LogVoxelCharacter, Log, TEXT("    %-12s %8.1f B/s  %6.1f msg/s  %8.1f KB (%lld msgs, %.0f bits avg)"),
+				GetTrafficName(static_cast<EVCNetTraffic>(i)), Entry.BytesPerSecond[i], Entry.CountPerSecond[i],
+				Entry.TotalBits[i] / 8.0 / 1024.0, Entry.TotalCount[i],
+				static_cast<double>(Entry.TotalBits[i]) / Entry.TotalCount[i]);
+		}
+	}
+}
+
+void UVCNetTrafficTracker::Reset()
+{
+	for (TPair<const UNetConnection*, FConnectionTraffic>& Pair : Connections)
+	{
+		FConnectionTraffic& Entry = Pair.Value;
+		for (int32 i = 0; i < NumTraffic; ++i)
+		{
+			Entry.WindowBits[i] = 0;
+			Entry.WindowCount[i] = 0;
+			Entry.BytesPerSecond[i] = 0.0f;
+			Entry.CountPerSecond[i] = 0.0f;
+			Entry.TotalBits[i] = 0;
+			Entry.TotalCount[i] = 0;
+		}
+	}
+	PendingFields.Reset();
+	WindowStart = FPlatformTime::Seconds();
+}
+
+// ---------------------------------------------------------------------------
+// Send scope
+// ---------------------------------------------------------------------------
+
+FVCNetSendScope::FVCNetSendScope(const UObject* WorldContextObject, UNetConnection* InConnection, EVCNetTraffic InTraffic)
+	: Traffic(InTraffic)
+{
+	// No connection: a local call on a listen server / standalone, nothing goes on the wire.
+	if (InConnection)
+	{
+		Tracker = UVCNetTrafficTracker::Get(WorldContextObject);
+		Connection = InConnection;
+		StartBits = Connection->SendBuffer.GetNumBits();
+		StartPacketId = Connection->OutPacketId;
+	}
+}
+
+FVCNetSendScope::~FVCNetSendScope()
+{
+	if (!Tracker || !Connection)
+	{
+		return;
+	}
+
+	// Same packet: the growth of the send buffer is exactly this RPC's bunch. A flush during
+	// the send (packet filled up) or nothing written (RPC queued by the replication system)
+	// leaves no clean measurement, so use the model.
+	const int64 Written = Connection->SendBuffer.GetNumBits() - StartBits;
+	const bool bMeasured = Connection->OutPacketId == StartPacketId && Written > 0;
+	Tracker->RecordBits(Connection, Traffic, bMeasured ? Written : UVCNetTrafficTracker::GetRpcModelBits(Traffic));
+}
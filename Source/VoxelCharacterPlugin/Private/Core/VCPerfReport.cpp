@@ -0,0 +1,459 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#include "Core/VCPerfReport.h"
+#include "VoxelCharacterPlugin.h"
+#include "Engine/World.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace VCPerfReport
+{
+	/** Histogram buckets: bucket i holds values up to MinValue * Growth^(i + 1). */
+	static constexpr double MinValue = 0.001;
+	static constexpr double Growth = 1.05;
+	static constexpr int32 NumBuckets = 400;
+
+	/** Report format version, bumped when fields change meaning. */
+	static constexpr int32 ReportVersion = 1;
+
+	/** Differences below this are timing noise, whatever the relative change (metric units, mostly ms). */
+	static constexpr double AbsoluteFloor = 0.05;
+
+	/** Metrics recorded only when something went over budget; absent from a run means none happened. */
+	static const TCHAR* const OverrunMetricPrefix = TEXT("VCBudget/");
+
+	static int32 GetBucket(double Value)
+	{
+		if (Value <= MinValue)
+		{
+			return 0;
+		}
+		return FMath::Clamp(FMath::FloorToInt(FMath::Loge(Value / MinValue) / FMath::Loge(Growth)), 0, NumBuckets - 1);
+	}
+}
+
+// ---------------------------------------------------------------------------
+// FVCPerfHistogram
+// ---------------------------------------------------------------------------
+
+void FVCPerfHistogram::Add(double Value)
+{
+	if (Buckets.Num() == 0)
+	{
+		Buckets.SetNumZeroed(VCPerfReport::NumBuckets);
+	}
+	++Buckets[VCPerfReport::GetBucket(Value)];
+	Max = Count > 0 ? FMath::Max(Max, Value) : Value;
+	Sum += Value;
+	++Count;
+}
+
+void FVCPerfHistogram::Reset()
+{
+	Buckets.Reset();
+	Count = 0;
+	Sum = 0.0;
+	Max = 0.0;
+}
+
+double FVCPerfHistogram::GetPercentile(double Fraction) const
+{
+	if (Count == 0)
+	{
+		return 0.0;
+	}
+
+	// Nearest rank, reported as the bucket's upper edge (never above the true max).
+	const int64 Rank = FMath::Clamp<int64>(FMath::CeilToInt64(Fraction * Count), 1, Count);
+	int64 Seen = 0;
+	for (int32 i = 0; i < Buckets.Num(); ++i)
+	{
+		Seen += Buckets[i];
+		if (Seen >= Rank)
+		{
+			return FMath::Min(Max, VCPerfReport::MinValue * FMath::Pow(VCPerfReport::Growth, static_cast<double>(i + 1)));
+		}
+	}
+	return Max;
+}
+
+// ---------------------------------------------------------------------------
+// Capture
+// ---------------------------------------------------------------------------
+
+bool FVCPerfCapture::bCapturing = false;
+TArray<FVCPerfCapture::FTimer> FVCPerfCapture::Timers;
+TMap<FString, FVCPerfHistogram> FVCPerfCapture::Values;
+FVCPerfHistogram FVCPerfCapture::FrameTimes;
+FCriticalSection FVCPerfCapture::TimersLock;
+double FVCPerfCapture::CaptureStartTime = 0.0;
+int64 FVCPerfCapture::CapturedFrames = 0;
+TOptional<FVCPerfCapture::FSessionSettings> FVCPerfCapture::Session;
+double FVCPerfCapture::SessionStartTime = 0.0;
+FDelegateHandle FVCPerfCapture::EndFrameHandle;
+
+int32 FVCPerfCapture::RegisterTimer(const TCHAR* Name)
+{
+	FScopeLock Lock(&TimersLock);
+	const int32 Existing = Timers.IndexOfByPredicate([Name](const FTimer& Timer) { return Timer.Name == Name; });
+	if (Existing != INDEX_NONE)
+	{
+		return Existing;
+	}
+	FTimer& Timer = Timers.AddDefaulted_GetRef();
+	Timer.Name = Name;
+	return Timers.Num() - 1;
+}
+
+void FVCPerfCapture::AddTimerSample(int32 TimerIndex, double Milliseconds)
+{
+	if (!bCapturing)
+	{
+		return;
+	}
+	// Timers may be registered from workers (first call of a scope there) — guard the array.
+	FScopeLock Lock(&TimersLock);
+	if (Timers.IsValidIndex(TimerIndex))
+	{
+		FTimer& Timer = Timers[TimerIndex];
+		Timer.FrameMs += Milliseconds;
+		++Timer.FrameCalls;
+	}
+}
+
+void FVCPerfCapture::RecordValue(const TCHAR* Name, double Value)
+{
+	if (bCapturing)
+	{
+		Values.FindOrAdd(Name).Add(Value);
+	}
+}
+
+void FVCPerfCapture::Begin()
+{
+	{
+		FScopeLock Lock(&TimersLock);
+		for (FTimer& Timer : Timers)
+		{
+			Timer.Histogram.Reset();
+			Timer.FrameMs = 0.0;
+			Timer.FrameCalls = 0;
+			Timer.TotalCalls = 0;
+		}
+	}
+	Values.Reset();
+	FrameTimes.Reset();
+	CapturedFrames = 0;
+	CaptureStartTime = FPlatformTime::Seconds();
+	bCapturing = true;
+
+	if (!EndFrameHandle.IsValid())
+	{
+		EndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&FVCPerfCapture::HandleEndFrame);
+	}
+	UE_LOG(LogVoxelCharacter, Log, TEXT("VCPerf: capture started"));
+}
+
+TSharedRef<FJsonObject> FVCPerfCapture::End()
+{
+	bCapturing = false;
+	const double Seconds = FPlatformTime::Seconds() - CaptureStartTime;
+
+	auto MakeMetric = [](const FVCPerfHistogram& Histogram, int64 Calls)
+	{
+		TSharedRef<FJsonObject> Metric = MakeShared<FJsonObject>();
+		Metric->SetNumberField(TEXT("avg"), Histogram.GetAverage());
+		Metric->SetNumberField(TEXT("p95"), Histogram.GetPercentile(0.95));
+		Metric->SetNumberField(TEXT("p99"), Histogram.GetPercentile(0.99));
+		Metric->SetNumberField(TEXT("max"), Histogram.GetMax());
+		Metric->SetNumberField(TEXT("count"), static_cast<double>(Histogram.GetCount()));
+		if (Calls >= 0)
+		{
+			Metric->SetNumberField(TEXT("calls"), static_cast<double>(Calls));
+		}
+		return Metric;
+	};
+
+	TSharedRef<FJsonObject> Metrics = MakeShared<FJsonObject>();
+	Metrics->SetObjectField(TEXT("Frame/GameThread"), MakeMetric(FrameTimes, -1));
+	{
+		FScopeLock Lock(&TimersLock);
+		for (const FTimer& Timer : Timers)
+		{
+			if (Timer.Histogram.GetCount() > 0)
+			{
+				Metrics->SetObjectField(Timer.Name, MakeMetric(Timer.Histogram, Timer.TotalCalls));
+			}
+		}
+	}
+	for (const TPair<FString, FVCPerfHistogram>& Pair : Values)
+	{
+		Metrics->SetObjectField(Pair.Key, MakeMetric(Pair.Value, -1));
+	}
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetNumberField(TEXT("version"), VCPerfReport::ReportVersion);
+	Report->SetNumberField(TEXT("seconds"), Seconds);
+	Report->SetNumberField(TEXT("frames"), static_cast<double>(CapturedFrames));
+	Report->SetStringField(TEXT("map"), GWorld ? GWorld->GetMapName() : FString());
+	Report->SetObjectField(TEXT("metrics"), Metrics);
+
+	UE_LOG(LogVoxelCharacter, Log, TEXT("VCPerf: capture ended (%lld frames, %.1fs)"), CapturedFrames, Seconds);
+	return Report;
+}
+
+void FVCPerfCapture::HandleEndFrame()
+{
+	if (bCapturing)
+	{
+		FrameTimes.Add(FApp::GetDeltaTime() * 1000.0);
+		++CapturedFrames;
+
+		FScopeLock Lock(&TimersLock);
+		for (FTimer& Timer : Timers)
+		{
+			if (Timer.FrameCalls > 0)
+			{
+				Timer.Histogram.Add(Timer.FrameMs);
+				Timer.TotalCalls += Timer.FrameCalls;
+				Timer.FrameMs = 0.0;
+				Timer.FrameCalls = 0;
+			}
+		}
+	}
+
+	if (!Session.IsSet())
+	{
+		return;
+	}
+	const double Elapsed = FPlatformTime::Seconds() - SessionStartTime;
+	if (!bCapturing && Elapsed >= Session->WarmupSeconds)
+	{
+		Begin();
+#if CSV_PROFILER
+		if (Session->bCsvCapture && FCsvProfiler::Get() && !FCsvProfiler::Get()->IsCapturing())
+		{
+			FCsvProfiler::Get()->BeginCapture();
+		}
+#endif
+	}
+	else if (bCapturing && Elapsed >= Session->WarmupSeconds + Session->CaptureSeconds)
+	{
+		FinishSession();
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Sessions
+// ---------------------------------------------------------------------------
+
+void FVCPerfCapture::StartSession(const FSessionSettings& Settings)
+{
+	Session = Settings;
+	SessionStartTime = FPlatformTime::Seconds();
+	if (!EndFrameHandle.IsValid())
+	{
+		EndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&FVCPerfCapture::HandleEndFrame);
+	}
+	UE_LOG(LogVoxelCharacter, Log, TEXT("VCPerf: session started (warmup %.0fs, capture %.0fs, baseline '%s')"),
+		Settings.WarmupSeconds, Settings.CaptureSeconds, *Settings.BaselinePath);
+}
+
+void FVCPerfCapture::StartSessionFromCommandLine()
+{
+	const TCHAR* CommandLine = FCommandLine::Get();
+	FSessionSettings Settings;
+	if (!FParse::Value(CommandLine, TEXT("VCPerfSession="), Settings.CaptureSeconds))
+	{
+		return;
+	}
+	FParse::Value(CommandLine, TEXT("VCPerfWarmup="), Settings.WarmupSeconds);
+	FParse::Value(CommandLine, TEXT("VCPerfReport="), Settings.ReportPath);
+	FParse::Value(CommandLine, TEXT("VCPerfBaseline="), Settings.BaselinePath);
+	FParse::Value(CommandLine, TEXT("VCPerfThreshold="), Settings.Threshold);
+	Settings.bCsvCapture = !FParse::Param(CommandLine, TEXT("VCPerfNoCsv"));
+	Settings.bExitWhenDone = !FParse::Param(CommandLine, TEXT("VCPerfNoExit"));
+	StartSession(Settings);
+}
+
+void FVCPerfCapture::FinishSession()
+{
+	const FSessionSettings Settings = Session.GetValue();
+	Session.Reset();
+
+#if CSV_PROFILER
+	if (Settings.bCsvCapture && FCsvProfiler::Get() && FCsvProfiler::Get()->IsCapturing())
+	{
+		FCsvProfiler::Get()->EndCapture();
+	}
+#endif
+
+	const TSharedRef<FJsonObject> Report = End();
+	const FString ReportPath = Settings.ReportPath.IsEmpty() ? GetDefaultReportPath() : Settings.ReportPath;
+	bool bPassed = SaveReport(Report, ReportPath);
+
+	if (!Settings.BaselinePath.IsEmpty())
+	{
+		TArray<FString> Regressions;
+		const TSharedPtr<FJsonObject> Baseline = LoadReport(Settings.BaselinePath);
+		if (!Baseline.IsValid())
+		{
+			UE_LOG(LogVoxelCharacter, Error, TEXT("VCPerf: baseline '%s' missing or unreadable"), *Settings.BaselinePath);
+			bPassed = false;
+		}
+		else if (!CompareReports(*Report, *Baseline, Settings.Threshold, Regressions))
+		{
+			for (const FString& Regression : Regressions)
+			{
+				UE_LOG(LogVoxelCharacter, Error, TEXT("VCPerf: regression: %s"), *Regression);
+			}
+			bPassed = false;
+		}
+	}
+	UE_LOG(LogVoxelCharacter, Display, TEXT("VCPerf: session %s — report %s"), bPassed ? TEXT("PASSED") : TEXT("FAILED"), *ReportPath);
+
+	if (Settings.bExitWhenDone)
+	{
+		FPlatformMisc::RequestExitWithStatus(false, bPassed ? 0 : 1);
+	}
+}
+
+void FVCPerfCapture::Shutdown()
+{
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	EndFrameHandle.Reset();
+	bCapturing = false;
+	Session.Reset();
+}
+
+// ---------------------------------------------------------------------------
+// Reports
+// ---------------------------------------------------------------------------
+
+FString FVCPerfCapture::GetDefaultReportPath()
+{
+	return FPaths::ProfilingDir() / TEXT("VCPerfReport.json");
+}
+
+bool FVCPerfCapture::SaveReport(const TSharedRef<FJsonObject>& Report, const FString& Path)
+{
+	FString Text;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Text);
+	if (!FJsonSerializer::Serialize(Report, Writer) || !FFileHelper::SaveStringToFile(Text, *Path))
+	{
+		UE_LOG(LogVoxelCharacter, Error, TEXT("VCPerf: failed to write report '%s'"), *Path);
+		return false;
+	}
+	return true;
+}
+
+TSharedPtr<FJsonObject> FVCPerfCapture::LoadReport(const FString& Path)
+{
+	FString Text;
+	TSharedPtr<FJsonObject> Report;
+	if (FFileHelper::LoadFileToString(Text, *Path))
+	{
+		FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Text), Report);
+	}
+	return Report;
+}
+
+bool FVCPerfCapture::CompareReports(const FJsonObject& Report, const FJsonObject& Baseline, double Threshold, TArray<FString>& OutRegressions)
+{
+	const TSharedPtr<FJsonObject>* Metrics = nullptr;
+	const TSharedPtr<FJsonObject>* BaseMetrics = nullptr;
+	if (!Report.TryGetObjectField(TEXT("metrics"), Metrics) || !Baseline.TryGetObjectField(TEXT("metrics"), BaseMetrics))
+	{
+		OutRegressions.Add(TEXT("report or baseline has no metrics"));
+		return false;
+	}
+
+	const int32 NumBefore = OutRegressions.Num();
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*BaseMetrics)->Values)
+	{
+		const TSharedPtr<FJsonObject>* Base = nullptr;
+		const TSharedPtr<FJsonObject>* Current = nullptr;
+		if (!Pair.Value->TryGetObject(Base))
+		{
+			continue;
+		}
+		if (!(*Metrics)->TryGetObjectField(Pair.Key, Current))
+		{
+			// Not exercised this run: the session did not do what the baseline measured (no edits,
+			// map never opened, capture too short), so the run proves nothing about it. Overrun
+			// events are the exception — none this run is the good case.
+			if (!Pair.Key.StartsWith(VCPerfReport::OverrunMetricPrefix))
+			{
+				OutRegressions.Add(FString::Printf(TEXT("%s missing from this run (baseline count %.0f)"),
+					*Pair.Key, (*Base)->GetNumberField(TEXT("count"))));
+			}
+			continue;
+		}
+		for (const TCHAR* Field : { TEXT("avg"), TEXT("p95") })
+		{
+			const double Was = (*Base)->GetNumberField(Field);
+			const double Now = (*Current)->GetNumberField(Field);
+			if (Now > Was * (1.0 + Threshold) && Now - Was > VCPerfReport::AbsoluteFloor)
+			{
+				OutRegressions.Add(FString::Printf(TEXT("%s %s %.3f -> %.3f (+%.0f%%)"),
+					*Pair.Key, Field, Was, Now, Was > 0.0 ? (Now / Was - 1.0) * 100.0 : 100.0));
+			}
+		}
+	}
+	return OutRegressions.Num() == NumBefore;
+}
+
+// ---------------------------------------------------------------------------
+// Console
+// ---------------------------------------------------------------------------
+
+static FAutoConsoleCommand GVCPerfBeginCmd(
+	TEXT("vc.Perf.Begin"),
+	TEXT("Start collecting plugin perf metrics for a summary report."),
+	FConsoleCommandDelegate::CreateStatic(&FVCPerfCapture::Begin));
+
+static FAutoConsoleCommand GVCPerfEndCmd(
+	TEXT("vc.Perf.End"),
+	TEXT("Stop collecting and write the summary report. Args: [ReportPath] [BaselinePath] [Threshold]."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (!FVCPerfCapture::IsCapturing())
+		{
+			UE_LOG(LogVoxelCharacter, Warning, TEXT("VCPerf: not capturing (vc.Perf.Begin first)"));
+			return;
+		}
+		const FString ReportPath = Args.Num() > 0 ? Args[0] : FVCPerfCapture::GetDefaultReportPath();
+		const TSharedRef<FJsonObject> Report = FVCPerfCapture::End();
+		if (FVCPerfCapture::SaveReport(Report, ReportPath))
+		{
+			UE_LOG(LogVoxelCharacter, Display, TEXT("VCPerf: report written to %s"), *ReportPath);
+		}
+		if (Args.Num() > 1)
+		{
+			const TSharedPtr<FJsonObject> Baseline = FVCPerfCapture::LoadReport(Args[1]);
+			TArray<FString> Regressions;
+			if (!Baseline.IsValid())
+			{
+				UE_LOG(LogVoxelCharacter, Error, TEXT("VCPerf: baseline '%s' missing or unreadable"), *Args[1]);
+			}
+			else if (FVCPerfCapture::CompareReports(*Report, *Baseline, Args.Num() > 2 ? FCString::Atod(*Args[2]) : 0.10, Regressions))
+			{
+				UE_LOG(LogVoxelCharacter, Display, TEXT("VCPerf: no regressions against %s"), *Args[1]);
+			}
+			else
+			{
+				for (const FString& Regression : Regressions)
+				{
+					UE_LOG(LogVoxelCharacter, Error, TEXT("VCPerf: regression: %s"), *Regression);
+				}
+			}
+		}
+	}));
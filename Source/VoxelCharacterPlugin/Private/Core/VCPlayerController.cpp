@@ -1,6 +1,9 @@
 // Copyright Daniel Raquel. All Rights Reserved.
 
 #include "Core/VCPlayerController.h"
+#include "Core/VCEditLatencyTracker.h"
+#include "Core/VCBudgetWatchdog.h"
+#include "Core/VCNetTrafficTracker.h"
 #include "Input/VCInputConfig.h"
 #include "Movement/VCVoxelNavigationHelper.h"
 #include "Engine/Engine.h"
@@ -1018,27 +1021,85 @@ void AVCPlayerController::SpawnWorldItem(FString AssetName, int32 Count)
 // Server RPC — Voxel Modification
 // ---------------------------------------------------------------------------
 
-void AVCPlayerController::Server_RequestVoxelModification_Implementation(const FIntVector& VoxelCoord, EVoxelModificationType ModType, uint8 MaterialID)
+void AVCPlayerController::RequestVoxelModification(const FIntVector& VoxelCoord, EVoxelModificationType ModType, uint8 MaterialID)
 {
+	FVCEditRequestStamp Stamp;
+
+	// Start the input->visible timer against the chunk holding the edit centre.
+	if (UVCEditLatencyTracker* Tracker = UVCEditLatencyTracker::Get(this))
+	{
+		const UVoxelChunkManager* ChunkMgr = FVCVoxelNavigationHelper::FindChunkManager(GetWorld());
+		if (const UVoxelWorldConfiguration* Config = ChunkMgr ? ChunkMgr->GetConfiguration() : nullptr)
+		{
+			const FIntVector ChunkCoord = FVoxelCoordinates::WorldToChunk(
+				FVector(VoxelCoord) * Config->VoxelSize, Config->ChunkSize, Config->VoxelSize);
+			Stamp = Tracker->BeginClientEdit(ChunkCoord);
+		}
+	}
+
+	FVCNetSendScope NetScope(this, GetNetConnection(), EVCNetTraffic::EditRequest);
+	Server_RequestVoxelModification(VoxelCoord, ModType, MaterialID, Stamp);
+}
+
+void AVCPlayerController::Server_RequestVoxelModification_Implementation(const FIntVector& VoxelCoord, EVoxelModificationType ModType, uint8 MaterialID, const FVCEditRequestStamp& Stamp)
+{
+	UVCEditLatencyTracker* LatencyTracker = UVCEditLatencyTracker::Get(this);
+	const double ReceiptTime = LatencyTracker ? LatencyTracker->RecordServerReceipt(Stamp) : 0.0;
+
+	if (UVCNetTrafficTracker* NetTraffic = UVCNetTrafficTracker::Get(this))
+	{
+		NetTraffic->RecordBits(GetNetConnection(), EVCNetTraffic::EditRequest, UVCNetTrafficTracker::GetRpcModelBits(EVCNetTraffic::EditRequest));
+	}
+
+	int32 RejectedVoxels = 0;
+	FIntVector ChunkCoord;
+	if (!ApplyVoxelModification(GetPawn(), VoxelCoord, ModType, MaterialID, RejectedVoxels, ChunkCoord))
+	{
+		return;
+	}
+
+	// Edit-protection feedback: tell the owning client so its UI can react.
+	if (RejectedVoxels > 0)
+	{
+		FVCNetSendScope NetScope(this, GetNetConnection(), EVCNetTraffic::EditBlocked);
+		Client_NotifyVoxelEditBlocked(RejectedVoxels);
+	}
+
+	if (LatencyTracker)
+	{
+		LatencyTracker->RecordServerApplied(Stamp, ReceiptTime, ChunkCoord);
+	}
+}
+
+bool AVCPlayerController::ApplyVoxelModification(APawn* EditingPawn, const FIntVector& VoxelCoord, EVoxelModificationType ModType, uint8 MaterialID, int32& OutRejectedVoxels, FIntVector& OutChunkCoord)
+{
+	OutRejectedVoxels = 0;
+	APawn* ControlledPawn = EditingPawn;
+
 	// --- Validation ---
-	APawn* ControlledPawn = GetPawn();
 	if (!ControlledPawn)
 	{
-		UE_LOG(LogVoxelCharacter, Warning, TEXT("Server_RequestVoxelModification: No pawn"));
-		return;
+		UE_LOG(LogVoxelCharacter, Warning, TEXT("ApplyVoxelModification: No pawn"));
+		return false;
+	}
+
+	if (!ControlledPawn->HasAuthority())
+	{
+		UE_LOG(LogVoxelCharacter, Warning, TEXT("ApplyVoxelModification: No authority over %s"), *ControlledPawn->GetName());
+		return false;
 	}
 
-	UVoxelChunkManager* ChunkMgr = FVCVoxelNavigationHelper::FindChunkManager(GetWorld());
+	UVoxelChunkManager* ChunkMgr = FVCVoxelNavigationHelper::FindChunkManager(ControlledPawn->GetWorld());
 	if (!ChunkMgr || !ChunkMgr->IsInitialized())
 	{
-		UE_LOG(LogVoxelCharacter, Warning, TEXT("Server_RequestVoxelModification: No chunk manager"));
-		return;
+		UE_LOG(LogVoxelCharacter, Warning, TEXT("ApplyVoxelModification: No chunk manager"));
+		return false;
 	}
 
 	const UVoxelWorldConfiguration* Config = ChunkMgr->GetConfiguration();
 	if (!Config)
 	{
-		return;
+		return false;
 	}
 
 	// Convert voxel coordinate back to world position for distance validation
@@ -1049,17 +1110,19 @@ void AVCPlayerController::Server_RequestVoxelModification_Implementation(const F
 	constexpr float MaxModificationRange = 800.f;
 	if (DistToVoxel > MaxModificationRange)
 	{
-		UE_LOG(LogVoxelCharacter, Warning, TEXT("Server_RequestVoxelModification: Out of range (%.0f > %.0f)"),
+		UE_LOG(LogVoxelCharacter, Warning, TEXT("ApplyVoxelModification: Out of range (%.0f > %.0f)"),
 			DistToVoxel, MaxModificationRange);
-		return;
+		return false;
 	}
 
 	// --- Apply Edit ---
 	UVoxelEditManager* EditMgr = ChunkMgr->GetEditManager();
 	if (!EditMgr)
 	{
-		return;
+		return false;
 	}
+	FVCBudgetScope Budget(EVCBudget::EditApply, ControlledPawn);
+	Budget.Location = VoxelWorldPos;
 
 	// Set edit source to Player so scatter is permanently removed
 	EditMgr->SetEditSource(EEditSource::Player);
@@ -1106,9 +1169,9 @@ void AVCPlayerController::Server_RequestVoxelModification_Implementation(const F
 				if (bOverlaps)
 				{
 					UE_LOG(LogVoxelCharacter, Verbose,
-						TEXT("Server_RequestVoxelModification: Rejected place at [%d,%d,%d] — overlaps pawn capsule"),
+						TEXT("ApplyVoxelModification: Rejected place at [%d,%d,%d] — overlaps pawn capsule"),
 						VoxelCoord.X, VoxelCoord.Y, VoxelCoord.Z);
-					return;
+					return false;
 				}
 			}
 		}
@@ -1145,12 +1208,19 @@ void AVCPlayerController::Server_RequestVoxelModification_Implementation(const F
 	}
 
 	// Edit-protection feedback: the edit manager counts voxels a validator vetoed during the
-	// apply above (e.g. protected POI/dungeon claims). Tell the owning client so its UI can react.
-	const int32 RejectedVoxels = EditMgr->GetLastRejectedEditCount();
-	if (RejectedVoxels > 0)
-	{
-		Client_NotifyVoxelEditBlocked(RejectedVoxels);
-	}
+	// apply above (e.g. protected POI/dungeon claims).
+	OutRejectedVoxels = EditMgr->GetLastRejectedEditCount();
+
+	// Chunks the brush's bounds overlap — each is rewritten and remeshed, which is what an overrun costs.
+	const FIntVector MinChunk = FVoxelCoordinates::WorldToChunk(
+		VoxelWorldPos - FVector(Brush.Radius) - Config->WorldOrigin, Config->ChunkSize, Config->VoxelSize);
+	const FIntVector MaxChunk = FVoxelCoordinates::WorldToChunk(
+		VoxelWorldPos + FVector(Brush.Radius) - Config->WorldOrigin, Config->ChunkSize, Config->VoxelSize);
+	Budget.Count = (MaxChunk.X - MinChunk.X + 1) * (MaxChunk.Y - MinChunk.Y + 1) * (MaxChunk.Z - MinChunk.Z + 1);
+
+	OutChunkCoord = FVoxelCoordinates::WorldToChunk(
+		VoxelWorldPos - Config->WorldOrigin, Config->ChunkSize, Config->VoxelSize);
+	return true;
 }
 
 void AVCPlayerController::Client_NotifyVoxelEditBlocked_Implementation(int32 RejectedVoxelCount)
@@ -0,0 +1,241 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#include "Core/VCStressBotController.h"
+#include "Core/VCPlayerController.h"
+#include "Core/VCPlayerState.h"
+#include "Movement/VCVoxelNavigationHelper.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/GameModeBase.h"
+#include "Engine/World.h"
+#include "VoxelChunkManager.h"
+#include "VoxelWorldConfiguration.h"
+#include "VoxelCoordinates.h"
+
+namespace VCStressBot
+{
+	/** Waypoint reached within this 2D distance. */
+	constexpr float ArriveDistance = 150.f;
+
+	/** A waypoint not reached in this long is abandoned (cliff, dug pit, deep water). */
+	constexpr float MaxWaypointSeconds = 20.f;
+
+	/** Below this horizontal speed the bot counts as stuck and hops. */
+	constexpr float StuckSpeed = 50.f;
+	constexpr float StuckHopSeconds = 1.f;
+
+	/** Edit trace length; inside the server's 800 unit edit range. */
+	constexpr float EditReach = 500.f;
+
+	/** Candidate points tried when looking for water. */
+	constexpr int32 WaterSearchTries = 8;
+}
+
+AVCStressBotController::AVCStressBotController()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	bWantsPlayerState = true;
+}
+
+void AVCStressBotController::InitPlayerState()
+{
+	UWorld* World = GetWorld();
+	const AGameModeBase* GameMode = World ? World->GetAuthGameMode() : nullptr;
+	if (GetNetMode() == NM_Client || !GameMode)
+	{
+		Super::InitPlayerState();
+		return;
+	}
+
+	// AVCCharacterBase::PossessedBy only initializes GAS through an AVCPlayerState, so bots need
+	// one even when the GameMode's PlayerStateClass is something else — otherwise they carry no
+	// ASC, no attribute replication and none of a player's per-connection cost.
+	TSubclassOf<APlayerState> StateClass = GameMode->PlayerStateClass;
+	if (!StateClass || !StateClass->IsChildOf(AVCPlayerState::StaticClass()))
+	{
+		StateClass = AVCPlayerState::StaticClass();
+	}
+
+	FActorSpawnParameters SpawnInfo;
+	SpawnInfo.Owner = this;
+	SpawnInfo.Instigator = GetInstigator();
+	SpawnInfo.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnInfo.ObjectFlags |= RF_Transient;
+	PlayerState = World->SpawnActor<APlayerState>(StateClass, SpawnInfo);
+	if (PlayerState)
+	{
+		PlayerState->SetPlayerName(GetName());
+	}
+}
+
+void AVCStressBotController::InitBot(int32 Seed, const FVector& InHomeLocation)
+{
+	Script.Init(Seed, InHomeLocation);
+}
+
+void AVCStressBotController::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	ACharacter* Bot = Cast<ACharacter>(GetPawn());
+	FIntVector VoxelCoord;
+	EVoxelModificationType ModType;
+	uint8 MaterialID = 0;
+	if (!Bot || !Script.Tick(Bot, this, DeltaSeconds, VoxelCoord, ModType, MaterialID))
+	{
+		return;
+	}
+
+	int32 RejectedVoxels = 0;
+	FIntVector ChunkCoord;
+	if (AVCPlayerController::ApplyVoxelModification(Bot, VoxelCoord, ModType, MaterialID, RejectedVoxels, ChunkCoord))
+	{
+		++EditsApplied;
+	}
+	else
+	{
+		++EditsRejected;
+	}
+}
+
+// ---------------------------------------------------------------------------
+// FVCStressBotScript
+// ---------------------------------------------------------------------------
+
+void FVCStressBotScript::Init(int32 Seed, const FVector& InHomeLocation)
+{
+	Random.Initialize(Seed);
+	HomeLocation = InHomeLocation;
+	Waypoint = InHomeLocation;
+	WaypointTime = 0.f;
+	StuckTime = 0.f;
+	bPlaceNext = false;
+
+	// Stagger the first edit so a freshly spawned wave does not edit on the same frame.
+	EditCountdown = Random.FRandRange(0.f, FMath::Max(EditInterval, 0.f));
+}
+
+bool FVCStressBotScript::Tick(ACharacter* Bot, AController* Controller, float DeltaSeconds, FIntVector& OutVoxelCoord, EVoxelModificationType& OutModType, uint8& OutMaterialID)
+{
+	// --- Move ---
+	const UCharacterMovementComponent* MovComp = Bot->GetCharacterMovement();
+	const bool bSwimming = MovComp && MovComp->IsSwimming();
+
+	FVector ToWaypoint = Waypoint - Bot->GetActorLocation();
+	if (!bSwimming)
+	{
+		ToWaypoint.Z = 0.f;
+	}
+
+	WaypointTime += DeltaSeconds;
+	if (ToWaypoint.Size2D() < VCStressBot::ArriveDistance || WaypointTime > VCStressBot::MaxWaypointSeconds)
+	{
+		PickWaypoint(Bot->GetWorld());
+	}
+	else
+	{
+		const FVector Direction = ToWaypoint.GetSafeNormal();
+		if (Controller)
+		{
+			Controller->SetControlRotation(FRotator(0.f, Direction.Rotation().Yaw, 0.f));
+		}
+		Bot->AddMovementInput(Direction, 1.f);
+
+		// Stuck against a ledge or in a pit (possibly one it dug): hop.
+		if (!bSwimming && Bot->GetVelocity().Size2D() < VCStressBot::StuckSpeed)
+		{
+			StuckTime += DeltaSeconds;
+			if (StuckTime > VCStressBot::StuckHopSeconds)
+			{
+				Bot->Jump();
+				StuckTime = 0.f;
+			}
+		}
+		else
+		{
+			StuckTime = 0.f;
+		}
+	}
+
+	// --- Edit ---
+	if (EditInterval <= 0.f)
+	{
+		return false;
+	}
+	EditCountdown -= DeltaSeconds;
+	if (EditCountdown > 0.f)
+	{
+		return false;
+	}
+	EditCountdown = EditInterval * Random.FRandRange(0.5f, 1.5f);
+	return FindEditTarget(Bot, OutVoxelCoord, OutModType, OutMaterialID);
+}
+
+void FVCStressBotScript::PickWaypoint(UWorld* World)
+{
+	WaypointTime = 0.f;
+	StuckTime = 0.f;
+
+	auto RandomPointNearHome = [this]()
+	{
+		const FVector2D Offset = FVector2D(Random.GetUnitVector()).GetSafeNormal() * Random.FRandRange(0.f, WanderRadius);
+		return FVector(HomeLocation.X + Offset.X, HomeLocation.Y + Offset.Y, HomeLocation.Z);
+	};
+
+	UVoxelChunkManager* ChunkMgr = FVCVoxelNavigationHelper::FindChunkManager(World);
+	const UVoxelWorldConfiguration* Config = ChunkMgr ? ChunkMgr->GetConfiguration() : nullptr;
+	if (!Config)
+	{
+		Waypoint = RandomPointNearHome();
+		return;
+	}
+
+	// Swim leg: look for a point whose analytic surface lies under the water level, and head for
+	// just below the water surface there.
+	if (Config->bEnableWaterLevel && Random.FRand() < SwimChance)
+	{
+		const float WaterSurface = Config->WaterLevel + Config->WorldOrigin.Z;
+		for (int32 Try = 0; Try < VCStressBot::WaterSearchTries; ++Try)
+		{
+			const FVector Candidate = RandomPointNearHome();
+			if (ChunkMgr->GetGeneratedSurfaceHeight(Candidate.X, Candidate.Y) < Config->WaterLevel)
+			{
+				Waypoint = FVector(Candidate.X, Candidate.Y, WaterSurface - 100.f);
+				return;
+			}
+		}
+	}
+
+	Waypoint = RandomPointNearHome();
+	Waypoint.Z = ChunkMgr->GetGeneratedSurfaceHeight(Waypoint.X, Waypoint.Y);
+}
+
+bool FVCStressBotScript::FindEditTarget(ACharacter* Bot, FIntVector& OutVoxelCoord, EVoxelModificationType& OutModType, uint8& OutMaterialID)
+{
+	UVoxelChunkManager* ChunkMgr = FVCVoxelNavigationHelper::FindChunkManager(Bot->GetWorld());
+	const UVoxelWorldConfiguration* Config = ChunkMgr ? ChunkMgr->GetConfiguration() : nullptr;
+	if (!Config)
+	{
+		return false;
+	}
+
+	// Aim ahead and down at the ground in front of the feet, as a player digging would.
+	const FVector Start = Bot->GetPawnViewLocation();
+	const FVector Direction = (Bot->GetActorForwardVector() + FVector(0.f, 0.f, -1.f)).GetSafeNormal();
+
+	FHitResult Hit;
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(VCStressBotEdit), false, Bot);
+	if (!Bot->GetWorld()->LineTraceSingleByChannel(Hit, Start, Start + Direction * VCStressBot::EditReach, ECC_Visibility, Params))
+	{
+		return false;
+	}
+
+	// Alternate dig / place so long runs keep the terrain roughly level. Same targeting as
+	// AVCCharacterBase's primary / secondary actions.
+	OutModType = bPlaceNext ? EVoxelModificationType::Place : EVoxelModificationType::Destroy;
+	const FVector TargetPos = bPlaceNext ? Hit.ImpactPoint + Hit.ImpactNormal * (Config->VoxelSize * 0.5f) : Hit.ImpactPoint;
+	OutMaterialID = bPlaceNext ? PlaceMaterialID : 0;
+	OutVoxelCoord = FVoxelCoordinates::WorldToVoxel(TargetPos - Config->WorldOrigin, Config->VoxelSize);
+	bPlaceNext = !bPlaceNext;
+	return true;
+}
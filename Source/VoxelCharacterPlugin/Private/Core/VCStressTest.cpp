@@ -0,0 +1,582 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#include "Core/VCStressTest.h"
+#include "Core/VCStressBotController.h"
+#include "Core/VCCharacterBase.h"
+#include "Core/VCPlayerController.h"
+#include "Core/VCPerfReport.h"
+#include "Movement/VCVoxelNavigationHelper.h"
+#include "VoxelChunkManager.h"
+#include "VoxelWorldConfiguration.h"
+#include "VoxelCharacterStats.h"
+#include "VoxelCharacterPlugin.h"
+#include "Dom/JsonObject.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Paths.h"
+
+namespace VCStressTest
+{
+	/** Bots spawn in a ring of this radius around the spawn centre. */
+	constexpr float SpawnRadius = 2000.f;
+
+	/** Height above the analytic surface bots are dropped from (the terrain wait settles them). */
+	constexpr float SpawnHeight = 200.f;
+
+	/** Timers listed per ramp step in the scaling table. */
+	constexpr int32 TopSystemsShown = 3;
+
+	/** Scripted session: bots when -VCPerfScript gives no count. */
+	constexpr int32 DefaultScriptBots = 8;
+
+	/** Scripted session: the local player switches view mode at this interval... */
+	constexpr double ViewModeSeconds = 15.0;
+
+	/** ...and has the world map open for the last WorldMapOpenSeconds of every WorldMapPeriodSeconds. */
+	constexpr double WorldMapPeriodSeconds = 30.0;
+	constexpr double WorldMapOpenSeconds = 8.0;
+}
+
+static FAutoConsoleCommandWithWorldAndArgs GVCStressBotsCmd(
+	TEXT("vc.Stress.Bots"),
+	TEXT("Spawn / destroy scripted stress bots until N are alive (server). Args: <N>."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UVCStressTestSubsystem* Stress = UVCStressTestSubsystem::Get(World))
+		{
+			Stress->SetBotCount(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 0);
+		}
+	}));
+
+static FAutoConsoleCommandWithWorld GVCStressClearCmd(
+	TEXT("vc.Stress.Clear"),
+	TEXT("Destroy all stress bots and stop a running ramp."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UVCStressTestSubsystem* Stress = UVCStressTestSubsystem::Get(World))
+		{
+			Stress->ClearBots();
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs GVCStressRampCmd(
+	TEXT("vc.Stress.Ramp"),
+	TEXT("Step the bot count up, capturing a perf report per step (server). Args: <Start> <Step> <Max> <StepSeconds> [SettleSeconds] [quit]."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UVCStressTestSubsystem* Stress = UVCStressTestSubsystem::Get(World);
+		if (!Stress)
+		{
+			return;
+		}
+		if (Args.Num() < 4)
+		{
+			UE_LOG(LogVoxelCharacter, Warning, TEXT("vc.Stress.Ramp <Start> <Step> <Max> <StepSeconds> [SettleSeconds] [quit]"));
+			return;
+		}
+
+		UVCStressTestSubsystem::FRampSettings Settings;
+		Settings.StartBots = FCString::Atoi(*Args[0]);
+		Settings.StepBots = FCString::Atoi(*Args[1]);
+		Settings.MaxBots = FCString::Atoi(*Args[2]);
+		Settings.StepSeconds = FCString::Atod(*Args[3]);
+		if (Args.Num() > 4)
+		{
+			Settings.SettleSeconds = FCString::Atod(*Args[4]);
+		}
+		Settings.bExitWhenDone = Args.Num() > 5 && Args[5].Equals(TEXT("quit"), ESearchCase::IgnoreCase);
+		Stress->StartRamp(Settings);
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs GVCStressScriptCmd(
+	TEXT("vc.Stress.Script"),
+	TEXT("Start the fixed scripted session perf baselines are recorded with (bots + local player). Args: [Bots]."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UVCStressTestSubsystem* Stress = UVCStressTestSubsystem::Get(World))
+		{
+			Stress->StartScriptedSession(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : VCStressTest::DefaultScriptBots);
+		}
+	}));
+
+static FAutoConsoleCommandWithWorld GVCStressStatusCmd(
+	TEXT("vc.Stress.Status"),
+	TEXT("Log stress bot count, bot edits, net bandwidth and client connections."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UVCStressTestSubsystem* Stress = UVCStressTestSubsystem::Get(World))
+		{
+			Stress->LogStatus();
+		}
+	}));
+
+// ---------------------------------------------------------------------------
+// Lookup / Lifecycle
+// ---------------------------------------------------------------------------
+
+UVCStressTestSubsystem* UVCStressTestSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UVCStressTestSubsystem>() : nullptr;
+}
+
+void UVCStressTestSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// -VCPerfScript[=<Bots>]: run the scripted session for a -VCPerfSession capture.
+	const TCHAR* CommandLine = FCommandLine::Get();
+	int32 NumBots = VCStressTest::DefaultScriptBots;
+	if (FParse::Value(CommandLine, TEXT("VCPerfScript="), NumBots) || FParse::Param(CommandLine, TEXT("VCPerfScript")))
+	{
+		StartScriptedSession(NumBots);
+	}
+}
+
+void UVCStressTestSubsystem::Deinitialize()
+{
+	// Bot actors go down with the world; only drop the bookkeeping (and a half-run capture).
+	if (bRampCapturing)
+	{
+		FVCPerfCapture::End();
+	}
+	Ramp.Reset();
+	Bots.Empty();
+	bScriptedSession = false;
+	Pilot.Reset();
+
+	Super::Deinitialize();
+}
+
+TStatId UVCStressTestSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UVCStressTestSubsystem, STATGROUP_Tickables);
+}
+
+TSubclassOf<AVCCharacterBase> UVCStressTestSubsystem::GetBotClass() const
+{
+	if (const AGameModeBase* GameMode = GetWorld()->GetAuthGameMode())
+	{
+		if (GameMode->DefaultPawnClass && GameMode->DefaultPawnClass->IsChildOf(AVCCharacterBase::StaticClass()))
+		{
+			return TSubclassOf<AVCCharacterBase>(GameMode->DefaultPawnClass.Get());
+		}
+	}
+	return AVCCharacterBase::StaticClass();
+}
+
+// ---------------------------------------------------------------------------
+// Bots
+// ---------------------------------------------------------------------------
+
+void UVCStressTestSubsystem::SetBotCount(int32 Count)
+{
+	if (GetWorld()->GetNetMode() == NM_Client)
+	{
+		UE_LOG(LogVoxelCharacter, Warning, TEXT("VCStress: bots are server-side; run this on the server"));
+		return;
+	}
+
+	Count = FMath::Max(Count, 0);
+	while (Bots.Num() < Count)
+	{
+		if (!SpawnBot())
+		{
+			UE_LOG(LogVoxelCharacter, Error, TEXT("VCStress: bot spawn failed at %d / %d"), Bots.Num(), Count);
+			break;
+		}
+	}
+
+	// Newest first, so a ramp keeps its longest-running bots.
+	while (Bots.Num() > Count)
+	{
+		const FBot Bot = Bots.Pop();
+		if (AVCStressBotController* Controller = Bot.Controller.Get())
+		{
+			RetiredEditsApplied += Controller->GetEditsApplied();
+			RetiredEditsRejected += Controller->GetEditsRejected();
+			Controller->Destroy();
+		}
+		if (AVCCharacterBase* Character = Bot.Character.Get())
+		{
+			Character->Destroy();
+		}
+	}
+
+	UE_LOG(LogVoxelCharacter, Log, TEXT("VCStress: %d bots"), Bots.Num());
+}
+
+void UVCStressTestSubsystem::ClearBots()
+{
+	if (bRampCapturing)
+	{
+		FVCPerfCapture::End();
+		bRampCapturing = false;
+	}
+	Ramp.Reset();
+	bScriptedSession = false;
+	Pilot.Reset();
+	SetBotCount(0);
+}
+
+void UVCStressTestSubsystem::StartScriptedSession(int32 NumBots)
+{
+	// Same seeds every run, so two runs of the session do the same things. A client only pilots.
+	if (GetWorld()->GetNetMode() != NM_Client)
+	{
+		ClearBots();
+		NextBotSeed = 1;
+		SetBotCount(NumBots);
+	}
+	Pilot.Reset();
+	bScriptedSession = true;
+
+	UE_LOG(LogVoxelCharacter, Log, TEXT("VCStress: scripted session started (%d bots, local player piloted when present)"), Bots.Num());
+}
+
+bool UVCStressTestSubsystem::SpawnBot()
+{
+	UWorld* World = GetWorld();
+	const int32 Seed = NextBotSeed++;
+	FRandomStream Random(Seed);
+
+	const FVector Center = GetSpawnCenter();
+	const FVector2D Offset = FVector2D(Random.GetUnitVector()).GetSafeNormal() * Random.FRandRange(200.f, VCStressTest::SpawnRadius);
+	FVector SpawnLocation(Center.X + Offset.X, Center.Y + Offset.Y, Center.Z);
+
+	FVector Ground;
+	if (FVCVoxelNavigationHelper::FindSpawnablePosition(World, SpawnLocation, Ground))
+	{
+		SpawnLocation = Ground;
+	}
+	SpawnLocation.Z += VCStressTest::SpawnHeight;
+
+	FActorSpawnParameters Params;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+	AVCCharacterBase* Character = World->SpawnActor<AVCCharacterBase>(
+		GetBotClass(), SpawnLocation, FRotator(0.f, Random.FRandRange(0.f, 360.f), 0.f), Params);
+	if (!Character)
+	{
+		return false;
+	}
+
+	AVCStressBotController* Controller = World->SpawnActor<AVCStressBotController>();
+	if (!Controller)
+	{
+		Character->Destroy();
+		return false;
+	}
+	Controller->InitBot(Seed, Center);
+	Controller->Possess(Character);
+
+	FBot& Bot = Bots.AddDefaulted_GetRef();
+	Bot.Controller = Controller;
+	Bot.Character = Character;
+	return true;
+}
+
+FVector UVCStressTestSubsystem::GetSpawnCenter() const
+{
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (const APawn* Pawn = It->IsValid() ? (*It)->GetPawn() : nullptr)
+		{
+			return Pawn->GetActorLocation();
+		}
+	}
+
+	UVoxelChunkManager* ChunkMgr = FVCVoxelNavigationHelper::FindChunkManager(GetWorld());
+	const UVoxelWorldConfiguration* Config = ChunkMgr ? ChunkMgr->GetConfiguration() : nullptr;
+	return Config ? Config->WorldOrigin : FVector::ZeroVector;
+}
+
+// ---------------------------------------------------------------------------
+// Tick / Metrics
+// ---------------------------------------------------------------------------
+
+void UVCStressTestSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Drop bots whose character died or was destroyed elsewhere (kill volume, GM reset).
+	Bots.RemoveAll([this](const FBot& Bot)
+	{
+		AVCStressBotController* Controller = Bot.Controller.Get();
+		if (Controller && Bot.Character.IsValid())
+		{
+			return false;
+		}
+		if (Controller)
+		{
+			RetiredEditsApplied += Controller->GetEditsApplied();
+			RetiredEditsRejected += Controller->GetEditsRejected();
+			Controller->Destroy();
+		}
+		return true;
+	});
+
+	if (bScriptedSession)
+	{
+		TickPilot(DeltaTime);
+	}
+
+	if (Bots.Num() == 0 && !Ramp.IsSet())
+	{
+		return;
+	}
+
+	// --- Publish ---
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	const double NetInKBps = NetDriver ? NetDriver->InBytesPerSecond / 1024.0 : 0.0;
+	const double NetOutKBps = NetDriver ? NetDriver->OutBytesPerSecond / 1024.0 : 0.0;
+
+	CSV_CUSTOM_STAT(VCStress, Bots, Bots.Num(), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(VCStress, Clients, NetDriver ? NetDriver->ClientConnections.Num() : 0, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(VCStress, NetInKBps, static_cast<float>(NetInKBps), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(VCStress, NetOutKBps, static_cast<float>(NetOutKBps), ECsvCustomStatOp::Set);
+#if CSV_PROFILER
+	int32 EditsApplied = 0;
+	int32 EditsRejected = 0;
+	GetBotEdits(EditsApplied, EditsRejected);
+	CSV_CUSTOM_STAT(VCStress, BotEditsApplied, EditsApplied, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(VCStress, BotEditsRejected, EditsRejected, ECsvCustomStatOp::Set);
+#endif
+	if (FVCPerfCapture::IsCapturing())
+	{
+		FVCPerfCapture::RecordValue(TEXT("VCStress/Bots"), Bots.Num());
+		FVCPerfCapture::RecordValue(TEXT("VCStress/NetInKBps"), NetInKBps);
+		FVCPerfCapture::RecordValue(TEXT("VCStress/NetOutKBps"), NetOutKBps);
+	}
+
+	// --- Ramp ---
+	if (!Ramp.IsSet())
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (!bRampCapturing && Now - RampPhaseStart >= Ramp->SettleSeconds)
+	{
+		FVCPerfCapture::Begin();
+		bRampCapturing = true;
+		RampPhaseStart = Now;
+	}
+	else if (bRampCapturing && Now - RampPhaseStart >= Ramp->StepSeconds)
+	{
+		FinishRampStep();
+	}
+}
+
+void UVCStressTestSubsystem::TickPilot(float DeltaTime)
+{
+	AVCPlayerController* PC = Pilot.Get();
+	if (!PC)
+	{
+		// Pick up the local player once its character is in (it may still be waiting for terrain).
+		for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+		{
+			AVCPlayerController* Candidate = Cast<AVCPlayerController>(It->Get());
+			if (Candidate && Candidate->IsLocalController() && Cast<AVCCharacterBase>(Candidate->GetPawn()))
+			{
+				PC = Candidate;
+				break;
+			}
+		}
+		if (!PC)
+		{
+			return;
+		}
+		Pilot = PC;
+		PilotScript.Init(0, PC->GetPawn()->GetActorLocation());
+		PilotStartTime = GetWorld()->GetTimeSeconds();
+	}
+
+	AVCCharacterBase* Character = Cast<AVCCharacterBase>(PC->GetPawn());
+	if (!Character)
+	{
+		return;
+	}
+
+	// Movement and edits: the player's own edit RPC, so latency tracking and net accounting run.
+	FIntVector VoxelCoord;
+	EVoxelModificationType ModType;
+	uint8 MaterialID = 0;
+	if (PilotScript.Tick(Character, PC, DeltaTime, VoxelCoord, ModType, MaterialID))
+	{
+		PC->RequestVoxelModification(VoxelCoord, ModType, MaterialID);
+	}
+
+	// Camera and map on a fixed schedule.
+	const double Elapsed = GetWorld()->GetTimeSeconds() - PilotStartTime;
+	const EVCViewMode ViewMode = FMath::FloorToInt(Elapsed / VCStressTest::ViewModeSeconds) % 2 == 0
+		? EVCViewMode::ThirdPerson
+		: EVCViewMode::FirstPerson;
+	Character->SetViewMode(ViewMode);
+
+	const bool bMapOpen = FMath::Fmod(Elapsed, VCStressTest::WorldMapPeriodSeconds) >= VCStressTest::WorldMapPeriodSeconds - VCStressTest::WorldMapOpenSeconds;
+	if (PC->IsWorldMapOpen() != bMapOpen)
+	{
+		PC->ToggleWorldMapUI();
+	}
+}
+
+void UVCStressTestSubsystem::GetBotEdits(int32& OutApplied, int32& OutRejected) const
+{
+	OutApplied = RetiredEditsApplied;
+	OutRejected = RetiredEditsRejected;
+	for (const FBot& Bot : Bots)
+	{
+		if (const AVCStressBotController* Controller = Bot.Controller.Get())
+		{
+			OutApplied += Controller->GetEditsApplied();
+			OutRejected += Controller->GetEditsRejected();
+		}
+	}
+}
+
+void UVCStressTestSubsystem::LogStatus() const
+{
+	int32 EditsApplied = 0;
+	int32 EditsRejected = 0;
+	GetBotEdits(EditsApplied, EditsRejected);
+
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	UE_LOG(LogVoxelCharacter, Log, TEXT("VCStress: %d bots (%s), edits %d applied / %d rejected, net in %.1f KB/s out %.1f KB/s, %d client connections%s"),
+		Bots.Num(), *GetNameSafe(GetBotClass()), EditsApplied, EditsRejected,
+		NetDriver ? NetDriver->InBytesPerSecond / 1024.0 : 0.0,
+		NetDriver ? NetDriver->OutBytesPerSecond / 1024.0 : 0.0,
+		NetDriver ? NetDriver->ClientConnections.Num() : 0,
+		Ramp.IsSet() ? TEXT(", ramp running") : TEXT(""));
+}
+
+// ---------------------------------------------------------------------------
+// Ramp
+// ---------------------------------------------------------------------------
+
+void UVCStressTestSubsystem::StartRamp(const FRampSettings& Settings)
+{
+	if (GetWorld()->GetNetMode() == NM_Client)
+	{
+		UE_LOG(LogVoxelCharacter, Warning, TEXT("VCStress: bots are server-side; run this on the server"));
+		return;
+	}
+	if (FVCPerfCapture::IsCapturing())
+	{
+		UE_LOG(LogVoxelCharacter, Warning, TEXT("VCStress: a perf capture is running; the ramp restarts it per step"));
+	}
+
+	Ramp = Settings;
+	Ramp->StartBots = FMath::Max(Settings.StartBots, 0);
+	RampRows.Reset();
+	RampBots = Ramp->StartBots;
+	RampPhaseStart = FPlatformTime::Seconds();
+	bRampCapturing = false;
+	SetBotCount(RampBots);
+
+	UE_LOG(LogVoxelCharacter, Log, TEXT("VCStress: ramp %d..%d step %d, %.0fs per step (+%.0fs settle)"),
+		Ramp->StartBots, Ramp->MaxBots, Ramp->StepBots, Ramp->StepSeconds, Ramp->SettleSeconds);
+}
+
+void UVCStressTestSubsystem::FinishRampStep()
+{
+	bRampCapturing = false;
+	const TSharedRef<FJsonObject> Report = FVCPerfCapture::End();
+
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	TSharedRef<FJsonObject> StressInfo = MakeShared<FJsonObject>();
+	StressInfo->SetNumberField(TEXT("bots"), Bots.Num());
+	StressInfo->SetNumberField(TEXT("clients"), NetDriver ? NetDriver->ClientConnections.Num() : 0);
+	StressInfo->SetStringField(TEXT("botClass"), GetNameSafe(GetBotClass()));
+	int32 EditsApplied = 0;
+	int32 EditsRejected = 0;
+	GetBotEdits(EditsApplied, EditsRejected);
+	StressInfo->SetNumberField(TEXT("editsApplied"), EditsApplied);
+	StressInfo->SetNumberField(TEXT("editsRejected"), EditsRejected);
+	Report->SetObjectField(TEXT("stress"), StressInfo);
+
+	const FString ReportPath = FPaths::ProfilingDir() / TEXT("VCStress") / FString::Printf(TEXT("VCStress_%03d.json"), Bots.Num());
+	FVCPerfCapture::SaveReport(Report, ReportPath);
+
+	// --- Scaling table row ---
+	FRampRow Row;
+	Row.Bots = Bots.Num();
+
+	const TSharedPtr<FJsonObject>* Metrics = nullptr;
+	if (Report->TryGetObjectField(TEXT("metrics"), Metrics))
+	{
+		auto GetMetricField = [&Metrics](const TCHAR* Name, const TCHAR* Field)
+		{
+			const TSharedPtr<FJsonObject>* Metric = nullptr;
+			return (*Metrics)->TryGetObjectField(Name, Metric) ? (*Metric)->GetNumberField(Field) : 0.0;
+		};
+		Row.FrameAvgMs = GetMetricField(TEXT("Frame/GameThread"), TEXT("avg"));
+		Row.FrameP95Ms = GetMetricField(TEXT("Frame/GameThread"), TEXT("p95"));
+		Row.NetOutKBps = GetMetricField(TEXT("VCStress/NetOutKBps"), TEXT("avg"));
+		Row.NetInKBps = GetMetricField(TEXT("VCStress/NetInKBps"), TEXT("avg"));
+
+		// Per-system cost per frame: timers (the metrics with "calls") average over the frames
+		// they ran in, so scale by the share of frames they ran in.
+		const double Frames = FMath::Max(Report->GetNumberField(TEXT("frames")), 1.0);
+		TArray<TPair<FString, double>> Systems;
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*Metrics)->Values)
+		{
+			const TSharedPtr<FJsonObject> Metric = Pair.Value->AsObject();
+			if (Metric.IsValid() && Metric->HasField(TEXT("calls")))
+			{
+				Systems.Emplace(Pair.Key, Metric->GetNumberField(TEXT("avg")) * Metric->GetNumberField(TEXT("count")) / Frames);
+			}
+		}
+		Systems.Sort([](const TPair<FString, double>& A, const TPair<FString, double>& B) { return A.Value > B.Value; });
+		for (int32 i = 0; i < FMath::Min(Systems.Num(), VCStressTest::TopSystemsShown); ++i)
+		{
+			Row.TopSystems += FString::Printf(TEXT("%s%s %.2f"), i > 0 ? TEXT(", ") : TEXT(""), *Systems[i].Key, Systems[i].Value);
+		}
+	}
+
+	UE_LOG(LogVoxelCharacter, Display, TEXT("VCStress: %d bots  frame %.2f / p95 %.2f ms  net out %.1f in %.1f KB/s  [%s]  -> %s"),
+		Row.Bots, Row.FrameAvgMs, Row.FrameP95Ms, Row.NetOutKBps, Row.NetInKBps, *Row.TopSystems, *ReportPath);
+	RampRows.Add(MoveTemp(Row));
+
+	// --- Next step ---
+	RampBots += Ramp->StepBots;
+	if (Ramp->StepBots <= 0 || RampBots > Ramp->MaxBots)
+	{
+		LogRampTable();
+		const bool bExit = Ramp->bExitWhenDone;
+		Ramp.Reset();
+		if (bExit)
+		{
+			FPlatformMisc::RequestExitWithStatus(false, 0);
+		}
+		return;
+	}
+
+	SetBotCount(RampBots);
+	RampPhaseStart = FPlatformTime::Seconds();
+}
+
+void UVCStressTestSubsystem::LogRampTable() const
+{
+	UE_LOG(LogVoxelCharacter, Display, TEXT("=== VCStress ramp (%s) ==="), *GetNameSafe(GetBotClass()));
+	UE_LOG(LogVoxelCharacter, Display, TEXT("  %5s  %9s  %9s  %9s  %9s  %s"), TEXT("Bots"), TEXT("Frame ms"), TEXT("p95 ms"), TEXT("Out KB/s"), TEXT("In KB/s"), TEXT("Top systems (ms/frame)"));
+
+	const FRampRow* First = RampRows.Num() > 0 ? &RampRows[0] : nullptr;
+	for (const FRampRow& Row : RampRows)
+	{
+		UE_LOG(LogVoxelCharacter, Display, TEXT("  %5d  %9.2f  %9.2f  %9.1f  %9.1f  %s"),
+			Row.Bots, Row.FrameAvgMs, Row.FrameP95Ms, Row.NetOutKBps, Row.NetInKBps, *Row.TopSystems);
+	}
+
+	// Marginal cost per bot between the first and last step.
+	const FRampRow* Last = RampRows.Num() > 1 ? &RampRows.Last() : nullptr;
+	if (First && Last && Last->Bots > First->Bots)
+	{
+		const double BotDelta = Last->Bots - First->Bots;
+		UE_LOG(LogVoxelCharacter, Display, TEXT("  per bot: %.3f ms frame, %.2f KB/s out"),
+			(Last->FrameAvgMs - First->FrameAvgMs) / BotDelta, (Last->NetOutKBps - First->NetOutKBps) / BotDelta);
+	}
+}
@@ -0,0 +1,323 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#include "Map/VCExploredTileSet.h"
+
+namespace VCExploredTileSet
+{
+	static constexpr int32 ChunkShift = FVCExploredTileSet::ChunkShift;
+	static constexpr int32 ChunkSize = FVCExploredTileSet::ChunkSize;
+	static constexpr int32 ChunkMask = ChunkSize - 1;
+	static constexpr int32 TilesPerChunk = ChunkSize * ChunkSize;
+	static constexpr uint8 SaveFormatVersion = 1;
+
+	FORCEINLINE FIntPoint ChunkOf(const FIntPoint& Tile)
+	{
+		return FIntPoint(Tile.X >> ChunkShift, Tile.Y >> ChunkShift);
+	}
+
+	/** Bits [X0, X1) of a row word, 0 <= X0 < X1 <= 64. */
+	FORCEINLINE uint64 RowMask(int32 X0, int32 X1)
+	{
+		const int32 Width = X1 - X0;
+		return (Width >= 64 ? ~uint64(0) : ((uint64(1) << Width) - 1)) << X0;
+	}
+
+	/** Visit each chunk overlapping [Rect.Min, Rect.Max) with the chunk-local overlap (Max exclusive). */
+	void ForEachChunkOverlap(const FIntRect& Rect, TFunctionRef<void(const FIntPoint& ChunkCoord, const FIntRect& Local)> Func)
+	{
+		if (Rect.Min.X >= Rect.Max.X || Rect.Min.Y >= Rect.Max.Y)
+		{
+			return;
+		}
+
+		const FIntPoint FirstChunk = ChunkOf(Rect.Min);
+		const FIntPoint LastChunk = ChunkOf(Rect.Max - FIntPoint(1, 1));
+		for (int32 CY = FirstChunk.Y; CY <= LastChunk.Y; ++CY)
+		{
+			for (int32 CX = FirstChunk.X; CX <= LastChunk.X; ++CX)
+			{
+				const FIntPoint Base(CX << ChunkShift, CY << ChunkShift);
+				const FIntRect Local(
+					FMath::Max(Rect.Min.X - Base.X, 0), FMath::Max(Rect.Min.Y - Base.Y, 0),
+					FMath::Min(Rect.Max.X - Base.X, ChunkSize), FMath::Min(Rect.Max.Y - Base.Y, ChunkSize));
+				Func(FIntPoint(CX, CY), Local);
+			}
+		}
+	}
+
+	void WriteVarint(TArray<uint8>& Out, uint32 Value)
+	{
+		while (Value >= 0x80)
+		{
+			Out.Add(static_cast<uint8>(Value | 0x80));
+			Value >>= 7;
+		}
+		Out.Add(static_cast<uint8>(Value));
+	}
+
+	bool ReadVarint(TConstArrayView<uint8> Data, int32& Offset, uint32& OutValue)
+	{
+		OutValue = 0;
+		for (int32 Shift = 0; Shift < 35; Shift += 7)
+		{
+			if (Offset >= Data.Num())
+			{
+				return false;
+			}
+			const uint8 Byte = Data[Offset++];
+			OutValue |= static_cast<uint32>(Byte & 0x7F) << Shift;
+			if ((Byte & 0x80) == 0)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	FORCEINLINE uint32 ZigZag(int32 Value)
+	{
+		return (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31);
+	}
+
+	FORCEINLINE int32 UnZigZag(uint32 Value)
+	{
+		return static_cast<int32>(Value >> 1) ^ -static_cast<int32>(Value & 1);
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Point Access
+// ---------------------------------------------------------------------------
+
+bool FVCExploredTileSet::IsExplored(const FIntPoint& Tile) const
+{
+	using namespace VCExploredTileSet;
+	const FChunk* Chunk = Chunks.Find(ChunkOf(Tile));
+	return Chunk && (Chunk->Explored[Tile.Y & ChunkMask] >> (Tile.X & ChunkMask)) & 1;
+}
+
+bool FVCExploredTileSet::SetExplored(const FIntPoint& Tile)
+{
+	using namespace VCExploredTileSet;
+	FChunk& Chunk = Chunks.FindOrAdd(ChunkOf(Tile));
+	uint64& Row = Chunk.Explored[Tile.Y & ChunkMask];
+	const uint64 Bit = uint64(1) << (Tile.X & ChunkMask);
+	if (Row & Bit)
+	{
+		return false;
+	}
+	Row |= Bit;
+	++Chunk.NumExplored;
+	++NumExplored;
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+// Rect Queries
+// ---------------------------------------------------------------------------
+
+bool FVCExploredTileSet::AnyExplored(const FIntRect& Rect) const
+{
+	using namespace VCExploredTileSet;
+	bool bAny = false;
+	ForEachChunkOverlap(Rect, [this, &bAny](const FIntPoint& ChunkCoord, const FIntRect& Local)
+	{
+		const FChunk* Chunk = bAny ? nullptr : Chunks.Find(ChunkCoord);
+		if (!Chunk || Chunk->NumExplored == 0)
+		{
+			return;
+		}
+		const uint64 Mask = RowMask(Local.Min.X, Local.Max.X);
+		for (int32 Row = Local.Min.Y; Row < Local.Max.Y && !bAny; ++Row)
+		{
+			bAny = (Chunk->Explored[Row] & Mask) != 0;
+		}
+	});
+	return bAny;
+}
+
+int64 FVCExploredTileSet::CountExplored(const FIntRect& Rect) const
+{
+	using namespace VCExploredTileSet;
+	int64 Count = 0;
+	ForEachChunkOverlap(Rect, [this, &Count](const FIntPoint& ChunkCoord, const FIntRect& Local)
+	{
+		const FChunk* Chunk = Chunks.Find(ChunkCoord);
+		if (!Chunk || Chunk->NumExplored == 0)
+		{
+			return;
+		}
+		if (Local.Width() == ChunkSize && Local.Height() == ChunkSize)
+		{
+			Count += Chunk->NumExplored;
+			return;
+		}
+		const uint64 Mask = RowMask(Local.Min.X, Local.Max.X);
+		for (int32 Row = Local.Min.Y; Row < Local.Max.Y; ++Row)
+		{
+			Count += FMath::CountBits(Chunk->Explored[Row] & Mask);
+		}
+	});
+	return Count;
+}
+
+void FVCExploredTileSet::ForEachExplored(TFunctionRef<void(const FIntPoint& Tile)> Func) const
+{
+	using namespace VCExploredTileSet;
+	for (const TPair<FIntPoint, FChunk>& Pair : Chunks)
+	{
+		if (Pair.Value.NumExplored == 0)
+		{
+			continue;
+		}
+		const FIntPoint Base(Pair.Key.X << ChunkShift, Pair.Key.Y << ChunkShift);
+		for (int32 Row = 0; Row < ChunkSize; ++Row)
+		{
+			uint64 Word = Pair.Value.Explored[Row];
+			while (Word != 0)
+			{
+				const int32 X = static_cast<int32>(FMath::CountTrailingZeros64(Word));
+				Word &= Word - 1;
+				Func(FIntPoint(Base.X + X, Base.Y + Row));
+			}
+		}
+	}
+}
+
+void FVCExploredTileSet::Reset()
+{
+	Chunks.Reset();
+	NumExplored = 0;
+}
+
+// ---------------------------------------------------------------------------
+// Persistence
+// ---------------------------------------------------------------------------
+
+void FVCExploredTileSet::Save(TArray<uint8>& Out) const
+{
+	using namespace VCExploredTileSet;
+
+	// Chunks in a stable order so equal sets encode to equal bytes.
+	TArray<FIntPoint> Keys;
+	for (const TPair<FIntPoint, FChunk>& Pair : Chunks)
+	{
+		if (Pair.Value.NumExplored > 0)
+		{
+			Keys.Add(Pair.Key);
+		}
+	}
+	Keys.Sort([](const FIntPoint& A, const FIntPoint& B) { return A.Y != B.Y ? A.Y < B.Y : A.X < B.X; });
+
+	Out.Add(SaveFormatVersion);
+	WriteVarint(Out, Keys.Num());
+	for (const FIntPoint& Key : Keys)
+	{
+		const FChunk& Chunk = Chunks.FindChecked(Key);
+		WriteVarint(Out, ZigZag(Key.X));
+		WriteVarint(Out, ZigZag(Key.Y));
+
+		// Alternating run lengths over the chunk's bits in row order, starting with unexplored
+		// (the first run may be empty). A trailing unexplored run is implied, so a chunk explored
+		// in one blob costs a handful of bytes.
+		TArray<uint32, TInlineAllocator<64>> Runs;
+		bool bRunValue = false;
+		uint32 RunLength = 0;
+		for (int32 Row = 0; Row < ChunkSize; ++Row)
+		{
+			const uint64 Word = Chunk.Explored[Row];
+			for (int32 X = 0; X < ChunkSize; ++X)
+			{
+				const bool bBit = (Word >> X) & 1;
+				if (bBit != bRunValue)
+				{
+					Runs.Add(RunLength);
+					bRunValue = bBit;
+					RunLength = 0;
+				}
+				++RunLength;
+			}
+		}
+		if (bRunValue)
+		{
+			Runs.Add(RunLength);
+		}
+
+		WriteVarint(Out, Runs.Num());
+		for (const uint32 Run : Runs)
+		{
+			WriteVarint(Out, Run);
+		}
+	}
+}
+
+bool FVCExploredTileSet::Load(TConstArrayView<uint8> Data)
+{
+	using namespace VCExploredTileSet;
+
+	int32 Offset = 0;
+	if (Data.Num() < 1 || Data[Offset++] != SaveFormatVersion)
+	{
+		return false;
+	}
+
+	uint32 NumChunks = 0;
+	if (!ReadVarint(Data, Offset, NumChunks) || NumChunks > static_cast<uint32>(Data.Num()))
+	{
+		return false;
+	}
+
+	TMap<FIntPoint, FChunk> Loaded;
+	int64 LoadedExplored = 0;
+	for (uint32 ChunkIndex = 0; ChunkIndex < NumChunks; ++ChunkIndex)
+	{
+		uint32 RawX = 0;
+		uint32 RawY = 0;
+		if (!ReadVarint(Data, Offset, RawX) || !ReadVarint(Data, Offset, RawY))
+		{
+			return false;
+		}
+		const FIntPoint Key(UnZigZag(RawX), UnZigZag(RawY));
+		if (Loaded.Contains(Key))
+		{
+			return false;
+		}
+		FChunk& Chunk = Loaded.Add(Key);
+
+		uint32 NumRuns = 0;
+		if (!ReadVarint(Data, Offset, NumRuns) || NumRuns > static_cast<uint32>(TilesPerChunk))
+		{
+			return false;
+		}
+
+		// Runs alternate unexplored / explored; whatever they leave uncovered is unexplored.
+		int32 Bit = 0;
+		for (uint32 RunIndex = 0; RunIndex < NumRuns; ++RunIndex)
+		{
+			uint32 RunLength = 0;
+			if (!ReadVarint(Data, Offset, RunLength) || RunLength > static_cast<uint32>(TilesPerChunk - Bit))
+			{
+				return false;
+			}
+			if (RunIndex & 1)
+			{
+				for (int32 i = Bit; i < Bit + static_cast<int32>(RunLength); ++i)
+				{
+					Chunk.Explored[i >> ChunkShift] |= uint64(1) << (i & ChunkMask);
+				}
+				Chunk.NumExplored += RunLength;
+			}
+			Bit += RunLength;
+		}
+		LoadedExplored += Chunk.NumExplored;
+	}
+
+	if (Offset != Data.Num())
+	{
+		return false;
+	}
+
+	Chunks = MoveTemp(Loaded);
+	NumExplored = LoadedExplored;
+	return true;
+}
@@ -0,0 +1,242 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#include "Map/VCMapBlitter.h"
+#include "VoxelMapSubsystem.h"
+#include "Core/VCPerfReport.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Map Blit"), STAT_VCMapBlit, STATGROUP_VoxelCharacter);
+
+static TAutoConsoleVariable<int32> CVarVCMapParallelBlit(
+	TEXT("vc.Map.ParallelBlit"),
+	1,
+	TEXT("Rasterize large map blits in parallel row bands (0 = single-threaded)."),
+	ECVF_Default);
+
+// Rows per ParallelFor task, and the smallest blit worth spreading across workers
+// (minimap strips stay on the calling thread).
+static constexpr int32 BlitRowsPerBand = 32;
+static constexpr int32 BlitParallelMinPixels = 128 * 128;
+
+// ---------------------------------------------------------------------------
+// Sources
+// ---------------------------------------------------------------------------
+
+FVCMapBlitSource FVCMapBlitSource::MakeFill(const FColor& InFill)
+{
+	FVCMapBlitSource Source;
+	Source.Fill = InFill;
+	return Source;
+}
+
+FVCMapBlitSource FVCMapBlitSource::MakeFromTile(const FVoxelMapTile& Tile, EVCMapBlitOrientation Orientation)
+{
+	FVCMapBlitSource Source;
+	const int32 Res = Tile.Resolution;
+	if (Res <= 0 || Tile.PixelData.Num() < Res * Res)
+	{
+		return Source; // malformed tile — solid black rather than reading out of bounds
+	}
+
+	// FColor is BGRA in memory, the same layout as PF_B8G8R8A8, so texels copy as-is.
+	Source.Pixels = Tile.PixelData.GetData();
+	Source.Resolution = Res;
+
+	// PixelData[PY * Res + PX]: PX runs along world X, PY along world Y.
+	if (Orientation == EVCMapBlitOrientation::WorldXRight)
+	{
+		Source.ColStride = 1;
+		Source.RowStride = Res;
+	}
+	else
+	{
+		Source.ColStride = Res;
+		Source.RowStride = 1;
+	}
+	return Source;
+}
+
+// ---------------------------------------------------------------------------
+// Tables
+// ---------------------------------------------------------------------------
+
+int32 FVCMapBlitter::BuildAxis(int32 First, int32 Count, bool bColumnAxis, TArray<FAxisSample>& Out) const
+{
+	// Which world axis this destination axis walks, and in which direction.
+	const bool bWorldX = (View.Orientation == EVCMapBlitOrientation::WorldXRight) == bColumnAxis;
+	const double Sign = (View.Orientation == EVCMapBlitOrientation::NorthUp && !bColumnAxis) ? -1.0 : 1.0;
+	const double GridOrigin = bWorldX ? View.GridWorldOrigin.X : View.GridWorldOrigin.Y;
+	const double TileOrigin = bWorldX ? View.TileGridOrigin.X : View.TileGridOrigin.Y;
+	const double TexelWorldSize = View.TileWorldSize / View.TileResolution;
+
+	Out.SetNumUninitialized(Count);
+	int32 MinTile = MAX_int32;
+	for (int32 i = 0; i < Count; ++i)
+	{
+		const double Local = GridOrigin + Sign * (First + i + 0.5) * View.WorldPerPixel - TileOrigin;
+		const int32 Tile = FMath::FloorToInt(Local / View.TileWorldSize);
+		const double InTile = Local - Tile * View.TileWorldSize;
+
+		Out[i].Tile = Tile;
+		Out[i].Texel = FMath::Clamp(FMath::FloorToInt(InTile / TexelWorldSize), 0, View.TileResolution - 1);
+		MinTile = FMath::Min(MinTile, Tile);
+	}
+
+	for (FAxisSample& Sample : Out)
+	{
+		Sample.Tile -= MinTile;
+	}
+	return Count > 0 ? MinTile : 0;
+}
+
+void FVCMapBlitter::Prepare(const FVCMapBlitView& InView, const FIntPoint& Min, const FIntPoint& Size)
+{
+	View = InView;
+	View.TileResolution = FMath::Max(1, View.TileResolution);
+	View.TileWorldSize = FMath::Max(View.TileWorldSize, UE_KINDA_SMALL_NUMBER);
+	View.WorldPerPixel = FMath::Max(View.WorldPerPixel, UE_KINDA_SMALL_NUMBER);
+
+	FirstColTile = BuildAxis(Min.X, FMath::Max(0, Size.X), true, Cols);
+	FirstRowTile = BuildAxis(Min.Y, FMath::Max(0, Size.Y), false, Rows);
+
+	NumColTiles = 0;
+	for (const FAxisSample& Col : Cols)
+	{
+		NumColTiles = FMath::Max(NumColTiles, Col.Tile + 1);
+	}
+	NumRowTiles = 0;
+	for (const FAxisSample& Row : Rows)
+	{
+		NumRowTiles = FMath::Max(NumRowTiles, Row.Tile + 1);
+	}
+
+	// Group columns by tile; flag spans whose texels advance one at a time (1:1 zoom).
+	Spans.Reset();
+	for (int32 i = 0; i < Cols.Num(); ++i)
+	{
+		if (Spans.Num() == 0 || Spans.Last().Tile != Cols[i].Tile)
+		{
+			FColumnSpan& Span = Spans.AddDefaulted_GetRef();
+			Span.First = i;
+			Span.Tile = Cols[i].Tile;
+			Span.bUnitStep = true;
+		}
+		else if (Cols[i].Texel != Cols[i - 1].Texel + 1)
+		{
+			Spans.Last().bUnitStep = false;
+		}
+		++Spans.Last().Count;
+	}
+
+	Sources.Reset();
+}
+
+void FVCMapBlitter::ResolveTiles(TFunctionRef<FVCMapBlitSource(const FIntPoint& TileCoord)> Resolve)
+{
+	Sources.SetNum(NumColTiles * NumRowTiles);
+	for (int32 RowTile = 0; RowTile < NumRowTiles; ++RowTile)
+	{
+		for (int32 ColTile = 0; ColTile < NumColTiles; ++ColTile)
+		{
+			const int32 ColCoord = FirstColTile + ColTile;
+			const int32 RowCoord = FirstRowTile + RowTile;
+			const FIntPoint TileCoord = View.Orientation == EVCMapBlitOrientation::WorldXRight
+				? FIntPoint(ColCoord, RowCoord)
+				: FIntPoint(RowCoord, ColCoord);
+			Sources[RowTile * NumColTiles + ColTile] = Resolve(TileCoord);
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Blit
+// ---------------------------------------------------------------------------
+
+void FVCMapBlitter::Blit(FColor* Dst, int32 DstPitch) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_VCMapBlit);
+	VC_PERF_SCOPE(VCMap, Blit);
+
+	const int32 NumRows = Rows.Num();
+	const bool bParallel = CVarVCMapParallelBlit.GetValueOnAnyThread() != 0
+		&& Cols.Num() * NumRows >= BlitParallelMinPixels
+		&& NumRows >= BlitRowsPerBand * 2;
+	if (!bParallel)
+	{
+		BlitRows(Dst, DstPitch, 0, NumRows);
+		return;
+	}
+
+	// Bands write disjoint destination rows and only read the tables and the sources
+	// resolved on the game thread, so they need no synchronization.
+	const int32 NumBands = FMath::DivideAndRoundUp(NumRows, BlitRowsPerBand);
+	ParallelFor(NumBands, [this, Dst, DstPitch](int32 Band)
+	{
+		BlitRows(Dst, DstPitch, Band * BlitRowsPerBand, BlitRowsPerBand);
+	});
+}
+
+void FVCMapBlitter::BlitRows(FColor* Dst, int32 DstPitch, int32 FirstRow, int32 NumRows) const
+{
+	if (!Dst || Sources.Num() != NumColTiles * NumRowTiles)
+	{
+		return;
+	}
+
+	const int32 EndRow = FMath::Min(FirstRow + NumRows, Rows.Num());
+	for (int32 R = FMath::Max(0, FirstRow); R < EndRow; ++R)
+	{
+		FColor* DstRow = Dst + static_cast<int64>(R) * DstPitch;
+		const FAxisSample& Row = Rows[R];
+
+		// Zoomed in: consecutive rows often sample the same source row — reuse ours.
+		if (R > FirstRow && Rows[R - 1] == Row)
+		{
+			FMemory::Memcpy(DstRow, DstRow - DstPitch, Cols.Num() * sizeof(FColor));
+			continue;
+		}
+
+		const FVCMapBlitSource* RowSources = Sources.GetData() + Row.Tile * NumColTiles;
+		for (const FColumnSpan& Span : Spans)
+		{
+			BlitSpan(DstRow + Span.First, Span, RowSources[Span.Tile], Row.Texel);
+		}
+	}
+}
+
+void FVCMapBlitter::BlitSpan(FColor* Out, const FColumnSpan& Span, const FVCMapBlitSource& Src, int32 RowTexel) const
+{
+	if (!Src.Pixels)
+	{
+		for (int32 i = 0; i < Span.Count; ++i)
+		{
+			Out[i] = Src.Fill;
+		}
+		return;
+	}
+
+	const FAxisSample* Col = Cols.GetData() + Span.First;
+	if (Src.Resolution == View.TileResolution)
+	{
+		const FColor* SrcRow = Src.Pixels + RowTexel * Src.RowStride;
+		if (Span.bUnitStep && Src.ColStride == 1)
+		{
+			FMemory::Memcpy(Out, SrcRow + Col[0].Texel, Span.Count * sizeof(FColor));
+			return;
+		}
+		for (int32 i = 0; i < Span.Count; ++i)
+		{
+			Out[i] = SrcRow[Col[i].Texel * Src.ColStride];
+		}
+		return;
+	}
+
+	// Tile stored at a different resolution than the tables were built for — rescale texels.
+	const int32 TableRes = View.TileResolution;
+	const FColor* SrcRow = Src.Pixels + (RowTexel * Src.Resolution / TableRes) * Src.RowStride;
+	for (int32 i = 0; i < Span.Count; ++i)
+	{
+		Out[i] = SrcRow[(Col[i].Texel * Src.Resolution / TableRes) * Src.ColStride];
+	}
+}
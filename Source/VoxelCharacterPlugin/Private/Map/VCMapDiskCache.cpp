@@ -0,0 +1,338 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#include "Map/VCMapDiskCache.h"
+#include "VoxelCharacterPlugin.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+// Index file header: magic + format version, then fingerprint / resolution of the page file.
+// Version 2: level-0 pages are stored as drawn (hillshaded), not as the map subsystem's texels.
+static constexpr uint32 MapDiskCacheMagic = 0x50414D56; // "VMAP"
+static constexpr uint32 MapDiskCacheVersion = 2;
+
+FVCMapDiskCache::~FVCMapDiskCache()
+{
+	IoPipe.WaitUntilEmpty();
+	delete PageFile;
+	PageFile = nullptr;
+}
+
+FString FVCMapDiskCache::GetIndexPath() const
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("VoxelMapCache"), FString::Printf(TEXT("%08x.index"), Fingerprint));
+}
+
+FString FVCMapDiskCache::GetPagesPath() const
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("VoxelMapCache"), FString::Printf(TEXT("%08x.pages"), Fingerprint));
+}
+
+// ---------------------------------------------------------------------------
+// Open / Close
+// ---------------------------------------------------------------------------
+
+bool FVCMapDiskCache::Open(uint32 InFingerprint, int32 InResolution, TArray<uint8>& OutBlob)
+{
+	if (IsOpen())
+	{
+		Close({});
+	}
+
+	Fingerprint = InFingerprint;
+	Resolution = FMath::Max(1, InResolution);
+	Pages.Reset();
+	FreePages.Reset();
+	NumPageSlots = 0;
+	bIndexDirty = false;
+	OutBlob.Reset();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(GetIndexPath()));
+
+	// Load the index; anything that does not match this world / resolution starts over.
+	bool bIndexValid = false;
+	TArray<uint8> IndexData;
+	if (FFileHelper::LoadFileToArray(IndexData, *GetIndexPath(), FILEREAD_Silent))
+	{
+		FMemoryReader Reader(IndexData);
+		uint32 Magic = 0, Version = 0, FileFingerprint = 0;
+		int32 FileResolution = 0, NumEntries = 0;
+		Reader << Magic << Version << FileFingerprint << FileResolution << NumPageSlots << NumEntries;
+		bIndexValid = !Reader.IsError() && Magic == MapDiskCacheMagic && Version == MapDiskCacheVersion
+			&& FileFingerprint == Fingerprint && FileResolution == Resolution && NumPageSlots >= 0 && NumEntries >= 0;
+
+		TBitArray<> UsedSlots(false, bIndexValid ? NumPageSlots : 0);
+		for (int32 i = 0; bIndexValid && i < NumEntries; ++i)
+		{
+			FPageKey Key;
+			FPageEntry Entry;
+			Reader << Key.Level << Key.Coord.X << Key.Coord.Y << Entry.PageIndex << Entry.Crc;
+			bIndexValid = !Reader.IsError() && Entry.PageIndex >= 0 && Entry.PageIndex < NumPageSlots && !UsedSlots[Entry.PageIndex];
+			if (bIndexValid)
+			{
+				UsedSlots[Entry.PageIndex] = true;
+				Pages.Add(Key, Entry);
+			}
+		}
+		if (bIndexValid)
+		{
+			Reader << OutBlob;
+			bIndexValid = !Reader.IsError();
+		}
+		for (int32 Slot = 0; bIndexValid && Slot < NumPageSlots; ++Slot)
+		{
+			if (!UsedSlots[Slot])
+			{
+				FreePages.Add(Slot);
+			}
+		}
+	}
+
+	if (!bIndexValid)
+	{
+		Pages.Reset();
+		FreePages.Reset();
+		NumPageSlots = 0;
+		OutBlob.Reset();
+		PlatformFile.DeleteFile(*GetPagesPath());
+	}
+
+	// Append mode keeps existing pages (no truncate); every access seeks to its page explicitly.
+	PageFile = PlatformFile.OpenWrite(*GetPagesPath(), /*bAppend*/ true, /*bAllowRead*/ true);
+	if (!PageFile)
+	{
+		UE_LOG(LogVoxelCharacter, Warning, TEXT("MapDiskCache: cannot open %s"), *GetPagesPath());
+		Pages.Reset();
+		FreePages.Reset();
+		NumPageSlots = 0;
+		return false;
+	}
+
+	UE_LOG(LogVoxelCharacter, Log, TEXT("MapDiskCache: opened %08x (%d pages, %d free)"), Fingerprint, Pages.Num(), FreePages.Num());
+	return true;
+}
+
+void FVCMapDiskCache::Close(TConstArrayView<uint8> Blob)
+{
+	if (!IsOpen())
+	{
+		return;
+	}
+
+	// Nothing else touches the file once the pipe is empty; pending reads are simply dropped.
+	IoPipe.WaitUntilEmpty();
+	PageFile->Flush();
+	WriteIndexFile(GetIndexPath(), SerializeIndex(Blob));
+
+	delete PageFile;
+	PageFile = nullptr;
+	Pages.Reset();
+	FreePages.Reset();
+	NumPageSlots = 0;
+	bIndexDirty = false;
+	PendingReads.Reset();
+	Completions.Empty();
+}
+
+void FVCMapDiskCache::Flush(TConstArrayView<uint8> Blob)
+{
+	if (!IsOpen())
+	{
+		return;
+	}
+
+	// The snapshot is taken now; the pipe runs it after the page writes it refers to.
+	IFileHandle* File = PageFile;
+	IoPipe.Launch(UE_SOURCE_LOCATION, [File, IndexPath = GetIndexPath(), IndexData = SerializeIndex(Blob)]()
+	{
+		File->Flush();
+		WriteIndexFile(IndexPath, IndexData);
+	});
+	bIndexDirty = false;
+}
+
+TArray<uint8> FVCMapDiskCache::SerializeIndex(TConstArrayView<uint8> Blob) const
+{
+	TArray<uint8> IndexData;
+	FMemoryWriter Writer(IndexData);
+	uint32 Magic = MapDiskCacheMagic;
+	uint32 Version = MapDiskCacheVersion;
+	uint32 FileFingerprint = Fingerprint;
+	int32 FileResolution = Resolution;
+	int32 FileNumPageSlots = NumPageSlots;
+	int32 NumEntries = Pages.Num();
+	Writer << Magic << Version << FileFingerprint << FileResolution << FileNumPageSlots << NumEntries;
+	for (const TPair<FPageKey, FPageEntry>& Pair : Pages)
+	{
+		FPageKey Key = Pair.Key;
+		FPageEntry Entry = Pair.Value;
+		Writer << Key.Level << Key.Coord.X << Key.Coord.Y << Entry.PageIndex << Entry.Crc;
+	}
+	TArray<uint8> BlobCopy(Blob.GetData(), Blob.Num());
+	Writer << BlobCopy;
+	return IndexData;
+}
+
+void FVCMapDiskCache::WriteIndexFile(const FString& IndexPath, const TArray<uint8>& IndexData)
+{
+	const FString TempPath = IndexPath + TEXT(".tmp");
+	if (FFileHelper::SaveArrayToFile(IndexData, *TempPath))
+	{
+		IFileManager::Get().Move(*IndexPath, *TempPath, /*bReplace*/ true);
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Pages
+// ---------------------------------------------------------------------------
+
+bool FVCMapDiskCache::HasPage(int32 Level, const FIntPoint& Coord) const
+{
+	return Pages.Contains(FPageKey{ Level, Coord });
+}
+
+bool FVCMapDiskCache::IsCurrent(const FPageKey& Key, const FPageEntry& Entry) const
+{
+	const FPageEntry* Current = Pages.Find(Key);
+	return Current && Current->PageIndex == Entry.PageIndex && Current->Crc == Entry.Crc;
+}
+
+bool FVCMapDiskCache::IsReadPending(int32 Level, const FIntPoint& Coord) const
+{
+	return PendingReads.Contains(FPageKey{ Level, Coord });
+}
+
+bool FVCMapDiskCache::RequestPage(int32 Level, const FIntPoint& Coord)
+{
+	const FPageKey Key{ Level, Coord };
+	const FPageEntry* Entry = IsOpen() ? Pages.Find(Key) : nullptr;
+	if (!Entry)
+	{
+		return false;
+	}
+	if (PendingReads.Contains(Key))
+	{
+		return true;
+	}
+	PendingReads.Add(Key);
+
+	IFileHandle* File = PageFile;
+	IoPipe.Launch(UE_SOURCE_LOCATION, [this, File, Key, Entry = *Entry, PageBytes = GetPageBytes()]()
+	{
+		FCompletion Completion;
+		Completion.Key = Key;
+		Completion.Entry = Entry;
+		Completion.bRead = true;
+		Completion.Pixels.SetNumUninitialized(static_cast<int32>(PageBytes / sizeof(FColor)));
+		Completion.bSucceeded = File->Seek(Entry.PageIndex * PageBytes)
+			&& File->Read(reinterpret_cast<uint8*>(Completion.Pixels.GetData()), PageBytes)
+			&& FCrc::MemCrc32(Completion.Pixels.GetData(), PageBytes) == Entry.Crc;
+		Completions.Enqueue(MoveTemp(Completion));
+	});
+	return true;
+}
+
+void FVCMapDiskCache::PollReads(TArray<FLoadedPage>& Out)
+{
+	FCompletion Completion;
+	while (Completions.Dequeue(Completion))
+	{
+		if (Completion.bRead)
+		{
+			PendingReads.Remove(Completion.Key);
+		}
+
+		// Rewritten or removed while in flight — the result describes a page that no longer exists.
+		if (!IsCurrent(Completion.Key, Completion.Entry))
+		{
+			continue;
+		}
+
+		if (!Completion.bSucceeded)
+		{
+			// Torn or truncated page, or a failed write — drop it; the owner rebuilds from live data.
+			if (!Completion.bRead)
+			{
+				UE_LOG(LogVoxelCharacter, Warning, TEXT("MapDiskCache: page write failed (level %d, %d,%d)"),
+					Completion.Key.Level, Completion.Key.Coord.X, Completion.Key.Coord.Y);
+			}
+			RemovePage(Completion.Key.Level, Completion.Key.Coord);
+			continue;
+		}
+
+		if (Completion.bRead)
+		{
+			FLoadedPage& Page = Out.AddDefaulted_GetRef();
+			Page.Level = Completion.Key.Level;
+			Page.Coord = Completion.Key.Coord;
+			Page.Pixels = MoveTemp(Completion.Pixels);
+		}
+	}
+}
+
+bool FVCMapDiskCache::WritePage(int32 Level, const FIntPoint& Coord, TConstArrayView<FColor> Pixels)
+{
+	const int64 PageBytes = GetPageBytes();
+	if (!IsOpen() || Pixels.Num() * static_cast<int64>(sizeof(FColor)) != PageBytes)
+	{
+		return false;
+	}
+
+	const FPageKey Key{ Level, Coord };
+	const uint32 Crc = FCrc::MemCrc32(Pixels.GetData(), PageBytes);
+	FPageEntry& Entry = Pages.FindOrAdd(Key);
+	if (Entry.PageIndex != INDEX_NONE && Entry.Crc == Crc)
+	{
+		return false; // unchanged (e.g. a tile regenerated identically after a restart)
+	}
+
+	if (Entry.PageIndex == INDEX_NONE)
+	{
+		Entry.PageIndex = FreePages.Num() > 0 ? FreePages.Pop() : NumPageSlots++;
+	}
+	Entry.Crc = Crc;
+	bIndexDirty = true;
+
+	IFileHandle* File = PageFile;
+	IoPipe.Launch(UE_SOURCE_LOCATION, [this, File, Key, Entry = Entry, Data = TArray<FColor>(Pixels.GetData(), Pixels.Num()), PageBytes]()
+	{
+		if (!File->Seek(Entry.PageIndex * PageBytes) || !File->Write(reinterpret_cast<const uint8*>(Data.GetData()), PageBytes))
+		{
+			FCompletion Completion;
+			Completion.Key = Key;
+			Completion.Entry = Entry;
+			Completions.Enqueue(MoveTemp(Completion));
+		}
+	});
+	return true;
+}
+
+void FVCMapDiskCache::RemovePage(int32 Level, const FIntPoint& Coord)
+{
+	FPageEntry Entry;
+	if (Pages.RemoveAndCopyValue(FPageKey{ Level, Coord }, Entry))
+	{
+		if (Entry.PageIndex != INDEX_NONE)
+		{
+			FreePages.Add(Entry.PageIndex);
+		}
+		bIndexDirty = true;
+	}
+}
+
+void FVCMapDiskCache::RemovePagesFromLevel(int32 MinLevel)
+{
+	for (auto It = Pages.CreateIterator(); It; ++It)
+	{
+		if (It.Key().Level >= MinLevel)
+		{
+			FreePages.Add(It.Value().PageIndex);
+			It.RemoveCurrent();
+			bIndexDirty = true;
+		}
+	}
+}
@@ -0,0 +1,63 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#include "Map/VCMapMarkerAsyncGather.h"
+
+FVCMapMarkerAsyncGather::FVCMapMarkerAsyncGather()
+	: Job(MakeShared<FJob, ESPMode::ThreadSafe>())
+{
+}
+
+bool FVCMapMarkerAsyncGather::Poll()
+{
+	if (!bRunning || !Task.IsCompleted())
+	{
+		return false;
+	}
+	bRunning = false;
+
+	// The task is done with the job — swap buffers; the old front becomes the next back buffer.
+	Swap(Front, Job->Markers);
+	FrontArea = Job->Area;
+	FrontRevision = Job->Revision;
+	bHasFront = true;
+	Job->Sources.Reset();
+	return true;
+}
+
+void FVCMapMarkerAsyncGather::Request(const UVCMapMarkerRegistry& Registry, const FBox2D& Area)
+{
+	if (bRunning)
+	{
+		return; // the next Poll() publishes it and the caller's next refresh asks again
+	}
+
+	const uint32 Revision = Registry.GetRevision();
+	if (bHasFront && FrontRevision == Revision && FrontArea == Area)
+	{
+		return;
+	}
+
+	Registry.GetWorkerSafeSources(Job->Sources);
+	if (Job->Sources.Num() == 0)
+	{
+		Front.Reset();
+		FrontArea = Area;
+		FrontRevision = Revision;
+		bHasFront = true;
+		return;
+	}
+
+	Job->Area = Area;
+	Job->Revision = Revision;
+	Job->Markers.Reset();
+
+	TSharedRef<FJob, ESPMode::ThreadSafe> SharedJob = Job;
+	Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [SharedJob]()
+	{
+		for (const FVCWorkerMarkerSourceRef& Source : SharedJob->Sources)
+		{
+			(*Source)(SharedJob->Area, SharedJob->Markers);
+		}
+	});
+	bRunning = true;
+}
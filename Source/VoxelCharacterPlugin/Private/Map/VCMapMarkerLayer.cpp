@@ -0,0 +1,152 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#include "Map/VCMapMarkerLayer.h"
+#include "Widgets/SLeafWidget.h"
+#include "Rendering/DrawElements.h"
+#include "Styling/CoreStyle.h"
+#include "Fonts/FontMeasure.h"
+#include "Framework/Application/SlateApplication.h"
+
+// ---------------------------------------------------------------------------
+// SVCMapMarkerLayer
+// ---------------------------------------------------------------------------
+
+/** Slate side of UVCMapMarkerLayer: paints the owner's arrays; owns nothing but the font. */
+class SVCMapMarkerLayer : public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SVCMapMarkerLayer) {}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs)
+	{
+		SetVisibility(EVisibility::HitTestInvisible);
+		SetCanTick(false);
+	}
+
+	/** The arrays to paint (owned by the UMG widget; cleared when it releases its Slate resources). */
+	void SetSource(const TArray<FVCMapMarkerDraw>* InMarkers, const TArray<FVCMapMarkerPolyline>* InPolylines)
+	{
+		Markers = InMarkers;
+		Polylines = InPolylines;
+		Invalidate(EInvalidateWidgetReason::Paint);
+	}
+
+	void SetLabelFontSize(int32 InSize)
+	{
+		LabelFont = FCoreStyle::GetDefaultFontStyle("Regular", FMath::Max(1, InSize));
+		Invalidate(EInvalidateWidgetReason::Paint);
+	}
+
+	void MarkersChanged()
+	{
+		Invalidate(EInvalidateWidgetReason::Paint);
+	}
+
+	virtual FVector2D ComputeDesiredSize(float) const override
+	{
+		return FVector2D::ZeroVector;
+	}
+
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+		FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override
+	{
+		const bool bHasMarkers = Markers && Markers->Num() > 0;
+		const bool bHasPolylines = Polylines && Polylines->Num() > 0;
+		if (!bHasMarkers && !bHasPolylines)
+		{
+			return LayerId;
+		}
+
+		const FVector2f Center = FVector2f(AllottedGeometry.GetLocalSize()) * 0.5f;
+		const FLinearColor Tint = InWidgetStyle.GetColorAndOpacityTint();
+
+		// Lines, dots and labels each on their own layer, so the renderer batches each kind.
+		const int32 LineLayer = LayerId;
+		const int32 DotLayer = LayerId + 1;
+		const int32 LabelLayer = LayerId + 2;
+
+		if (bHasPolylines)
+		{
+			// Vertices are centre-relative: paint them in a geometry translated to the centre.
+			const FPaintGeometry LineGeometry = AllottedGeometry.ToPaintGeometry(
+				FVector2f(AllottedGeometry.GetLocalSize()), FSlateLayoutTransform(Center));
+			for (const FVCMapMarkerPolyline& Line : *Polylines)
+			{
+				if (Line.Points.Num() >= 2)
+				{
+					FSlateDrawElement::MakeLines(OutDrawElements, LineLayer, LineGeometry, Line.Points,
+						ESlateDrawEffect::None, Line.Color * Tint, true, Line.Thickness);
+				}
+			}
+		}
+		if (!bHasMarkers)
+		{
+			return LineLayer;
+		}
+
+		const FSlateBrush* DotBrush = FCoreStyle::Get().GetBrush("WhiteBrush");
+		const float LabelHalfHeight = 0.5f * FSlateApplication::Get().GetRenderer()->GetFontMeasureService()->GetMaxCharacterHeight(LabelFont);
+		for (const FVCMapMarkerDraw& Marker : *Markers)
+		{
+			const FVector2f DotSize(Marker.Size, Marker.Size);
+			const FVector2f DotCenter = Center + FVector2f(Marker.Offset);
+			FSlateDrawElement::MakeBox(OutDrawElements, DotLayer,
+				AllottedGeometry.ToPaintGeometry(DotSize, FSlateLayoutTransform(DotCenter - DotSize * 0.5f)),
+				DotBrush, ESlateDrawEffect::None, Marker.Color * Tint);
+
+			if (!Marker.Label.IsEmpty())
+			{
+				// Left edge just right of the dot, vertically centred on it.
+				const FVector2f LabelPos(DotCenter.X + 0.75f * Marker.Size + 2.0f, DotCenter.Y - LabelHalfHeight);
+				FSlateDrawElement::MakeText(OutDrawElements, LabelLayer,
+					AllottedGeometry.ToPaintGeometry(FVector2f(1.0f, 1.0f), FSlateLayoutTransform(LabelPos)),
+					Marker.Label, LabelFont, ESlateDrawEffect::None, Marker.Color * Tint);
+			}
+		}
+		return LabelLayer;
+	}
+
+private:
+	const TArray<FVCMapMarkerDraw>* Markers = nullptr;
+	const TArray<FVCMapMarkerPolyline>* Polylines = nullptr;
+	FSlateFontInfo LabelFont = FCoreStyle::GetDefaultFontStyle("Regular", 9);
+};
+
+// ---------------------------------------------------------------------------
+// UVCMapMarkerLayer
+// ---------------------------------------------------------------------------
+
+TSharedRef<SWidget> UVCMapMarkerLayer::RebuildWidget()
+{
+	MyMarkerLayer = SNew(SVCMapMarkerLayer);
+	MyMarkerLayer->SetSource(&Markers, &Polylines);
+	return MyMarkerLayer.ToSharedRef();
+}
+
+void UVCMapMarkerLayer::SynchronizeProperties()
+{
+	Super::SynchronizeProperties();
+	if (MyMarkerLayer.IsValid())
+	{
+		MyMarkerLayer->SetLabelFontSize(LabelFontSize);
+	}
+}
+
+void UVCMapMarkerLayer::ReleaseSlateResources(bool bReleaseChildren)
+{
+	Super::ReleaseSlateResources(bReleaseChildren);
+	if (MyMarkerLayer.IsValid())
+	{
+		MyMarkerLayer->SetSource(nullptr, nullptr);
+	}
+	MyMarkerLayer.Reset();
+}
+
+void UVCMapMarkerLayer::CommitMarkers()
+{
+	if (MyMarkerLayer.IsValid())
+	{
+		MyMarkerLayer->MarkersChanged();
+	}
+}
@@ -0,0 +1,388 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#include "Map/VCMapMarkerRegistry.h"
+#include "Algo/Sort.h"
+
+void UVCMapMarkerRegistry::Deinitialize()
+{
+	Slots.Empty();
+	FreeSlots.Empty();
+	Cells.Empty();
+	NumMarkers = 0;
+	WorkerSources.Empty();
+
+	Super::Deinitialize();
+}
+
+// ---------------------------------------------------------------------------
+// Persistent Markers
+// ---------------------------------------------------------------------------
+
+FIntPoint UVCMapMarkerRegistry::CellOf(const FVector2D& WorldPosition)
+{
+	return FIntPoint(
+		FMath::FloorToInt(WorldPosition.X / MarkerCellSize),
+		FMath::FloorToInt(WorldPosition.Y / MarkerCellSize));
+}
+
+UVCMapMarkerRegistry::FSlot* UVCMapMarkerRegistry::FindSlot(const FVCMapMarkerHandle& Handle)
+{
+	if (!Slots.IsValidIndex(Handle.Index))
+	{
+		return nullptr;
+	}
+	FSlot& Slot = Slots[Handle.Index];
+	return (Slot.bUsed && Slot.Serial == Handle.Serial) ? &Slot : nullptr;
+}
+
+const UVCMapMarkerRegistry::FSlot* UVCMapMarkerRegistry::FindSlot(const FVCMapMarkerHandle& Handle) const
+{
+	if (!Slots.IsValidIndex(Handle.Index))
+	{
+		return nullptr;
+	}
+	const FSlot& Slot = Slots[Handle.Index];
+	return (Slot.bUsed && Slot.Serial == Handle.Serial) ? &Slot : nullptr;
+}
+
+void UVCMapMarkerRegistry::LinkToCell(int32 Index, const FIntPoint& Cell)
+{
+	FSlot& Slot = Slots[Index];
+	Slot.Cell = Cell;
+	++Revision; // every add / update / move relinks
+
+	FCell& Target = Cells.FindOrAdd(Cell);
+	Target.Markers.Add(Index);
+	Target.PositionSum += Slot.Marker.WorldPosition;
+	if (Target.BestIndex == INDEX_NONE || Slot.Marker.Priority > Slots[Target.BestIndex].Marker.Priority)
+	{
+		Target.BestIndex = Index;
+	}
+}
+
+void UVCMapMarkerRegistry::UnlinkFromCell(int32 Index, const FIntPoint& Cell)
+{
+	++Revision;
+	if (FCell* Source = Cells.Find(Cell))
+	{
+		Source->Markers.RemoveSingleSwap(Index);
+		if (Source->Markers.Num() == 0)
+		{
+			Cells.Remove(Cell);
+			return;
+		}
+		Source->PositionSum -= Slots[Index].Marker.WorldPosition;
+		if (Source->BestIndex == Index)
+		{
+			RefreshCellBest(*Source);
+		}
+	}
+}
+
+void UVCMapMarkerRegistry::RefreshCellBest(FCell& Cell) const
+{
+	Cell.BestIndex = INDEX_NONE;
+	for (const int32 Index : Cell.Markers)
+	{
+		if (Cell.BestIndex == INDEX_NONE || Slots[Index].Marker.Priority > Slots[Cell.BestIndex].Marker.Priority)
+		{
+			Cell.BestIndex = Index;
+		}
+	}
+}
+
+FVCMapMarkerHandle UVCMapMarkerRegistry::AddMarker(const FVCMapMarker& Marker)
+{
+	const int32 Index = FreeSlots.Num() > 0 ? FreeSlots.Pop() : Slots.AddDefaulted();
+
+	FSlot& Slot = Slots[Index];
+	Slot.Marker = Marker;
+	Slot.Serial = NextSerial++;
+	Slot.bUsed = true;
+	LinkToCell(Index, CellOf(Marker.WorldPosition));
+	++NumMarkers;
+
+	FVCMapMarkerHandle Handle;
+	Handle.Index = Index;
+	Handle.Serial = Slot.Serial;
+	return Handle;
+}
+
+bool UVCMapMarkerRegistry::UpdateMarker(const FVCMapMarkerHandle& Handle, const FVCMapMarker& Marker)
+{
+	FSlot* Slot = FindSlot(Handle);
+	if (!Slot)
+	{
+		return false;
+	}
+
+	// Unlink with the old position / priority so the cell aggregates stay exact, then relink.
+	UnlinkFromCell(Handle.Index, Slot->Cell);
+	Slot->Marker = Marker;
+	LinkToCell(Handle.Index, CellOf(Marker.WorldPosition));
+	return true;
+}
+
+bool UVCMapMarkerRegistry::SetMarkerPosition(const FVCMapMarkerHandle& Handle, const FVector2D& WorldPosition)
+{
+	FSlot* Slot = FindSlot(Handle);
+	if (!Slot)
+	{
+		return false;
+	}
+
+	UnlinkFromCell(Handle.Index, Slot->Cell);
+	Slot->Marker.WorldPosition = WorldPosition;
+	LinkToCell(Handle.Index, CellOf(WorldPosition));
+	return true;
+}
+
+bool UVCMapMarkerRegistry::RemoveMarker(const FVCMapMarkerHandle& Handle)
+{
+	FSlot* Slot = FindSlot(Handle);
+	if (!Slot)
+	{
+		return false;
+	}
+
+	UnlinkFromCell(Handle.Index, Slot->Cell);
+	Slot->bUsed = false;
+	Slot->Marker = FVCMapMarker();
+	FreeSlots.Add(Handle.Index);
+	--NumMarkers;
+	return true;
+}
+
+const FVCMapMarker* UVCMapMarkerRegistry::FindMarker(const FVCMapMarkerHandle& Handle) const
+{
+	const FSlot* Slot = FindSlot(Handle);
+	return Slot ? &Slot->Marker : nullptr;
+}
+
+// ---------------------------------------------------------------------------
+// Worker-Safe Sources
+// ---------------------------------------------------------------------------
+
+int32 UVCMapMarkerRegistry::AddWorkerSafeSource(FVCWorkerMarkerSource Source)
+{
+	const int32 SourceId = NextWorkerSourceId++;
+	WorkerSources.Emplace(SourceId, MakeShared<const FVCWorkerMarkerSource, ESPMode::ThreadSafe>(MoveTemp(Source)));
+	++Revision;
+	return SourceId;
+}
+
+void UVCMapMarkerRegistry::RemoveWorkerSafeSource(int32 SourceId)
+{
+	if (WorkerSources.RemoveAll([SourceId](const TPair<int32, FVCWorkerMarkerSourceRef>& Entry) { return Entry.Key == SourceId; }) > 0)
+	{
+		++Revision;
+	}
+}
+
+void UVCMapMarkerRegistry::GetWorkerSafeSources(TArray<FVCWorkerMarkerSourceRef>& OutSources) const
+{
+	OutSources.Reset(WorkerSources.Num());
+	for (const TPair<int32, FVCWorkerMarkerSourceRef>& Entry : WorkerSources)
+	{
+		OutSources.Add(Entry.Value);
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Query
+// ---------------------------------------------------------------------------
+
+void UVCMapMarkerRegistry::ForEachCellInArea(const FBox2D& WorldArea, TFunctionRef<void(const FIntPoint& CellCoord, const FCell& Cell)> Func) const
+{
+	if (Cells.Num() == 0 || !WorldArea.bIsValid)
+	{
+		return;
+	}
+
+	const FIntPoint MinCell = CellOf(WorldArea.Min);
+	const FIntPoint MaxCell = CellOf(WorldArea.Max);
+	const int64 NumQueryCells = int64(MaxCell.X - MinCell.X + 1) * int64(MaxCell.Y - MinCell.Y + 1);
+
+	// Small areas (minimap) probe their cells; huge ones (zoomed-out world map) walk the
+	// occupied cells instead, so the cost never exceeds the number of occupied cells.
+	if (NumQueryCells <= Cells.Num())
+	{
+		for (int32 CY = MinCell.Y; CY <= MaxCell.Y; ++CY)
+		{
+			for (int32 CX = MinCell.X; CX <= MaxCell.X; ++CX)
+			{
+				const FIntPoint CellCoord(CX, CY);
+				if (const FCell* Cell = Cells.Find(CellCoord))
+				{
+					Func(CellCoord, *Cell);
+				}
+			}
+		}
+	}
+	else
+	{
+		for (const TPair<FIntPoint, FCell>& Pair : Cells)
+		{
+			if (Pair.Key.X >= MinCell.X && Pair.Key.X <= MaxCell.X && Pair.Key.Y >= MinCell.Y && Pair.Key.Y <= MaxCell.Y)
+			{
+				Func(Pair.Key, Pair.Value);
+			}
+		}
+	}
+}
+
+void UVCMapMarkerRegistry::GatherMarkers(const FBox2D& WorldArea, TArray<FVCMapMarker>& OutMarkers) const
+{
+	ForEachCellInArea(WorldArea, [this, &WorldArea, &OutMarkers](const FIntPoint&, const FCell& Cell)
+	{
+		for (const int32 Index : Cell.Markers)
+		{
+			const FVCMapMarker& Marker = Slots[Index].Marker;
+			if (WorldArea.IsInside(Marker.WorldPosition))
+			{
+				OutMarkers.Add(Marker);
+			}
+		}
+	});
+
+	// Dynamic sources rebuild theirs for the area every query.
+	OnGatherMarkers.Broadcast(WorldArea, OutMarkers);
+}
+
+void UVCMapMarkerRegistry::GatherMarkerClusters(const FBox2D& WorldArea, double ClusterWorldSize, TArray<FVCMapMarkerCluster>& OutClusters,
+	TConstArrayView<FVCMapMarker> ExtraMarkers) const
+{
+	OutClusters.Reset();
+	if (!WorldArea.bIsValid)
+	{
+		return;
+	}
+	ClusterWorldSize = FMath::Max(ClusterWorldSize, 1.0);
+
+	// Cluster cells are anchored to the world grid, so clusters stay put while panning.
+	// Positions accumulate as sums and become means at the end.
+	TMap<FIntPoint, int32, TInlineSetAllocator<256>> ClusterIndices;
+	auto AddToCluster = [&](const FVector2D& Position, const FVector2D& PositionSum, int32 Count, const FVCMapMarker& Best)
+	{
+		const FIntPoint Key(
+			FMath::FloorToInt(Position.X / ClusterWorldSize),
+			FMath::FloorToInt(Position.Y / ClusterWorldSize));
+		if (const int32* Existing = ClusterIndices.Find(Key))
+		{
+			FVCMapMarkerCluster& Cluster = OutClusters[*Existing];
+			Cluster.WorldPosition += PositionSum;
+			Cluster.Count += Count;
+			if (Best.Priority > Cluster.Representative.Priority)
+			{
+				Cluster.Representative = Best;
+			}
+			return;
+		}
+		ClusterIndices.Add(Key, OutClusters.Num());
+		FVCMapMarkerCluster& Cluster = OutClusters.AddDefaulted_GetRef();
+		Cluster.WorldPosition = PositionSum;
+		Cluster.Count = Count;
+		Cluster.Representative = Best;
+	};
+
+	// Cluster cells at least as large as index cells take each index cell whole: cells fully
+	// inside the area contribute their aggregates; only cells on the area's rim check members.
+	const bool bUseAggregates = ClusterWorldSize >= MarkerCellSize;
+	ForEachCellInArea(WorldArea, [&](const FIntPoint& CellCoord, const FCell& Cell)
+	{
+		const FBox2D CellBox(FVector2D(CellCoord) * MarkerCellSize, FVector2D(CellCoord + FIntPoint(1, 1)) * MarkerCellSize);
+		if (bUseAggregates && WorldArea.IsInside(CellBox))
+		{
+			const int32 Count = Cell.Markers.Num();
+			AddToCluster(Cell.PositionSum / Count, Cell.PositionSum, Count, Slots[Cell.BestIndex].Marker);
+			return;
+		}
+		for (const int32 Index : Cell.Markers)
+		{
+			const FVCMapMarker& Marker = Slots[Index].Marker;
+			if (WorldArea.IsInside(Marker.WorldPosition))
+			{
+				AddToCluster(Marker.WorldPosition, Marker.WorldPosition, 1, Marker);
+			}
+		}
+	});
+
+	DynamicScratch.Reset();
+	OnGatherMarkers.Broadcast(WorldArea, DynamicScratch);
+	for (const FVCMapMarker& Marker : DynamicScratch)
+	{
+		AddToCluster(Marker.WorldPosition, Marker.WorldPosition, 1, Marker);
+	}
+	for (const FVCMapMarker& Marker : ExtraMarkers)
+	{
+		AddToCluster(Marker.WorldPosition, Marker.WorldPosition, 1, Marker);
+	}
+
+	for (FVCMapMarkerCluster& Cluster : OutClusters)
+	{
+		Cluster.WorldPosition /= Cluster.Count;
+	}
+}
+
+namespace VCMapMarkerRegistry
+{
+	/** Bounded top-K selection: Items[0, Count) is kept as a min-heap on priority whose root is the
+	 *  weakest item kept so far; the survivors are then sorted highest first. */
+	template <typename ItemType, typename PriorityFunc>
+	int32 SelectHighestPriority(TArrayView<ItemType> Items, int32 MaxCount, PriorityFunc Priority)
+	{
+		const int32 Count = FMath::Min(MaxCount, Items.Num());
+		if (Count <= 0)
+		{
+			return 0;
+		}
+
+		auto SiftDown = [&Items, &Priority, Count](int32 Index)
+		{
+			for (;;)
+			{
+				const int32 Left = Index * 2 + 1;
+				if (Left >= Count)
+				{
+					return;
+				}
+				const int32 Right = Left + 1;
+				const int32 Child = (Right < Count && Priority(Items[Right]) < Priority(Items[Left])) ? Right : Left;
+				if (Priority(Items[Index]) <= Priority(Items[Child]))
+				{
+					return;
+				}
+				Swap(Items[Index], Items[Child]);
+				Index = Child;
+			}
+		};
+
+		for (int32 i = Count / 2 - 1; i >= 0; --i)
+		{
+			SiftDown(i);
+		}
+		for (int32 i = Count; i < Items.Num(); ++i)
+		{
+			if (Priority(Items[i]) > Priority(Items[0]))
+			{
+				Swap(Items[0], Items[i]);
+				SiftDown(0);
+			}
+		}
+
+		Algo::Sort(Items.Left(Count), [&Priority](const ItemType& A, const ItemType& B) { return Priority(A) > Priority(B); });
+		return Count;
+	}
+}
+
+int32 UVCMapMarkerRegistry::SelectHighestPriority(TArrayView<FVCMapMarker> Markers, int32 MaxCount)
+{
+	return VCMapMarkerRegistry::SelectHighestPriority(Markers, MaxCount,
+		[](const FVCMapMarker& Marker) { return Marker.Priority; });
+}
+
+int32 UVCMapMarkerRegistry::SelectHighestPriority(TArrayView<FVCMapMarkerCluster> Clusters, int32 MaxCount)
+{
+	return VCMapMarkerRegistry::SelectHighestPriority(Clusters, MaxCount,
+		[](const FVCMapMarkerCluster& Cluster) { return Cluster.Representative.Priority; });
+}
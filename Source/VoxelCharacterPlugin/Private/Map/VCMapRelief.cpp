@@ -0,0 +1,81 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#include "Map/VCMapRelief.h"
+#include "Math/VectorRegister.h"
+
+void FVCMapRelief::ApplyHillshade(TConstArrayView<float> Heights, int32 Res, float TexelWorldSize,
+	const FVCMapReliefSettings& Settings, TArrayView<FColor> Pixels)
+{
+	const int32 Stride = Res + 2;
+	if (Res <= 0 || TexelWorldSize <= 0.f || Heights.Num() < Stride * Stride || Pixels.Num() < Res * Res)
+	{
+		return;
+	}
+
+	const float Azimuth = FMath::DegreesToRadians(Settings.SunAzimuthDegrees);
+	const float Elevation = FMath::DegreesToRadians(FMath::Clamp(Settings.SunElevationDegrees, 1.0f, 90.0f));
+	const float LightX = FMath::Cos(Elevation) * FMath::Cos(Azimuth);
+	const float LightY = FMath::Cos(Elevation) * FMath::Sin(Azimuth);
+	const float LightZ = FMath::Sin(Elevation);
+	const float Strength = FMath::Clamp(Settings.Strength, 0.0f, 1.0f);
+
+	// Normal = (-dZ/dX, -dZ/dY, 1) / len; shade = N.L. Factor = lerp(1, shade / LightZ, Strength),
+	// so flat ground (shade == LightZ) keeps its colour: Factor = Scale * shade + Bias.
+	const float SlopeScale = Settings.ZFactor / (2.0f * TexelWorldSize);
+	const float Scale = Strength / LightZ;
+	const float Bias = 1.0f - Strength;
+
+	const VectorRegister4Float VSlopeScale = VectorSetFloat1(SlopeScale);
+	const VectorRegister4Float VLightX = VectorSetFloat1(LightX);
+	const VectorRegister4Float VLightY = VectorSetFloat1(LightY);
+	const VectorRegister4Float VLightZ = VectorSetFloat1(LightZ);
+	const VectorRegister4Float VScale = VectorSetFloat1(Scale);
+	const VectorRegister4Float VBias = VectorSetFloat1(Bias);
+	const VectorRegister4Float VOne = VectorSetFloat1(1.0f);
+	const VectorRegister4Float VMaxFactor = VectorSetFloat1(2.0f);
+
+	auto ShadeScalar = [&](const float* Up, const float* Mid, const float* Down) -> float
+	{
+		const float NX = (Mid[-1] - Mid[1]) * SlopeScale;
+		const float NY = (Up[0] - Down[0]) * SlopeScale;
+		const float Shade = (NX * LightX + NY * LightY + LightZ) * FMath::InvSqrt(NX * NX + NY * NY + 1.0f);
+		return FMath::Clamp(Scale * Shade + Bias, 0.0f, 2.0f);
+	};
+
+	TArray<float, TInlineAllocator<256>> Factors;
+	Factors.SetNumUninitialized(Res);
+
+	for (int32 PY = 0; PY < Res; ++PY)
+	{
+		// Texel (PX, PY) sits at apron column PX + 1 of apron row PY + 1.
+		const float* Up = Heights.GetData() + PY * Stride + 1;
+		const float* Mid = Up + Stride;
+		const float* Down = Mid + Stride;
+
+		int32 PX = 0;
+		for (; PX + 4 <= Res; PX += 4)
+		{
+			const VectorRegister4Float NX = VectorMultiply(VectorSubtract(VectorLoad(Mid + PX - 1), VectorLoad(Mid + PX + 1)), VSlopeScale);
+			const VectorRegister4Float NY = VectorMultiply(VectorSubtract(VectorLoad(Up + PX), VectorLoad(Down + PX)), VSlopeScale);
+			const VectorRegister4Float LenSq = VectorMultiplyAdd(NX, NX, VectorMultiplyAdd(NY, NY, VOne));
+			const VectorRegister4Float Dot = VectorMultiplyAdd(NX, VLightX, VectorMultiplyAdd(NY, VLightY, VLightZ));
+			const VectorRegister4Float Shade = VectorMultiply(Dot, VectorReciprocalSqrt(LenSq));
+			const VectorRegister4Float Factor = VectorMin(VectorMax(VectorMultiplyAdd(Shade, VScale, VBias), VectorZeroFloat()), VMaxFactor);
+			VectorStore(Factor, Factors.GetData() + PX);
+		}
+		for (; PX < Res; ++PX)
+		{
+			Factors[PX] = ShadeScalar(Up + PX, Mid + PX, Down + PX);
+		}
+
+		FColor* Row = Pixels.GetData() + PY * Res;
+		for (PX = 0; PX < Res; ++PX)
+		{
+			const float F = Factors[PX];
+			FColor& C = Row[PX];
+			C.R = static_cast<uint8>(FMath::Min(C.R * F + 0.5f, 255.0f));
+			C.G = static_cast<uint8>(FMath::Min(C.G * F + 0.5f, 255.0f));
+			C.B = static_cast<uint8>(FMath::Min(C.B * F + 0.5f, 255.0f));
+		}
+	}
+}
@@ -0,0 +1,97 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#include "Map/VCMapTextureUploader.h"
+#include "Engine/Texture2D.h"
+
+void FVCMapTextureUploader::Reset(int32 InWidth, int32 InHeight)
+{
+	Width = FMath::Max(0, InWidth);
+	Height = FMath::Max(0, InHeight);
+	Pixels.SetNumUninitialized(Width * Height);
+	MarkAllDirty();
+}
+
+void FVCMapTextureUploader::MarkDirty(const FIntRect& Rect)
+{
+	const FIntRect Clipped(
+		FMath::Max(Rect.Min.X, 0), FMath::Max(Rect.Min.Y, 0),
+		FMath::Min(Rect.Max.X, Width), FMath::Min(Rect.Max.Y, Height));
+	if (Clipped.Min.X >= Clipped.Max.X || Clipped.Min.Y >= Clipped.Max.Y)
+	{
+		return;
+	}
+
+	// Drop rects the new one swallows; skip it if an existing one already covers it.
+	for (int32 i = DirtyRects.Num() - 1; i >= 0; --i)
+	{
+		const FIntRect& Existing = DirtyRects[i];
+		if (Existing.Contains(Clipped.Min) && Clipped.Max.X <= Existing.Max.X && Clipped.Max.Y <= Existing.Max.Y)
+		{
+			return;
+		}
+		if (Clipped.Contains(Existing.Min) && Existing.Max.X <= Clipped.Max.X && Existing.Max.Y <= Clipped.Max.Y)
+		{
+			DirtyRects.RemoveAtSwap(i);
+		}
+	}
+	DirtyRects.Add(Clipped);
+}
+
+void FVCMapTextureUploader::MarkAllDirty()
+{
+	DirtyRects.Reset();
+	if (Width > 0 && Height > 0)
+	{
+		DirtyRects.Add(FIntRect(0, 0, Width, Height));
+	}
+}
+
+void FVCMapTextureUploader::Flush(UTexture2D* Texture)
+{
+	if (DirtyRects.Num() == 0)
+	{
+		return;
+	}
+
+	if (!Texture || Texture->GetSizeX() != Width || Texture->GetSizeY() != Height)
+	{
+		DirtyRects.Reset();
+		return;
+	}
+
+	if (DirtyRects.Num() > MaxRegionsPerFlush)
+	{
+		FIntRect Bounds = DirtyRects[0];
+		for (const FIntRect& Rect : DirtyRects)
+		{
+			Bounds.Union(Rect);
+		}
+		DirtyRects.Reset();
+		DirtyRects.Add(Bounds);
+	}
+
+	for (const FIntRect& Rect : DirtyRects)
+	{
+		const int32 RectWidth = Rect.Width();
+		const int32 RectHeight = Rect.Height();
+
+		// Tightly packed copy of the rect — released by the render thread once uploaded,
+		// so the staging buffer stays free for the next refresh.
+		const int32 RowBytes = RectWidth * sizeof(FColor);
+		uint8* Data = static_cast<uint8*>(FMemory::Malloc(static_cast<SIZE_T>(RowBytes) * RectHeight));
+		for (int32 Y = 0; Y < RectHeight; ++Y)
+		{
+			FMemory::Memcpy(Data + Y * RowBytes, Pixels.GetData() + (Rect.Min.Y + Y) * Width + Rect.Min.X, RowBytes);
+		}
+
+		FUpdateTextureRegion2D* Region = new FUpdateTextureRegion2D(Rect.Min.X, Rect.Min.Y, 0, 0, RectWidth, RectHeight);
+		Texture->UpdateTextureRegions(0, 1, Region, RowBytes, sizeof(FColor), Data,
+			[](uint8* SrcData, const FUpdateTextureRegion2D* Regions)
+			{
+				FMemory::Free(SrcData);
+				delete Regions;
+			});
+	}
+
+	DirtyRects.Reset();
+}
@@ -0,0 +1,1142 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#include "Map/VCMapTileCache.h"
+#include "Movement/VCVoxelNavigationHelper.h"
+#include "VoxelMapSubsystem.h"
+#include "VoxelChunkManager.h"
+#include "VoxelWorldConfiguration.h"
+#include "VoxelCharacterPlugin.h"
+#include "Core/VCPerfReport.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarVCMapDiskCache(
+	TEXT("vc.Map.DiskCache"),
+	1,
+	TEXT("Persist converted map tiles, super-tiles and exploration under Saved/VoxelMapCache (read when the cache opens)."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVCMapRelief(
+	TEXT("vc.Map.Relief"),
+	1,
+	TEXT("Hillshade map tiles from generated terrain heights (read when a world's tile cache is created)."),
+	ECVF_Default);
+
+/** Frames between attempts to open the disk store while the voxel world is still initializing. */
+static constexpr uint64 DiskCacheRetryFrames = 30;
+
+const FColor UVCMapTileCache::UnexploredColor(10, 10, 10, 255);
+const FColor UVCMapTileCache::UnloadedColor(25, 25, 25, 255);
+
+UVCMapTileCache* UVCMapTileCache::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UVCMapTileCache>() : nullptr;
+}
+
+// ---------------------------------------------------------------------------
+// Lifecycle
+// ---------------------------------------------------------------------------
+
+void UVCMapTileCache::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	Collection.InitializeDependency<UVoxelMapSubsystem>();
+	ResolveMapSubsystem();
+	bReliefEnabled = CVarVCMapRelief.GetValueOnGameThread() != 0;
+}
+
+void UVCMapTileCache::Deinitialize()
+{
+	if (MapSubsystem.IsValid() && TileReadyHandle.IsValid())
+	{
+		MapSubsystem->OnMapTileReady.Remove(TileReadyHandle);
+	}
+	TileReadyHandle.Reset();
+	if (DiskCache.IsOpen())
+	{
+		// Every stored page agrees with the live fog (pages over tiles explored since were dropped).
+		TArray<uint8> Exploration;
+		ExploredTiles.Save(Exploration);
+		DiskCache.Close(Exploration);
+	}
+	bDiskCacheResolved = false;
+	Entries.Empty();
+	Versions.Empty();
+	ExploredTiles.Reset();
+	bExplorationSynced = false;
+	ExplorationWatch.Empty();
+	WatchedPlayerTiles.Empty();
+	ExplorationProbes.Empty();
+
+	// Relief tasks sample the chunk manager — it must not be collected while one still runs.
+	for (TPair<FIntPoint, FReliefJob>& Job : ReliefJobs)
+	{
+		Job.Value.Task.Wait();
+	}
+	for (UE::Tasks::TTask<TArray<FColor>>& Task : SupersededReliefTasks)
+	{
+		Task.Wait();
+	}
+	ReliefJobs.Empty();
+	SupersededReliefTasks.Empty();
+	for (TMap<FIntPoint, FSuperEntry>& Level : SuperTiles)
+	{
+		Level.Empty();
+	}
+	NumSuperTiles = 0;
+	SuperTileRequests.Empty();
+	RequestedSuperTiles.Empty();
+	SuperTileBuildStack.Empty();
+
+	Super::Deinitialize();
+}
+
+void UVCMapTileCache::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TimeSinceExplorationSync += DeltaTime;
+	if (TimeSinceExplorationSync >= ExplorationSyncInterval)
+	{
+		TimeSinceExplorationSync = 0.0f;
+		SyncExploration();
+	}
+
+	if (ReliefJobs.Num() > 0 || SupersededReliefTasks.Num() > 0)
+	{
+		PollRelief();
+	}
+
+	if (DiskCache.IsOpen())
+	{
+		PollDiskReads();
+
+		TimeSinceDiskFlush += DeltaTime;
+		if (TimeSinceDiskFlush >= DiskIndexFlushInterval)
+		{
+			TimeSinceDiskFlush = 0.0f;
+			FlushDiskIndex();
+		}
+	}
+
+	if (SuperTileRequests.Num() > 0 || SuperTileBuildStack.Num() > 0)
+	{
+		VC_PERF_SCOPE(VCMap, SuperTileBuild);
+		BuildSuperTiles(FPlatformTime::Seconds() + FMath::Max(SuperTileBuildBudgetMs, 0.0f) * 0.001);
+	}
+}
+
+TStatId UVCMapTileCache::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UVCMapTileCache, STATGROUP_Tickables);
+}
+
+UVoxelMapSubsystem* UVCMapTileCache::ResolveMapSubsystem()
+{
+	if (!MapSubsystem.IsValid())
+	{
+		TileReadyHandle.Reset();
+		if (const UWorld* World = GetWorld())
+		{
+			MapSubsystem = World->GetSubsystem<UVoxelMapSubsystem>();
+		}
+	}
+
+	if (MapSubsystem.IsValid() && !TileReadyHandle.IsValid())
+	{
+		TileReadyHandle = MapSubsystem->OnMapTileReady.AddUObject(this, &UVCMapTileCache::HandleMapTileReady);
+	}
+	return MapSubsystem.Get();
+}
+
+void UVCMapTileCache::HandleMapTileReady(FIntPoint TileCoord)
+{
+	VC_PERF_SCOPE(VCMap, TileReady);
+
+	// Tiles arriving means the voxel world is up.
+	FVCMapDiskCache* Disk = ResolveDiskCache();
+
+	// Entries compare against this lazily — a tile nobody draws is never reconverted.
+	++Versions.FindOrAdd(TileCoord);
+
+	// Explored tiles far from every local player (another player's, a streamed save) show up here.
+	if (!ExploredTiles.IsExplored(TileCoord))
+	{
+		ExplorationProbes.Add(TileCoord);
+	}
+
+	// Super-tiles above it keep drawing until rebuilt. Unexplored tiles are baked in as fog, so
+	// only explored ones need the pyramid rebuilt — now, so it is warm before the map opens.
+	for (int32 Level = 1; Level <= MaxLodLevel; ++Level)
+	{
+		if (FSuperEntry* Super = SuperTiles[Level - 1].Find(FIntPoint(TileCoord.X >> Level, TileCoord.Y >> Level)))
+		{
+			Super->bStale = true;
+		}
+	}
+	if (ExploredTiles.IsExplored(TileCoord))
+	{
+		RequestAncestorSuperTiles(TileCoord);
+	}
+
+	// On disk, only drop them if the texels changed (checked against the stored page's CRC);
+	// fog changes are handled by HandleTileExplored. Regenerating a known world keeps its pyramid.
+	// Pages hold the texels as drawn, so a shaded tile is stored once its hillshade lands.
+	if (Disk)
+	{
+		const FVoxelMapTile* Source = MapSubsystem.IsValid() ? MapSubsystem->GetTile(TileCoord) : nullptr;
+		if (Source && Source->Resolution == Disk->GetResolution() && Source->PixelData.Num() >= Source->Resolution * Source->Resolution
+			&& !QueueRelief(TileCoord, *Source, GetTileVersion(TileCoord)))
+		{
+			StoreTilePage(TileCoord, TConstArrayView<FColor>(Source->PixelData.GetData(), Source->Resolution * Source->Resolution));
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Disk Cache
+// ---------------------------------------------------------------------------
+
+/**
+ * Identity of the generated world the disk store belongs to. The voxel world exposes no seed,
+ * so hash what determines the map instead: level, voxel/chunk layout, map tiling, and the
+ * generated surface height at a few fixed points (which changes with the seed / generator).
+ */
+static uint32 ComputeWorldFingerprint(const UWorld* World, const UVoxelChunkManager* ChunkMgr, const UVoxelMapSubsystem* Map,
+	const FVCMapReliefSettings* Relief)
+{
+	const UVoxelWorldConfiguration* Config = ChunkMgr->GetConfiguration();
+	uint32 Hash = GetTypeHash(UWorld::RemovePIEPrefix(World->GetOutermost()->GetName()));
+	if (Config)
+	{
+		Hash = HashCombine(Hash, GetTypeHash(Config->VoxelSize));
+		Hash = HashCombine(Hash, GetTypeHash(Config->ChunkSize));
+		Hash = HashCombine(Hash, GetTypeHash(Config->WorldOrigin));
+	}
+	Hash = HashCombine(Hash, GetTypeHash(Map->GetTileWorldSize()));
+	Hash = HashCombine(Hash, GetTypeHash(Map->GetTileResolution()));
+
+	// Pages bake in the shading of their tiles.
+	if (Relief)
+	{
+		Hash = HashCombine(Hash, GetTypeHash(Relief->SunAzimuthDegrees));
+		Hash = HashCombine(Hash, GetTypeHash(Relief->SunElevationDegrees));
+		Hash = HashCombine(Hash, GetTypeHash(Relief->ZFactor));
+		Hash = HashCombine(Hash, GetTypeHash(Relief->Strength));
+	}
+
+	static const FVector2D SamplePoints[] = {
+		{ 0.0, 0.0 }, { 12345.0, -6789.0 }, { -50000.0, 25000.0 }, { 100000.0, 100000.0 },
+		{ -250000.0, -125000.0 }, { 500000.0, -400000.0 }, { -1000000.0, 750000.0 }, { 2000000.0, 1500000.0 } };
+	for (const FVector2D& Point : SamplePoints)
+	{
+		const float Height = ChunkMgr->GetGeneratedSurfaceHeight(static_cast<float>(Point.X), static_cast<float>(Point.Y));
+		Hash = HashCombine(Hash, GetTypeHash(FMath::RoundToInt(Height)));
+	}
+	return Hash;
+}
+
+FVCMapDiskCache* UVCMapTileCache::ResolveDiskCache()
+{
+	if (DiskCache.IsOpen())
+	{
+		return &DiskCache;
+	}
+	if (bDiskCacheResolved || GFrameCounter < NextDiskCacheAttemptFrame || CVarVCMapDiskCache.GetValueOnGameThread() == 0)
+	{
+		return nullptr;
+	}
+	NextDiskCacheAttemptFrame = GFrameCounter + DiskCacheRetryFrames;
+
+	const UWorld* World = GetWorld();
+	UVoxelMapSubsystem* Subsystem = ResolveMapSubsystem();
+	const UVoxelChunkManager* ChunkMgr = World ? FVCVoxelNavigationHelper::FindChunkManager(World) : nullptr;
+	if (!Subsystem || !ChunkMgr || Subsystem->GetTileResolution() <= 0)
+	{
+		return nullptr; // world still starting up — try again in a few frames
+	}
+
+	// One attempt per world: a failed open (read-only Saved/, ...) just runs without the store.
+	bDiskCacheResolved = true;
+	TArray<uint8> Exploration;
+	if (!DiskCache.Open(ComputeWorldFingerprint(World, ChunkMgr, Subsystem, bReliefEnabled ? &ReliefSettings : nullptr), Subsystem->GetTileResolution(), Exploration))
+	{
+		return nullptr;
+	}
+
+	// The stored super-tiles baked in the fog persisted with them. Live fog comes from the map
+	// subsystem alone — a tile explored in only one of the two has stale pages above it.
+	SyncExploration();
+	FVCExploredTileSet Baked;
+	if (Exploration.Num() > 0 && !Baked.Load(Exploration))
+	{
+		UE_LOG(LogVoxelCharacter, Warning, TEXT("MapTileCache: stored fog unreadable, dropping stored super-tiles"));
+		DiskCache.RemovePagesFromLevel(1);
+	}
+	else
+	{
+		ExploredTiles.ForEachExplored([this, &Baked](const FIntPoint& Tile)
+		{
+			if (!Baked.IsExplored(Tile))
+			{
+				RemoveDiskSuperTiles(Tile);
+			}
+		});
+		Baked.ForEachExplored([this](const FIntPoint& Tile)
+		{
+			if (!ExploredTiles.IsExplored(Tile))
+			{
+				RemoveDiskSuperTiles(Tile);
+			}
+		});
+	}
+	FlushedExploredCount = INDEX_NONE;
+	TimeSinceDiskFlush = 0.0f;
+	return &DiskCache;
+}
+
+/**
+ * (Res + 2)^2 heights at texel centres over a one-texel apron (-1 .. Res), for FVCMapRelief. The
+ * analytic surface is sampled every Step texels and bilinearly filled in — shading needs slope,
+ * not detail. Runs on the relief task.
+ */
+static void SampleReliefHeights(const UVoxelChunkManager& ChunkMgr, const FVector2D& TileOrigin, float TexelWorldSize, int32 Res, int32 Step,
+	TArray<float>& OutHeights)
+{
+	const int32 Apron = Res + 2;
+	const int32 NumSamples = (Apron - 1 + Step - 1) / Step + 1; // >= 2, since Step <= Res
+
+	TArray<float> Samples;
+	Samples.SetNumUninitialized(NumSamples * NumSamples);
+	for (int32 SY = 0; SY < NumSamples; ++SY)
+	{
+		const float WorldY = TileOrigin.Y + (SY * Step - 0.5f) * TexelWorldSize;
+		for (int32 SX = 0; SX < NumSamples; ++SX)
+		{
+			const float WorldX = TileOrigin.X + (SX * Step - 0.5f) * TexelWorldSize;
+			Samples[SY * NumSamples + SX] = ChunkMgr.GetGeneratedSurfaceHeight(WorldX, WorldY);
+		}
+	}
+
+	OutHeights.SetNumUninitialized(Apron * Apron);
+	const float InvStep = 1.0f / Step;
+	for (int32 AY = 0; AY < Apron; ++AY)
+	{
+		const int32 SY0 = FMath::Min(AY / Step, NumSamples - 2);
+		const float TY = FMath::Clamp((AY - SY0 * Step) * InvStep, 0.0f, 1.0f);
+		const int32 SY1 = FMath::Min(SY0 + 1, NumSamples - 1);
+		for (int32 AX = 0; AX < Apron; ++AX)
+		{
+			const int32 SX0 = FMath::Min(AX / Step, NumSamples - 2);
+			const float TX = FMath::Clamp((AX - SX0 * Step) * InvStep, 0.0f, 1.0f);
+			const int32 SX1 = FMath::Min(SX0 + 1, NumSamples - 1);
+			const float Top = FMath::Lerp(Samples[SY0 * NumSamples + SX0], Samples[SY0 * NumSamples + SX1], TX);
+			const float Bottom = FMath::Lerp(Samples[SY1 * NumSamples + SX0], Samples[SY1 * NumSamples + SX1], TX);
+			OutHeights[AY * Apron + AX] = FMath::Lerp(Top, Bottom, TY);
+		}
+	}
+}
+
+bool UVCMapTileCache::QueueRelief(const FIntPoint& TileCoord, const FVoxelMapTile& Source, uint32 Version)
+{
+	UVoxelMapSubsystem* Subsystem = MapSubsystem.Get();
+	const UVoxelChunkManager* ChunkMgr = bReliefEnabled ? FVCVoxelNavigationHelper::FindChunkManager(GetWorld()) : nullptr;
+	const int32 Res = Source.Resolution;
+	if (!Subsystem || !ChunkMgr || Res <= 0 || Source.PixelData.Num() < Res * Res || Subsystem->GetTileWorldSize() <= 0.f)
+	{
+		return false;
+	}
+
+	FReliefJob* Existing = ReliefJobs.Find(TileCoord);
+	if (Existing && Existing->Version == Version)
+	{
+		return true;
+	}
+	if (Existing && !Existing->Task.IsCompleted())
+	{
+		SupersededReliefTasks.Add(Existing->Task); // finishes unread, but Deinitialize still waits for it
+	}
+
+	TArray<FColor> Pixels(Source.PixelData.GetData(), Res * Res);
+	const float TexelWorldSize = Subsystem->GetTileWorldSize() / Res;
+	const FVector2D TileOrigin(Subsystem->TileCoordToWorld(TileCoord));
+	const int32 Step = FMath::Clamp(ReliefSampleStep, 1, Res);
+
+	// The game thread only copies the texels; the surface is sampled and shaded on the task.
+	FReliefJob& Job = ReliefJobs.FindOrAdd(TileCoord);
+	Job.Version = Version;
+	Job.Task = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[ChunkMgr, Pixels = MoveTemp(Pixels), TileOrigin, TexelWorldSize, Res, Step, Settings = ReliefSettings]() mutable
+		{
+			TArray<float> Heights;
+			SampleReliefHeights(*ChunkMgr, TileOrigin, TexelWorldSize, Res, Step, Heights);
+			FVCMapRelief::ApplyHillshade(Heights, Res, TexelWorldSize, Settings, Pixels);
+			return MoveTemp(Pixels);
+		});
+	return true;
+}
+
+void UVCMapTileCache::PollRelief()
+{
+	SupersededReliefTasks.RemoveAllSwap([](const UE::Tasks::TTask<TArray<FColor>>& Task) { return Task.IsCompleted(); });
+
+	for (auto It = ReliefJobs.CreateIterator(); It; ++It)
+	{
+		if (!It->Value.Task.IsCompleted())
+		{
+			continue;
+		}
+		const FIntPoint TileCoord = It->Key;
+		const uint32 Version = It->Value.Version;
+		TArray<FColor> Pixels = MoveTemp(It->Value.Task.GetResult());
+		It.RemoveCurrent();
+		if (Version != GetTileVersion(TileCoord))
+		{
+			continue; // the tile changed again and could not be shaded
+		}
+
+		if (DiskCache.IsOpen() && Pixels.Num() == DiskCache.GetResolution() * DiskCache.GetResolution())
+		{
+			StoreTilePage(TileCoord, Pixels);
+		}
+
+		// Tiles nobody has drawn are only stored; a later lookup converts (and shades) them again.
+		FEntry* Entry = Entries.Find(TileCoord);
+		if (Entry && Entry->Tile.Pixels.Num() == Pixels.Num())
+		{
+			if (Entry->Tile.Version != Version)
+			{
+				Entry->Tile.Version = Version;
+				++NumConversions;
+			}
+			Entry->Tile.Pixels = MoveTemp(Pixels);
+			Entry->Tile.PixelsNorthUp.Reset();
+			OnRegionUpdated.Broadcast(0, TileCoord);
+		}
+	}
+}
+
+void UVCMapTileCache::StoreTilePage(const FIntPoint& TileCoord, TConstArrayView<FColor> Pixels)
+{
+	if (DiskCache.WritePage(0, TileCoord, Pixels))
+	{
+		RemoveDiskSuperTiles(TileCoord);
+	}
+}
+
+void UVCMapTileCache::RemoveDiskSuperTiles(const FIntPoint& TileCoord)
+{
+	for (int32 Level = 1; Level <= MaxLodLevel; ++Level)
+	{
+		DiskCache.RemovePage(Level, FIntPoint(TileCoord.X >> Level, TileCoord.Y >> Level));
+	}
+}
+
+void UVCMapTileCache::PollDiskReads()
+{
+	TArray<FVCMapDiskCache::FLoadedPage> Loaded;
+	DiskCache.PollReads(Loaded);
+	for (FVCMapDiskCache::FLoadedPage& Page : Loaded)
+	{
+		if (Page.Level == 0)
+		{
+			// The map subsystem has the tile again — its live data wins on the next lookup.
+			if (MapSubsystem.IsValid() && MapSubsystem->GetTile(Page.Coord))
+			{
+				continue;
+			}
+			FEntry& Entry = Entries.FindOrAdd(Page.Coord);
+			Entry.LastUsedFrame = GFrameCounter;
+			Entry.Tile.Resolution = DiskCache.GetResolution();
+			Entry.Tile.Version = GetTileVersion(Page.Coord);
+			Entry.Tile.Pixels = MoveTemp(Page.Pixels);
+			Entry.Tile.PixelsNorthUp.Reset();
+			if (Entries.Num() > MaxCachedTiles)
+			{
+				EvictLeastRecentlyUsed();
+			}
+		}
+		else
+		{
+			const FSuperEntry* Existing = SuperTiles[Page.Level - 1].Find(Page.Coord);
+			if (Existing && !Existing->bStale)
+			{
+				continue; // built from its children meanwhile
+			}
+			FSuperEntry& Super = AddSuperTile(Page.Level, Page.Coord);
+			Super.Tile.Resolution = DiskCache.GetResolution();
+			Super.Tile.Pixels = MoveTemp(Page.Pixels);
+		}
+		OnRegionUpdated.Broadcast(Page.Level, Page.Coord);
+	}
+}
+
+void UVCMapTileCache::FlushDiskIndex()
+{
+	if (!DiskCache.IsIndexDirty() && ExploredTiles.GetNumExplored() == FlushedExploredCount)
+	{
+		return;
+	}
+	TArray<uint8> Exploration;
+	ExploredTiles.Save(Exploration);
+	DiskCache.Flush(Exploration);
+	FlushedExploredCount = ExploredTiles.GetNumExplored();
+}
+
+uint32 UVCMapTileCache::GetTileVersion(const FIntPoint& TileCoord) const
+{
+	const uint32* Version = Versions.Find(TileCoord);
+	return Version ? *Version : 0;
+}
+
+// ---------------------------------------------------------------------------
+// Exploration
+// ---------------------------------------------------------------------------
+
+bool UVCMapTileCache::IsTileExplored(const FIntPoint& TileCoord)
+{
+	if (!bExplorationSynced)
+	{
+		SyncExploration();
+	}
+	return ExploredTiles.IsExplored(TileCoord);
+}
+
+bool UVCMapTileCache::IsAnyTileExplored(const FIntRect& TileRect)
+{
+	if (!bExplorationSynced)
+	{
+		SyncExploration();
+	}
+	return ExploredTiles.AnyExplored(TileRect);
+}
+
+void UVCMapTileCache::SyncExploration()
+{
+	UVoxelMapSubsystem* Subsystem = ResolveMapSubsystem();
+	if (!Subsystem)
+	{
+		return;
+	}
+	bExplorationSynced = true;
+
+	// Exploration grows around players, so only candidates are asked about: tiles reported ready
+	// since the last sync and unexplored tiles near a local player. A sync costs a few hundred
+	// lookups at most, however much of the world is explored.
+	UpdateExplorationWatch(*Subsystem);
+
+	for (const FIntPoint& Tile : ExplorationProbes)
+	{
+		if (Subsystem->IsTileExplored(Tile) && ExploredTiles.SetExplored(Tile))
+		{
+			HandleTileExplored(Tile);
+		}
+	}
+	ExplorationProbes.Reset();
+
+	for (auto It = ExplorationWatch.CreateIterator(); It; ++It)
+	{
+		if (Subsystem->IsTileExplored(*It))
+		{
+			if (ExploredTiles.SetExplored(*It))
+			{
+				HandleTileExplored(*It);
+			}
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UVCMapTileCache::UpdateExplorationWatch(const UVoxelMapSubsystem& Subsystem)
+{
+	const UWorld* World = GetWorld();
+	const double TileWorldSize = Subsystem.GetTileWorldSize();
+	if (!World || TileWorldSize <= 0.0)
+	{
+		return;
+	}
+
+	const FVector2D GridOrigin(Subsystem.TileCoordToWorld(FIntPoint::ZeroValue));
+	TArray<FIntPoint> PlayerTiles;
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		const APawn* Pawn = PC && PC->IsLocalController() ? PC->GetPawn() : nullptr;
+		if (Pawn)
+		{
+			const FVector Location = Pawn->GetActorLocation();
+			PlayerTiles.Add(FIntPoint(
+				FMath::FloorToInt((Location.X - GridOrigin.X) / TileWorldSize),
+				FMath::FloorToInt((Location.Y - GridOrigin.Y) / TileWorldSize)));
+		}
+	}
+	if (PlayerTiles == WatchedPlayerTiles)
+	{
+		return; // the watch only shrinks (as tiles get explored) until a player changes tile
+	}
+	WatchedPlayerTiles = MoveTemp(PlayerTiles);
+
+	const int32 Reach = FMath::Max(ExplorationWatchRadius, 0);
+	ExplorationWatch.Reset();
+	for (const FIntPoint& Center : WatchedPlayerTiles)
+	{
+		for (int32 DY = -Reach; DY <= Reach; ++DY)
+		{
+			for (int32 DX = -Reach; DX <= Reach; ++DX)
+			{
+				const FIntPoint Tile(Center.X + DX, Center.Y + DY);
+				if (DX * DX + DY * DY <= Reach * Reach && !ExploredTiles.IsExplored(Tile))
+				{
+					ExplorationWatch.Add(Tile);
+				}
+			}
+		}
+	}
+}
+
+void UVCMapTileCache::HandleTileExplored(const FIntPoint& TileCoord)
+{
+	// Super-tiles above it baked in fog here: rebuild them (they keep drawing meanwhile), and
+	// drop their disk pages so a later session does not read the old fog back.
+	for (int32 Level = 1; Level <= MaxLodLevel; ++Level)
+	{
+		if (FSuperEntry* Super = SuperTiles[Level - 1].Find(FIntPoint(TileCoord.X >> Level, TileCoord.Y >> Level)))
+		{
+			Super->bStale = true;
+		}
+	}
+	if (DiskCache.IsOpen())
+	{
+		RemoveDiskSuperTiles(TileCoord);
+	}
+	RequestAncestorSuperTiles(TileCoord);
+
+	// Level-0 fog is composited at lookup — views drawing the tile just redraw it.
+	OnRegionUpdated.Broadcast(0, TileCoord);
+}
+
+void UVCMapTileCache::SaveExploration(TArray<uint8>& OutData) const
+{
+	ExploredTiles.Save(OutData);
+}
+
+bool UVCMapTileCache::LoadExploration(TConstArrayView<uint8> Data)
+{
+	FVCExploredTileSet Loaded;
+	if (!Loaded.Load(Data))
+	{
+		UE_LOG(LogVoxelCharacter, Warning, TEXT("MapTileCache: ignoring malformed exploration data (%d bytes)"), Data.Num());
+		return false;
+	}
+
+	Loaded.ForEachExplored([this](const FIntPoint& Tile)
+	{
+		if (ExploredTiles.SetExplored(Tile))
+		{
+			HandleTileExplored(Tile);
+		}
+	});
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+// Lookup
+// ---------------------------------------------------------------------------
+
+const FVCCachedMapTile* UVCMapTileCache::FindOrBuild(const FIntPoint& TileCoord)
+{
+	return FindOrBuildMutable(TileCoord);
+}
+
+FVCCachedMapTile* UVCMapTileCache::FindOrBuildMutable(const FIntPoint& TileCoord)
+{
+	const uint32 Version = GetTileVersion(TileCoord);
+
+	if (FEntry* Existing = Entries.Find(TileCoord))
+	{
+		if (Existing->Tile.Version == Version)
+		{
+			Existing->LastUsedFrame = GFrameCounter;
+			return &Existing->Tile;
+		}
+	}
+
+	UVoxelMapSubsystem* Subsystem = ResolveMapSubsystem();
+	FVCMapDiskCache* Disk = DiskCache.IsOpen() ? &DiskCache : nullptr;
+	const FVoxelMapTile* Source = Subsystem ? Subsystem->GetTile(TileCoord) : nullptr;
+	const int32 Res = Source ? Source->Resolution : 0;
+	if (!Source || Res <= 0 || Source->PixelData.Num() < Res * Res)
+	{
+		// Not (or no longer) held by the map subsystem — the page from an earlier session is read
+		// on the store's worker and lands in PollDiskReads(), which announces it.
+		if (Disk)
+		{
+			Disk->RequestPage(0, TileCoord);
+		}
+		Entries.Remove(TileCoord);
+		return nullptr;
+	}
+
+	FEntry& Entry = Entries.FindOrAdd(TileCoord);
+	Entry.LastUsedFrame = GFrameCounter;
+	++NumConversions;
+
+	// Shaded off the game thread; until PollRelief() swaps the result in, a tile that was already
+	// drawn keeps its previous texels rather than flashing flat.
+	const bool bShading = QueueRelief(TileCoord, *Source, Version);
+	if (!bShading || Entry.Tile.Resolution != Res || Entry.Tile.Pixels.Num() != Res * Res)
+	{
+		// FColor is BGRA in memory — the textures' PF_B8G8R8A8 layout — so this is a straight copy.
+		Entry.Tile.Pixels.SetNumUninitialized(Res * Res);
+		FMemory::Memcpy(Entry.Tile.Pixels.GetData(), Source->PixelData.GetData(), Res * Res * sizeof(FColor));
+		Entry.Tile.PixelsNorthUp.Reset();
+	}
+	Entry.Tile.Resolution = Res;
+	Entry.Tile.Version = Version;
+
+	// Tiles that were ready before this cache bound never report OnMapTileReady — store them here
+	// (shaded ones when their hillshade lands).
+	if (Disk && Res == Disk->GetResolution() && !bShading)
+	{
+		StoreTilePage(TileCoord, Entry.Tile.Pixels);
+	}
+
+	if (Entries.Num() > MaxCachedTiles)
+	{
+		EvictLeastRecentlyUsed();
+	}
+
+	// Eviction never touches entries used this frame and removal does not move elements.
+	return &Entry.Tile;
+}
+
+FVCMapBlitSource UVCMapTileCache::MakeBlitSource(const FIntPoint& TileCoord, EVCMapBlitOrientation Orientation, const FColor& MissingFill)
+{
+	FVCCachedMapTile* Cached = FindOrBuildMutable(TileCoord);
+	return Cached ? MakeSourceFromCached(*Cached, Orientation, MissingFill) : FVCMapBlitSource::MakeFill(MissingFill);
+}
+
+FVCMapBlitSource UVCMapTileCache::MakeSourceFromCached(FVCCachedMapTile& Cached, EVCMapBlitOrientation Orientation, const FColor& Fill)
+{
+	FVCMapBlitSource Source;
+	Source.Resolution = Cached.Resolution;
+	Source.Fill = Fill;
+
+	if (Orientation == EVCMapBlitOrientation::WorldXRight)
+	{
+		Source.Pixels = Cached.Pixels.GetData();
+		Source.ColStride = 1;
+		Source.RowStride = Cached.Resolution;
+		return Source;
+	}
+
+	// North-up rows walk world Y at fixed world X — transpose once so they are contiguous.
+	const int32 Res = Cached.Resolution;
+	if (Cached.PixelsNorthUp.Num() != Res * Res)
+	{
+		Cached.PixelsNorthUp.SetNumUninitialized(Res * Res);
+		for (int32 PY = 0; PY < Res; ++PY)
+		{
+			const FColor* SrcRow = Cached.Pixels.GetData() + PY * Res;
+			for (int32 PX = 0; PX < Res; ++PX)
+			{
+				Cached.PixelsNorthUp[PX * Res + PY] = SrcRow[PX];
+			}
+		}
+	}
+
+	Source.Pixels = Cached.PixelsNorthUp.GetData();
+	Source.ColStride = 1;
+	Source.RowStride = Res;
+	return Source;
+}
+
+// ---------------------------------------------------------------------------
+// Level of Detail
+// ---------------------------------------------------------------------------
+
+int32 UVCMapTileCache::SelectLodLevel(double WorldPerPixel) const
+{
+	const UVoxelMapSubsystem* Subsystem = MapSubsystem.Get();
+	if (!Subsystem || Subsystem->GetTileWorldSize() <= 0.f)
+	{
+		return 0;
+	}
+
+	// Level L halves the texel density L times; pick the deepest level that still has at
+	// least one texel per output pixel.
+	const double TexelsPerPixel = WorldPerPixel * Subsystem->GetTileResolution() / Subsystem->GetTileWorldSize();
+	if (TexelsPerPixel < 2.0)
+	{
+		return 0;
+	}
+	return FMath::Min(static_cast<int32>(FMath::FloorLog2(static_cast<uint32>(FMath::Min(TexelsPerPixel, 1.0e9)))), MaxLodLevel);
+}
+
+FVCMapBlitSource UVCMapTileCache::MakeFogLodBlitSource(int32 Level, const FIntPoint& Coord, EVCMapBlitOrientation Orientation)
+{
+	if (Level <= 0)
+	{
+		if (!IsTileExplored(Coord))
+		{
+			return FVCMapBlitSource::MakeFill(UnexploredColor);
+		}
+		return MakeBlitSource(Coord, Orientation, UnloadedColor);
+	}
+
+	// Never built here — a lookup over a zoomed-out view would otherwise pull in the whole
+	// pyramid below it in one frame. Stale entries keep drawing until Tick() replaces them.
+	Level = FMath::Min(Level, MaxLodLevel);
+	FSuperEntry* Super = FindOrLoadSuperTile(Level, Coord);
+	if (!Super || Super->bStale)
+	{
+		RequestSuperTile(Level, Coord);
+	}
+	if (!Super)
+	{
+		return FVCMapBlitSource::MakeFill(UnloadedColor);
+	}
+	return Super->bSolid
+		? FVCMapBlitSource::MakeFill(Super->SolidColor)
+		: MakeSourceFromCached(Super->Tile, Orientation, UnexploredColor);
+}
+
+UVCMapTileCache::FSuperEntry* UVCMapTileCache::FindOrLoadSuperTile(int32 Level, const FIntPoint& Coord)
+{
+	FSuperEntry* Existing = SuperTiles[Level - 1].Find(Coord);
+	if (Existing && !Existing->bStale)
+	{
+		Existing->LastUsedFrame = GFrameCounter;
+		return Existing;
+	}
+
+	if (FSuperEntry* Loaded = LoadSuperTile(Level, Coord))
+	{
+		return Loaded;
+	}
+
+	// Loading never removes entries, so Existing is still valid.
+	if (Existing)
+	{
+		Existing->LastUsedFrame = GFrameCounter;
+	}
+	return Existing;
+}
+
+UVCMapTileCache::FSuperEntry* UVCMapTileCache::LoadSuperTile(int32 Level, const FIntPoint& Coord)
+{
+	// Nothing explored underneath: solid fog, decided from the bitset a row of up to 64 tiles
+	// at a time instead of visiting every child.
+	const FIntRect TileRect(Coord.X << Level, Coord.Y << Level, (Coord.X + 1) << Level, (Coord.Y + 1) << Level);
+	if (!IsAnyTileExplored(TileRect))
+	{
+		FSuperEntry& Fog = AddSuperTile(Level, Coord);
+		Fog.bSolid = true;
+		Fog.SolidColor = UnexploredColor;
+		Fog.Tile.Pixels.Empty();
+		return &Fog;
+	}
+
+	// Built in an earlier session (or earlier this one and since evicted) and still current:
+	// read on the store's worker, landing in PollDiskReads().
+	if (DiskCache.IsOpen())
+	{
+		DiskCache.RequestPage(Level, Coord);
+	}
+	return nullptr;
+}
+
+UVCMapTileCache::FSuperEntry& UVCMapTileCache::AddSuperTile(int32 Level, const FIntPoint& Coord)
+{
+	TMap<FIntPoint, FSuperEntry>& LevelMap = SuperTiles[Level - 1];
+	FSuperEntry* Entry = LevelMap.Find(Coord);
+	if (!Entry)
+	{
+		Entry = &LevelMap.Add(Coord);
+		++NumSuperTiles;
+		if (NumSuperTiles > MaxCachedSuperTiles)
+		{
+			// Never evicts entries used this frame — Entry included — and removal does not move elements.
+			EvictLeastRecentlyUsedSuperTiles();
+		}
+	}
+
+	Entry->SolidColor = FColor::Black;
+	Entry->bSolid = false;
+	Entry->bStale = false;
+	Entry->LastUsedFrame = GFrameCounter;
+	Entry->Tile.Version = 0;
+	Entry->Tile.PixelsNorthUp.Reset();
+	return *Entry;
+}
+
+void UVCMapTileCache::RequestSuperTile(int32 Level, const FIntPoint& Coord)
+{
+	const FSuperKey Key{ Level, Coord };
+	if (RequestedSuperTiles.Contains(Key))
+	{
+		return;
+	}
+	RequestedSuperTiles.Add(Key);
+	SuperTileRequests.Add(Key);
+
+	// Views that moved on leave requests behind — keep the newest, as many as the cache holds.
+	const int32 Excess = SuperTileRequests.Num() - FMath::Max(MaxCachedSuperTiles, 1);
+	if (Excess > 0)
+	{
+		for (int32 Index = 0; Index < Excess; ++Index)
+		{
+			RequestedSuperTiles.Remove(SuperTileRequests[Index]);
+		}
+		SuperTileRequests.RemoveAt(0, Excess);
+	}
+}
+
+void UVCMapTileCache::RequestAncestorSuperTiles(const FIntPoint& TileCoord)
+{
+	// Deepest first, so the newest request — level 1 — is built first and each level above finds
+	// its changed child current; the siblings are normally built already, so this is one filter per level.
+	for (int32 Level = MaxLodLevel; Level >= 1; --Level)
+	{
+		RequestSuperTile(Level, FIntPoint(TileCoord.X >> Level, TileCoord.Y >> Level));
+	}
+}
+
+void UVCMapTileCache::BuildSuperTiles(double Deadline)
+{
+	// Chains waiting on disk reads or hillshades are set aside and asked for again next frame.
+	TArray<FSuperKey> Waiting;
+	do
+	{
+		if (SuperTileBuildStack.Num() == 0)
+		{
+			if (SuperTileRequests.Num() == 0)
+			{
+				break;
+			}
+			// Newest first: the view on screen now, not one the player zoomed past.
+			const FSuperKey Key = SuperTileRequests.Pop();
+			RequestedSuperTiles.Remove(Key);
+			SuperTileBuildStack.Push(Key);
+		}
+
+		// Depth-first: a super-tile missing children pushes them and is retried once they exist,
+		// so only its four children need to be resident when it is filtered.
+		switch (BuildSuperTile(SuperTileBuildStack.Last()))
+		{
+		case ESuperTileStep::Done:
+			SuperTileBuildStack.Pop();
+			break;
+		case ESuperTileStep::NeedsChildren:
+			break;
+		case ESuperTileStep::Waiting:
+			Waiting.Append(SuperTileBuildStack);
+			SuperTileBuildStack.Reset();
+			break;
+		}
+	}
+	while (FPlatformTime::Seconds() < Deadline);
+
+	for (const FSuperKey& Key : Waiting)
+	{
+		RequestSuperTile(Key.Level, Key.Coord);
+	}
+}
+
+UVCMapTileCache::ESuperTileStep UVCMapTileCache::BuildSuperTile(const FSuperKey& Key)
+{
+	const int32 Level = Key.Level;
+	const FIntPoint Coord = Key.Coord;
+	const FSuperEntry* Existing = SuperTiles[Level - 1].Find(Coord);
+	if (Existing && !Existing->bStale)
+	{
+		return ESuperTileStep::Done; // loaded or built since it was queued
+	}
+	if (LoadSuperTile(Level, Coord))
+	{
+		OnRegionUpdated.Broadcast(Level, Coord);
+		return ESuperTileStep::Done;
+	}
+	if (DiskCache.IsReadPending(Level, Coord))
+	{
+		return ESuperTileStep::Waiting;
+	}
+
+	// Children in world-X-right layout (quadrant index = QY * 2 + QX). Level-0 children are
+	// converted on the spot, and waited for while being shaded (the super-tile would bake in
+	// their interim texels); missing or stale super-tile children are built first.
+	FVCMapBlitSource Children[4];
+	bool bPushedChildren = false;
+	bool bChildrenPending = false;
+	for (int32 Q = 0; Q < 4; ++Q)
+	{
+		const FIntPoint ChildCoord(Coord.X * 2 + (Q & 1), Coord.Y * 2 + (Q >> 1));
+		if (Level == 1)
+		{
+			Children[Q] = MakeFogLodBlitSource(0, ChildCoord, EVCMapBlitOrientation::WorldXRight);
+			bChildrenPending |= ReliefJobs.Contains(ChildCoord);
+			continue;
+		}
+
+		FSuperEntry* Child = FindOrLoadSuperTile(Level - 1, ChildCoord);
+		if (!Child || Child->bStale)
+		{
+			if (DiskCache.IsReadPending(Level - 1, ChildCoord))
+			{
+				bChildrenPending = true;
+			}
+			else
+			{
+				SuperTileBuildStack.Push(FSuperKey{ Level - 1, ChildCoord });
+				bPushedChildren = true;
+			}
+			continue;
+		}
+		Children[Q] = Child->bSolid
+			? FVCMapBlitSource::MakeFill(Child->SolidColor)
+			: MakeSourceFromCached(Child->Tile, EVCMapBlitOrientation::WorldXRight, UnexploredColor);
+	}
+	if (bPushedChildren)
+	{
+		return ESuperTileStep::NeedsChildren;
+	}
+	if (bChildrenPending)
+	{
+		return ESuperTileStep::Waiting;
+	}
+
+	// Children were all used this frame, so adding the parent cannot evict them.
+	FSuperEntry& Entry = AddSuperTile(Level, Coord);
+
+	// Four solid children of one colour (typically unexplored fog) need no texels.
+	bool bSolid = true;
+	for (const FVCMapBlitSource& Child : Children)
+	{
+		bSolid &= !Child.Pixels && Child.Fill == Children[0].Fill;
+	}
+	if (bSolid)
+	{
+		Entry.bSolid = true;
+		Entry.SolidColor = Children[0].Fill;
+		Entry.Tile.Pixels.Empty();
+	}
+	else
+	{
+		// 2x2 box filter: each child contributes one quadrant at half resolution.
+		const UVoxelMapSubsystem* Subsystem = MapSubsystem.Get();
+		const int32 Res = FMath::Max(1, Subsystem ? Subsystem->GetTileResolution() : 1);
+		Entry.Tile.Resolution = Res;
+		Entry.Tile.Pixels.SetNumUninitialized(Res * Res);
+
+		auto Sample = [Res](const FVCMapBlitSource& Child, int32 X, int32 Y) -> const FColor&
+		{
+			if (!Child.Pixels)
+			{
+				return Child.Fill;
+			}
+			const int32 SX = X * Child.Resolution / Res;
+			const int32 SY = Y * Child.Resolution / Res;
+			return Child.Pixels[SY * Child.RowStride + SX * Child.ColStride];
+		};
+
+		for (int32 PY = 0; PY < Res; ++PY)
+		{
+			const int32 QY = (PY * 2 >= Res) ? 1 : 0;
+			const int32 Y0 = PY * 2 - QY * Res;
+			const int32 Y1 = FMath::Min(Y0 + 1, Res - 1);
+			for (int32 PX = 0; PX < Res; ++PX)
+			{
+				const int32 QX = (PX * 2 >= Res) ? 1 : 0;
+				const int32 X0 = PX * 2 - QX * Res;
+				const int32 X1 = FMath::Min(X0 + 1, Res - 1);
+				const FVCMapBlitSource& Child = Children[QY * 2 + QX];
+
+				const FColor& A = Sample(Child, X0, Y0);
+				const FColor& B = Sample(Child, X1, Y0);
+				const FColor& C = Sample(Child, X0, Y1);
+				const FColor& D = Sample(Child, X1, Y1);
+				Entry.Tile.Pixels[PY * Res + PX] = FColor(
+					static_cast<uint8>((A.R + B.R + C.R + D.R + 2) >> 2),
+					static_cast<uint8>((A.G + B.G + C.G + D.G + 2) >> 2),
+					static_cast<uint8>((A.B + B.B + C.B + D.B + 2) >> 2),
+					static_cast<uint8>((A.A + B.A + C.A + D.A + 2) >> 2));
+			}
+		}
+
+		if (DiskCache.IsOpen() && Res == DiskCache.GetResolution())
+		{
+			DiskCache.WritePage(Level, Coord, Entry.Tile.Pixels);
+		}
+	}
+
+	OnRegionUpdated.Broadcast(Level, Coord);
+	return ESuperTileStep::Done;
+}
+
+// ---------------------------------------------------------------------------
+// Eviction
+// ---------------------------------------------------------------------------
+
+void UVCMapTileCache::EvictLeastRecentlyUsed()
+{
+	const int32 Target = FMath::Max(0, MaxCachedTiles - MaxCachedTiles / 10);
+
+	TArray<TPair<uint64, FIntPoint>> Candidates;
+	Candidates.Reserve(Entries.Num());
+	for (const TPair<FIntPoint, FEntry>& Pair : Entries)
+	{
+		if (Pair.Value.LastUsedFrame < GFrameCounter)
+		{
+			Candidates.Emplace(Pair.Value.LastUsedFrame, Pair.Key);
+		}
+	}
+	Candidates.Sort([](const TPair<uint64, FIntPoint>& A, const TPair<uint64, FIntPoint>& B) { return A.Key < B.Key; });
+
+	for (const TPair<uint64, FIntPoint>& Candidate : Candidates)
+	{
+		if (Entries.Num() <= Target)
+		{
+			break;
+		}
+		Entries.Remove(Candidate.Value);
+	}
+
+	UE_LOG(LogVoxelCharacter, Verbose, TEXT("MapTileCache: evicted to %d tiles (budget %d)"), Entries.Num(), MaxCachedTiles);
+}
+
+void UVCMapTileCache::EvictLeastRecentlyUsedSuperTiles()
+{
+	const int32 Target = FMath::Max(0, MaxCachedSuperTiles - MaxCachedSuperTiles / 10);
+
+	struct FCandidate
+	{
+		uint64 LastUsedFrame;
+		int32 Level;
+		FIntPoint Coord;
+	};
+	TArray<FCandidate> Candidates;
+	Candidates.Reserve(NumSuperTiles);
+	for (int32 Level = 1; Level <= MaxLodLevel; ++Level)
+	{
+		for (const TPair<FIntPoint, FSuperEntry>& Pair : SuperTiles[Level - 1])
+		{
+			if (Pair.Value.LastUsedFrame < GFrameCounter)
+			{
+				Candidates.Add({ Pair.Value.LastUsedFrame, Level, Pair.Key });
+			}
+		}
+	}
+	Candidates.Sort([](const FCandidate& A, const FCandidate& B) { return A.LastUsedFrame < B.LastUsedFrame; });
+
+	for (const FCandidate& Candidate : Candidates)
+	{
+		if (NumSuperTiles <= Target)
+		{
+			break;
+		}
+		NumSuperTiles -= SuperTiles[Candidate.Level - 1].Remove(Candidate.Coord);
+	}
+}
@@ -0,0 +1,143 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#include "Map/VCMapTileRequestTracker.h"
+#include "VoxelMapSubsystem.h"
+
+void FVCMapTileRequestTracker::Reset()
+{
+	LastCenterTile = FIntPoint(MAX_int32, MAX_int32);
+	LastRadius = -1.0;
+	Requested.Reset();
+	Pending.Reset();
+	NextExpiryTime = MAX_dbl;
+}
+
+bool FVCMapTileRequestTracker::NeedsUpdate() const
+{
+	return Pending.Num() > 0 || (Requested.Num() > 0 && FPlatformTime::Seconds() >= NextExpiryTime);
+}
+
+void FVCMapTileRequestTracker::Update(UVoxelMapSubsystem& Subsystem, const FVector2D& Center, double Radius, const FVector2D& ViewDirection)
+{
+	TileWorldSize = Subsystem.GetTileWorldSize();
+	if (TileWorldSize <= 0.0)
+	{
+		return;
+	}
+	TileGridOrigin = FVector2D(Subsystem.TileCoordToWorld(FIntPoint::ZeroValue));
+	const double Now = FPlatformTime::Seconds();
+	const double Timeout = FMath::Max(RequestTimeoutSeconds, 0.0);
+
+	const FIntPoint CenterTile(
+		FMath::FloorToInt((Center.X - TileGridOrigin.X) / TileWorldSize),
+		FMath::FloorToInt((Center.Y - TileGridOrigin.Y) / TileWorldSize));
+
+	// A tile is in view when its centre is within Radius plus half a tile diagonal of the view centre
+	// (tile-centre distance, measured from the centre tile so the set only changes with it).
+	const double HalfTile = TileWorldSize * 0.5;
+	const double ReachTiles = (Radius + HalfTile * FMath::Sqrt(2.0)) / TileWorldSize;
+	auto IsInView = [CenterTile, ReachTiles](const FIntPoint& Tile)
+	{
+		return FVector2D(Tile - CenterTile).SizeSquared() <= ReachTiles * ReachTiles;
+	};
+
+	// Nearest first, pulled forward by how far ahead of the view they lie.
+	const FVector2D Dir = ViewDirection.GetSafeNormal();
+	const float Weight = FMath::Clamp(HeadingWeight, 0.0f, 1.0f);
+	auto Score = [&](const FIntPoint& Tile)
+	{
+		const FVector2D Offset(Tile - CenterTile);
+		const double Distance = Offset.Size();
+		const double Ahead = Distance > 0.0 ? 0.5 * (1.0 + FVector2D::DotProduct(Offset / Distance, Dir)) : 1.0;
+		return Distance * (1.0 - Weight * Ahead);
+	};
+	bool bSortPending = false;
+
+	if (CenterTile != LastCenterTile || Radius != LastRadius)
+	{
+		LastCenterTile = CenterTile;
+		LastRadius = Radius;
+
+		// Tiles that left the view are forgotten — the subsystem has no cancel, so an in-flight
+		// generation finishes, but they are asked for again only if they come back into view.
+		for (auto It = Requested.CreateIterator(); It; ++It)
+		{
+			if (!IsInView(*It))
+			{
+				It.RemoveCurrent();
+			}
+		}
+
+		const int32 Reach = FMath::CeilToInt(ReachTiles);
+		Pending.Reset();
+		for (int32 TY = CenterTile.Y - Reach; TY <= CenterTile.Y + Reach; ++TY)
+		{
+			for (int32 TX = CenterTile.X - Reach; TX <= CenterTile.X + Reach; ++TX)
+			{
+				const FIntPoint Tile(TX, TY);
+				if (!IsInView(Tile) || Requested.Contains(Tile))
+				{
+					continue;
+				}
+				if (Subsystem.GetTile(Tile))
+				{
+					// Tracked like a submitted tile, so an eviction while in view is noticed too.
+					Requested.Add(Tile, Now);
+					NextExpiryTime = FMath::Min(NextExpiryTime, Now + Timeout);
+				}
+				else
+				{
+					Pending.Add(Tile);
+				}
+			}
+		}
+
+		bSortPending = true;
+	}
+
+	// Requests the subsystem never answered, or whose tile it has since evicted, are queued again.
+	// Resident tiles restart their clock, so the next check after an eviction is at most a timeout away.
+	if (Requested.Num() > 0 && Now >= NextExpiryTime)
+	{
+		NextExpiryTime = MAX_dbl;
+		for (auto It = Requested.CreateIterator(); It; ++It)
+		{
+			if (Subsystem.GetTile(It->Key))
+			{
+				It->Value = Now;
+			}
+			else if (Now >= It->Value + Timeout)
+			{
+				Pending.Add(It->Key);
+				It.RemoveCurrent();
+				bSortPending = true;
+				continue;
+			}
+			NextExpiryTime = FMath::Min(NextExpiryTime, It->Value + Timeout);
+		}
+	}
+
+	if (bSortPending)
+	{
+		Pending.Sort([&Score](const FIntPoint& A, const FIntPoint& B) { return Score(A) < Score(B); });
+	}
+
+	// Submit the next batch. Single-tile requests: a radius well inside the tile touches only it.
+	int32 NumTaken = 0;
+	int32 NumSubmitted = 0;
+	const int32 Budget = FMath::Max(1, MaxRequestsPerUpdate);
+	while (NumTaken < Pending.Num() && NumSubmitted < Budget)
+	{
+		const FIntPoint Tile = Pending[NumTaken++];
+		Requested.Add(Tile, Now);
+		NextExpiryTime = FMath::Min(NextExpiryTime, Now + Timeout);
+		if (Subsystem.GetTile(Tile))
+		{
+			continue; // became resident while queued
+		}
+		const FVector2D TileCenter = TileGridOrigin + (FVector2D(Tile) + FVector2D(0.5, 0.5)) * TileWorldSize;
+		Subsystem.RequestTilesInRadius(FVector(TileCenter, 0.0), HalfTile * 0.5);
+		++NumSubmitted;
+	}
+	Pending.RemoveAt(0, NumTaken);
+}
@@ -0,0 +1,344 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#include "Map/VCMapTrail.h"
+
+namespace VCMapTrail
+{
+	static constexpr uint8 SaveFormatVersion = 1;
+
+	/** Samples since the anchor at most; past this the window closes regardless (bounds AddPoint cost). */
+	static constexpr int32 MaxWindowSamples = 64;
+
+	static uint32 ZigZag(int32 V) { return (static_cast<uint32>(V) << 1) ^ static_cast<uint32>(V >> 31); }
+	static int32 UnZigZag(uint32 V) { return static_cast<int32>(V >> 1) ^ -static_cast<int32>(V & 1); }
+
+	static void WriteVarint(TArray<uint8>& Out, uint32 V)
+	{
+		while (V >= 0x80)
+		{
+			Out.Add(static_cast<uint8>(V | 0x80));
+			V >>= 7;
+		}
+		Out.Add(static_cast<uint8>(V));
+	}
+
+	static bool ReadVarint(TConstArrayView<uint8> Data, int32& Offset, uint32& OutV)
+	{
+		OutV = 0;
+		for (int32 Shift = 0; Shift < 35; Shift += 7)
+		{
+			if (Offset >= Data.Num())
+			{
+				return false;
+			}
+			const uint8 Byte = Data[Offset++];
+			OutV |= static_cast<uint32>(Byte & 0x7F) << Shift;
+			if (!(Byte & 0x80))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	static double DistToSegmentSquared(const FVector2D& P, const FVector2D& A, const FVector2D& B)
+	{
+		const FVector2D AB = B - A;
+		const double LenSq = AB.SizeSquared();
+		const double T = LenSq > 0.0 ? FMath::Clamp(FVector2D::DotProduct(P - A, AB) / LenSq, 0.0, 1.0) : 0.0;
+		return FVector2D::DistSquared(P, A + AB * T);
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Recording
+// ---------------------------------------------------------------------------
+
+void FVCMapTrail::AddPoint(const FVector2D& WorldPosition)
+{
+	using namespace VCMapTrail;
+
+	if (!bHasAnchor)
+	{
+		CommitVertex(WorldPosition);
+		Anchor = WorldPosition;
+		bHasAnchor = true;
+		Window.Reset();
+		return;
+	}
+
+	// Standing still adds nothing.
+	const FVector2D& Newest = Window.Num() > 0 ? Window.Last() : Anchor;
+	if (FVector2D::DistSquared(WorldPosition, Newest) < FMath::Square(Quantum))
+	{
+		return;
+	}
+
+	// Would Anchor -> WorldPosition still cover every sample since the anchor? If not, the newest
+	// sample that did becomes a vertex and the window restarts from it.
+	const double TolSq = FMath::Square(FMath::Max(Tolerance, 0.0f));
+	bool bCovered = Window.Num() < MaxWindowSamples;
+	for (int32 i = 0; bCovered && i < Window.Num(); ++i)
+	{
+		bCovered = DistToSegmentSquared(Window[i], Anchor, WorldPosition) <= TolSq;
+	}
+	if (!bCovered && Window.Num() > 0)
+	{
+		Anchor = Window.Last();
+		CommitVertex(Anchor);
+		Window.Reset();
+	}
+	Window.Add(WorldPosition);
+}
+
+void FVCMapTrail::Break()
+{
+	if (Window.Num() > 0)
+	{
+		CommitVertex(Window.Last());
+	}
+	Window.Reset();
+	bHasAnchor = false;
+	bChunkOpen = false;
+}
+
+void FVCMapTrail::Reset()
+{
+	Chunks.Reset();
+	Window.Reset();
+	bHasAnchor = false;
+	bChunkOpen = false;
+}
+
+void FVCMapTrail::CommitVertex(const FVector2D& P)
+{
+	using namespace VCMapTrail;
+
+	const float Step = FMath::Max(Quantum, 1.0f);
+	const FIntPoint Q(FMath::RoundToInt(P.X / Step), FMath::RoundToInt(P.Y / Step));
+
+	if (!bChunkOpen || Chunks.Num() == 0 || Chunks.Last().NumPoints >= FMath::Max(2, MaxPointsPerChunk))
+	{
+		// A full chunk's successor repeats its last vertex so the strip stays connected.
+		const bool bContinue = bChunkOpen && Chunks.Num() > 0;
+		const FIntPoint Start = bContinue ? Chunks.Last().Last : Q;
+
+		FChunk& Chunk = Chunks.AddDefaulted_GetRef();
+		Chunk.First = Start;
+		Chunk.Last = Start;
+		Chunk.Bounds = FIntRect(Start, Start);
+		Chunk.NumPoints = 1;
+		bChunkOpen = true;
+
+		if (Chunks.Num() > FMath::Max(1, MaxChunks))
+		{
+			Chunks.RemoveAt(0);
+		}
+		if (!bContinue)
+		{
+			return;
+		}
+	}
+
+	FChunk& Chunk = Chunks.Last();
+	if (Q == Chunk.Last)
+	{
+		return;
+	}
+	WriteVarint(Chunk.Deltas, ZigZag(Q.X - Chunk.Last.X));
+	WriteVarint(Chunk.Deltas, ZigZag(Q.Y - Chunk.Last.Y));
+	Chunk.Last = Q;
+	Chunk.Bounds.Include(Q);
+	++Chunk.NumPoints;
+}
+
+// ---------------------------------------------------------------------------
+// Query
+// ---------------------------------------------------------------------------
+
+void FVCMapTrail::DecodeChunk(const FChunk& Chunk, TArray<FVector2D>& Out) const
+{
+	using namespace VCMapTrail;
+
+	const float Step = FMath::Max(Quantum, 1.0f);
+	Out.Reset(Chunk.NumPoints + 1);
+
+	FIntPoint Q = Chunk.First;
+	Out.Add(FVector2D(Q) * Step);
+	int32 Offset = 0;
+	uint32 DX = 0;
+	uint32 DY = 0;
+	while (ReadVarint(Chunk.Deltas, Offset, DX) && ReadVarint(Chunk.Deltas, Offset, DY))
+	{
+		Q += FIntPoint(UnZigZag(DX), UnZigZag(DY));
+		Out.Add(FVector2D(Q) * Step);
+	}
+}
+
+void FVCMapTrail::ForEachStripInArea(const FBox2D& Area, TFunctionRef<void(TConstArrayView<FVector2D> Points)> Func) const
+{
+	if (!Area.bIsValid)
+	{
+		return;
+	}
+
+	const float Step = FMath::Max(Quantum, 1.0f);
+	for (int32 ChunkIndex = 0; ChunkIndex < Chunks.Num(); ++ChunkIndex)
+	{
+		const FChunk& Chunk = Chunks[ChunkIndex];
+		const bool bLive = bChunkOpen && ChunkIndex == Chunks.Num() - 1 && Window.Num() > 0;
+
+		FBox2D Bounds(FVector2D(Chunk.Bounds.Min) * Step, FVector2D(Chunk.Bounds.Max) * Step);
+		if (bLive)
+		{
+			Bounds += Window.Last();
+		}
+		if (!Bounds.Intersect(Area))
+		{
+			continue;
+		}
+
+		DecodeChunk(Chunk, DecodeScratch);
+		if (bLive)
+		{
+			DecodeScratch.Add(Window.Last());
+		}
+		if (DecodeScratch.Num() >= 2)
+		{
+			Func(DecodeScratch);
+		}
+	}
+}
+
+int32 FVCMapTrail::GetNumVertices() const
+{
+	int32 Total = 0;
+	for (const FChunk& Chunk : Chunks)
+	{
+		Total += Chunk.NumPoints;
+	}
+	return Total;
+}
+
+int64 FVCMapTrail::GetAllocatedSize() const
+{
+	int64 Total = Chunks.GetAllocatedSize() + Window.GetAllocatedSize();
+	for (const FChunk& Chunk : Chunks)
+	{
+		Total += Chunk.Deltas.GetAllocatedSize();
+	}
+	return Total;
+}
+
+// ---------------------------------------------------------------------------
+// Persistence
+// ---------------------------------------------------------------------------
+
+void FVCMapTrail::Save(TArray<uint8>& OutData) const
+{
+	using namespace VCMapTrail;
+
+	OutData.Reset();
+	OutData.Add(SaveFormatVersion);
+
+	// Quantum in centi-units, so Load can rescale vertices saved at another step.
+	WriteVarint(OutData, static_cast<uint32>(FMath::RoundToInt(FMath::Max(Quantum, 1.0f) * 100.0f)));
+	WriteVarint(OutData, Chunks.Num());
+	for (const FChunk& Chunk : Chunks)
+	{
+		WriteVarint(OutData, ZigZag(Chunk.First.X));
+		WriteVarint(OutData, ZigZag(Chunk.First.Y));
+		WriteVarint(OutData, Chunk.NumPoints);
+		WriteVarint(OutData, Chunk.Deltas.Num());
+		OutData.Append(Chunk.Deltas);
+	}
+}
+
+bool FVCMapTrail::Load(TConstArrayView<uint8> Data)
+{
+	using namespace VCMapTrail;
+
+	int32 Offset = 0;
+	if (Data.Num() < 1 || Data[Offset++] != SaveFormatVersion)
+	{
+		return false;
+	}
+
+	uint32 QuantumCenti = 0;
+	uint32 NumChunks = 0;
+	if (!ReadVarint(Data, Offset, QuantumCenti) || QuantumCenti == 0
+		|| !ReadVarint(Data, Offset, NumChunks) || NumChunks > static_cast<uint32>(Data.Num()))
+	{
+		return false;
+	}
+
+	TArray<FChunk> Loaded;
+	Loaded.Reserve(NumChunks);
+	for (uint32 ChunkIndex = 0; ChunkIndex < NumChunks; ++ChunkIndex)
+	{
+		uint32 RawX = 0, RawY = 0, NumPoints = 0, NumBytes = 0;
+		if (!ReadVarint(Data, Offset, RawX) || !ReadVarint(Data, Offset, RawY)
+			|| !ReadVarint(Data, Offset, NumPoints) || NumPoints == 0
+			|| !ReadVarint(Data, Offset, NumBytes) || NumBytes > static_cast<uint32>(Data.Num() - Offset))
+		{
+			return false;
+		}
+
+		FChunk& Chunk = Loaded.AddDefaulted_GetRef();
+		Chunk.First = FIntPoint(UnZigZag(RawX), UnZigZag(RawY));
+		Chunk.Deltas = TArray<uint8>(Data.GetData() + Offset, NumBytes);
+		Offset += NumBytes;
+
+		// Rebuild Last / Bounds, checking the deltas hold exactly NumPoints - 1 vertices.
+		Chunk.Last = Chunk.First;
+		Chunk.Bounds = FIntRect(Chunk.First, Chunk.First);
+		Chunk.NumPoints = 1;
+		int32 DeltaOffset = 0;
+		while (DeltaOffset < Chunk.Deltas.Num())
+		{
+			uint32 DX = 0, DY = 0;
+			if (!ReadVarint(Chunk.Deltas, DeltaOffset, DX) || !ReadVarint(Chunk.Deltas, DeltaOffset, DY))
+			{
+				return false;
+			}
+			Chunk.Last += FIntPoint(UnZigZag(DX), UnZigZag(DY));
+			Chunk.Bounds.Include(Chunk.Last);
+			++Chunk.NumPoints;
+		}
+		if (Chunk.NumPoints != static_cast<int32>(NumPoints))
+		{
+			return false;
+		}
+	}
+	if (Offset != Data.Num())
+	{
+		return false;
+	}
+
+	// Saved at another quantum: re-encode at ours.
+	const float SavedQuantum = QuantumCenti / 100.0f;
+	Chunks.Reset();
+	Window.Reset();
+	bHasAnchor = false;
+	bChunkOpen = false;
+	if (FMath::IsNearlyEqual(SavedQuantum, FMath::Max(Quantum, 1.0f)))
+	{
+		Chunks = MoveTemp(Loaded);
+		return true;
+	}
+
+	TArray<FVector2D> Points;
+	const float CurrentQuantum = Quantum;
+	for (const FChunk& Chunk : Loaded)
+	{
+		Quantum = SavedQuantum;
+		DecodeChunk(Chunk, Points);
+		Quantum = CurrentQuantum;
+		for (const FVector2D& P : Points)
+		{
+			CommitVertex(P);
+		}
+		bChunkOpen = false;
+	}
+	return true;
+}
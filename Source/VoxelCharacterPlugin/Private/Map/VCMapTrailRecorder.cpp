@@ -0,0 +1,122 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#include "Map/VCMapTrailRecorder.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+
+UVCMapTrailRecorder* UVCMapTrailRecorder::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UVCMapTrailRecorder>() : nullptr;
+}
+
+// ---------------------------------------------------------------------------
+// Lifecycle
+// ---------------------------------------------------------------------------
+
+void UVCMapTrailRecorder::Deinitialize()
+{
+	Players.Empty();
+	Super::Deinitialize();
+}
+
+TStatId UVCMapTrailRecorder::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UVCMapTrailRecorder, STATGROUP_Tickables);
+}
+
+void UVCMapTrailRecorder::Tick(float DeltaTime)
+{
+	TimeUntilSample -= DeltaTime;
+	if (TimeUntilSample > 0.0f)
+	{
+		return;
+	}
+	TimeUntilSample = FMath::Max(SampleInterval, 0.0f);
+
+	// Controllers that left keep no trail.
+	Players.RemoveAll([](const FPlayerTrail& Entry) { return !Entry.PlayerController.IsValid(); });
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		const APawn* Pawn = PC && PC->IsLocalController() ? PC->GetPawn() : nullptr;
+		if (!Pawn)
+		{
+			continue;
+		}
+
+		FPlayerTrail& Entry = FindOrAddEntry(PC);
+		const FVector2D Position(Pawn->GetActorLocation());
+		if (Entry.bHasSample
+			&& (Entry.Pawn.Get() != Pawn || FVector2D::DistSquared(Position, Entry.LastSample) > FMath::Square(TeleportDistance)))
+		{
+			Entry.Trail.Break();
+		}
+		Entry.Trail.AddPoint(Position);
+		Entry.Pawn = Pawn;
+		Entry.LastSample = Position;
+		Entry.bHasSample = true;
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Access
+// ---------------------------------------------------------------------------
+
+UVCMapTrailRecorder::FPlayerTrail* UVCMapTrailRecorder::FindEntry(const APlayerController* PlayerController)
+{
+	return Players.FindByPredicate([PlayerController](const FPlayerTrail& Entry) { return Entry.PlayerController.Get() == PlayerController; });
+}
+
+const UVCMapTrailRecorder::FPlayerTrail* UVCMapTrailRecorder::FindEntry(const APlayerController* PlayerController) const
+{
+	return Players.FindByPredicate([PlayerController](const FPlayerTrail& Entry) { return Entry.PlayerController.Get() == PlayerController; });
+}
+
+UVCMapTrailRecorder::FPlayerTrail& UVCMapTrailRecorder::FindOrAddEntry(const APlayerController* PlayerController)
+{
+	if (FPlayerTrail* Entry = FindEntry(PlayerController))
+	{
+		return *Entry;
+	}
+	FPlayerTrail& Entry = Players.AddDefaulted_GetRef();
+	Entry.PlayerController = PlayerController;
+	return Entry;
+}
+
+const FVCMapTrail* UVCMapTrailRecorder::GetTrail(const APlayerController* PlayerController) const
+{
+	const FPlayerTrail* Entry = PlayerController ? FindEntry(PlayerController) : nullptr;
+	return Entry ? &Entry->Trail : nullptr;
+}
+
+void UVCMapTrailRecorder::ClearTrail(const APlayerController* PlayerController)
+{
+	Players.RemoveAll([PlayerController](const FPlayerTrail& Entry) { return Entry.PlayerController.Get() == PlayerController; });
+}
+
+void UVCMapTrailRecorder::SaveTrail(const APlayerController* PlayerController, TArray<uint8>& OutData) const
+{
+	OutData.Reset();
+	if (const FVCMapTrail* Trail = GetTrail(PlayerController))
+	{
+		Trail->Save(OutData);
+	}
+}
+
+bool UVCMapTrailRecorder::LoadTrail(const APlayerController* PlayerController, TConstArrayView<uint8> Data)
+{
+	if (!PlayerController)
+	{
+		return false;
+	}
+	FPlayerTrail& Entry = FindOrAddEntry(PlayerController);
+	if (!Entry.Trail.Load(Data))
+	{
+		return false;
+	}
+	Entry.bHasSample = false;
+	return true;
+}
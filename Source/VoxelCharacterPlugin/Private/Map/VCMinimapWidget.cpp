@@ -2,8 +2,12 @@
 
 #include "Map/VCMinimapWidget.h"
 #include "Map/VCMapMarkerRegistry.h"
+#include "Map/VCMapMarkerLayer.h"
+#include "Map/VCMapTileCache.h"
 #include "VoxelMapSubsystem.h"
 #include "VoxelCharacterPlugin.h"
+#include "Core/VCBudgetWatchdog.h"
+#include "Core/VCPerfReport.h"
 #include "Blueprint/WidgetTree.h"
 #include "Components/SizeBox.h"
 #include "Components/CanvasPanel.h"
@@ -18,6 +22,16 @@
 // so that when rotated 45 degrees the corners still fill the entire area.
 static constexpr float RotationOversize = 1.42f;
 
+// Map texel colour where no tile data exists (matches the border colour).
+static const FColor MinimapEmptyColor(5, 5, 5, 255);
+
+// Non-negative V mod N — world pixel coordinates are signed, ring texels are not.
+static FORCEINLINE int32 WrapRingIndex(int32 V, int32 N)
+{
+	const int32 R = V % N;
+	return R < 0 ? R + N : R;
+}
+
 // ---------------------------------------------------------------------------
 // Widget Tree Construction
 // ---------------------------------------------------------------------------
@@ -28,6 +42,22 @@ void UVCMinimapWidget::NativeOnInitialized()
 	BuildWidgetTree();
 }
 
+void UVCMinimapWidget::NativeDestruct()
+{
+	if (MapSubsystem.IsValid() && TileReadyHandle.IsValid())
+	{
+		MapSubsystem->OnMapTileReady.Remove(TileReadyHandle);
+	}
+	TileReadyHandle.Reset();
+	if (TileCache.IsValid() && RegionUpdatedHandle.IsValid())
+	{
+		TileCache->OnRegionUpdated.Remove(RegionUpdatedHandle);
+	}
+	RegionUpdatedHandle.Reset();
+
+	Super::NativeDestruct();
+}
+
 void UVCMinimapWidget::BuildWidgetTree()
 {
 	if (!WidgetTree)
@@ -72,6 +102,14 @@ void UVCMinimapWidget::BuildWidgetTree()
 		MapSlot->SetAutoSize(true);
 	}
 
+	// Marker layer — fills the canvas; markers are drawn relative to its centre.
+	MarkerLayer = WidgetTree->ConstructWidget<UVCMapMarkerLayer>(UVCMapMarkerLayer::StaticClass(), TEXT("MinimapMarkers"));
+	if (UCanvasPanelSlot* MarkerSlot = MapCanvas->AddChildToCanvas(MarkerLayer))
+	{
+		MarkerSlot->SetAnchors(FAnchors(0.0f, 0.0f, 1.0f, 1.0f));
+		MarkerSlot->SetOffsets(FMargin(0.0f));
+	}
+
 	// Player arrow at center — a small dot
 	PlayerArrow = WidgetTree->ConstructWidget<UImage>(UImage::StaticClass(), TEXT("PlayerArrow"));
 	PlayerArrow->SetColorAndOpacity(FLinearColor(1.0f, 1.0f, 1.0f, 0.9f));
@@ -132,6 +170,8 @@ void UVCMinimapWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime
 	}
 	TimeSinceLastUpdate = 0.0f;
 
+	VC_PERF_SCOPE(VCMap, MinimapUpdate);
+
 	// Resolve subsystem lazily
 	if (!MapSubsystem.IsValid())
 	{
@@ -143,6 +183,24 @@ void UVCMinimapWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime
 		{
 			return;
 		}
+		TileReadyHandle.Reset();
+		TileRequests.Reset();
+	}
+
+	// Tiles arriving after their area was rasterized are patched in on the next refresh.
+	if (!TileReadyHandle.IsValid())
+	{
+		TileReadyHandle = MapSubsystem->OnMapTileReady.AddUObject(this, &UVCMinimapWidget::HandleMapTileReady);
+	}
+
+	// So are tiles the shared cache reads back from its disk store, a frame or two after the miss.
+	if (!RegionUpdatedHandle.IsValid())
+	{
+		TileCache = UVCMapTileCache::Get(this);
+		if (UVCMapTileCache* Cache = TileCache.Get())
+		{
+			RegionUpdatedHandle = Cache->OnRegionUpdated.AddUObject(this, &UVCMinimapWidget::HandleMapRegionUpdated);
+		}
 	}
 
 	// Get player position and camera yaw
@@ -160,54 +218,114 @@ void UVCMinimapWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime
 
 	const FVector PlayerPos = PlayerPawn->GetActorLocation();
 
-	// Request tiles for the minimap's visible area (oversized for rotation)
-	MapSubsystem->RequestTilesInRadius(PlayerPos, MinimapWorldRadius * RotationOversize);
+	FRotator CameraRot;
+	FVector CameraLoc;
+	PC->GetPlayerViewPoint(CameraLoc, CameraRot);
+
+	// Change key — an idle player skips everything below but the render transforms. The map
+	// only changes when the view moves by a whole map pixel or a tile in view becomes ready;
+	// markers when the view moves or the registry's revision does. Rotation never rebuilds.
+	int32 TexSize = 0;
+	double WorldPerPixel = 0.0;
+	GetRingGeometry(TexSize, WorldPerPixel);
+	const FIntPoint ViewOrigin(
+		FMath::FloorToInt(PlayerPos.X / WorldPerPixel) - TexSize / 2,
+		FMath::FloorToInt(PlayerPos.Y / WorldPerPixel) - TexSize / 2);
+	const bool bViewMoved = !bRingValid || ViewOrigin != RingOrigin || TexSize != CurrentTextureSize || WorldPerPixel != RingWorldPerPixel;
+
+	if (bViewMoved || TileRequests.NeedsUpdate())
+	{
+		// Request tiles for the minimap's visible area (oversized for rotation): only ones that
+		// newly entered it or whose request timed out, nearest and most ahead of the camera first,
+		// a batch per check.
+		const FVector2D ViewDirection = FVector2D(CameraRot.Vector()).GetSafeNormal();
+		TileRequests.Update(*MapSubsystem, FVector2D(PlayerPos), MinimapWorldRadius * RotationOversize, ViewDirection);
+	}
+
+	if (bViewMoved || ReadyTilesSinceRefresh.Num() > 0)
+	{
+		RefreshMapTexture(PlayerPos);
+	}
+
+	if (!MarkerRegistry.IsValid())
+	{
+		if (const UWorld* World = GetWorld())
+		{
+			MarkerRegistry = World->GetSubsystem<UVCMapMarkerRegistry>();
+		}
+	}
+	const uint32 MarkerRevision = MarkerRegistry.IsValid() ? MarkerRegistry->GetRevision() : 0;
+	const bool bAsyncMarkersReady = AsyncMarkers.Poll();
+	if (bViewMoved || !bMarkersValid || MarkerRevision != DrawnMarkerRevision || bAsyncMarkersReady)
+	{
+		// Marker dots from the registry (POIs, quests, ... — the map is source-agnostic).
+		UpdateMarkers(PlayerPos);
+		DrawnMarkerRevision = MarkerRevision;
+		bMarkersValid = true;
+	}
 
 	// Update coordinate text — display in voxel coordinates (divide by VoxelSize)
 	if (CoordinateText)
 	{
 		const float VoxelSize = MapSubsystem->GetTileWorldSize() / FMath::Max(1, MapSubsystem->GetTileResolution());
-		const int32 VoxelX = FMath::RoundToInt(PlayerPos.X / VoxelSize);
-		const int32 VoxelY = FMath::RoundToInt(PlayerPos.Y / VoxelSize);
-		CoordinateText->SetText(FText::FromString(
-			FString::Printf(TEXT("X: %d  Y: %d"), VoxelX, VoxelY)
-		));
+		const FIntPoint VoxelCoord(FMath::RoundToInt(PlayerPos.X / VoxelSize), FMath::RoundToInt(PlayerPos.Y / VoxelSize));
+		if (VoxelCoord != DisplayedVoxelCoord)
+		{
+			DisplayedVoxelCoord = VoxelCoord;
+			CoordinateText->SetText(FText::FromString(
+				FString::Printf(TEXT("X: %d  Y: %d"), VoxelCoord.X, VoxelCoord.Y)
+			));
+		}
 	}
 
-	// Refresh the map texture
-	RefreshMapTexture();
-
 	// Rotate map so the player's forward direction points up on the minimap.
 	// UE yaw=0 is +X. The texture maps +X to the right, so a -90 offset
 	// rotates +X (forward at yaw=0) from right to up.
-	FRotator CameraRot;
-	FVector CameraLoc;
-	PC->GetPlayerViewPoint(CameraLoc, CameraRot);
-
 	const float MapAngleDeg = -CameraRot.Yaw - 90.0f;
-	if (MapImage)
+
+	// The ring scrolls in whole pixels; shift the image by the player's sub-pixel offset
+	// (rotated into screen space) so the terrain glides instead of stepping. The marker layer
+	// shares the transform — its dots are laid out around the same view centre, unrotated.
+	FVector2D MapTranslation = FVector2D::ZeroVector;
+	if (RingWorldPerPixel > 0.0)
 	{
-		MapImage->SetRenderTransformAngle(MapAngleDeg);
+		const double HalfSize = CurrentTextureSize * 0.5;
+		const FVector2D SubPixel(
+			PlayerPos.X / RingWorldPerPixel - RingOrigin.X - HalfSize,
+			PlayerPos.Y / RingWorldPerPixel - RingOrigin.Y - HalfSize);
+		MapTranslation = (-SubPixel).GetRotated(MapAngleDeg);
 	}
 
-	// Marker dots from the registry (POIs, quests, ... — the map is source-agnostic),
-	// rotated with the map so they stay glued to the terrain.
-	UpdateMarkers(PlayerPos, MapAngleDeg);
-
-	// Position the north indicator on the minimap edge.
-	// North = +X axis (yaw=0 direction). As the camera rotates, north's
-	// position on the minimap orbits around the center.
-	if (NorthIndicator)
+	if (MapAngleDeg != AppliedMapAngleDeg || MapTranslation != AppliedMapTranslation)
 	{
-		const float NorthAngleRad = FMath::DegreesToRadians(-CameraRot.Yaw);
-		const float Radius = MinimapSize * 0.40f;
-		const float NX = FMath::Sin(NorthAngleRad) * Radius;
-		const float NY = -FMath::Cos(NorthAngleRad) * Radius;
-
-		UCanvasPanelSlot* NorthSlot = Cast<UCanvasPanelSlot>(NorthIndicator->Slot);
-		if (NorthSlot)
+		AppliedMapAngleDeg = MapAngleDeg;
+		AppliedMapTranslation = MapTranslation;
+		auto ApplyMapTransform = [MapAngleDeg, &MapTranslation](UWidget* Layer)
+		{
+			if (Layer)
+			{
+				Layer->SetRenderTransformAngle(MapAngleDeg);
+				Layer->SetRenderTranslation(MapTranslation);
+			}
+		};
+		ApplyMapTransform(MapImage);
+		ApplyMapTransform(MarkerLayer);
+
+		// Position the north indicator on the minimap edge.
+		// North = +X axis (yaw=0 direction). As the camera rotates, north's
+		// position on the minimap orbits around the center.
+		if (NorthIndicator)
 		{
-			NorthSlot->SetPosition(FVector2D(NX, NY));
+			const float NorthAngleRad = FMath::DegreesToRadians(-CameraRot.Yaw);
+			const float Radius = MinimapSize * 0.40f;
+			const float NX = FMath::Sin(NorthAngleRad) * Radius;
+			const float NY = -FMath::Cos(NorthAngleRad) * Radius;
+
+			UCanvasPanelSlot* NorthSlot = Cast<UCanvasPanelSlot>(NorthIndicator->Slot);
+			if (NorthSlot)
+			{
+				NorthSlot->SetPosition(FVector2D(NX, NY));
+			}
 		}
 	}
 }
@@ -216,83 +334,73 @@ void UVCMinimapWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime
 // Markers
 // ---------------------------------------------------------------------------
 
-void UVCMinimapWidget::UpdateMarkers(const FVector& PlayerPos, float MapAngleDeg)
+void UVCMinimapWidget::UpdateMarkers(const FVector& PlayerPos)
 {
-	if (!MapCanvas || !WidgetTree)
+	if (!MarkerLayer || RingWorldPerPixel <= 0.0)
 	{
 		return;
 	}
+	FVCBudgetScope Budget(EVCBudget::MarkerGather, GetOwningPlayerPawn());
+	Budget.Location = PlayerPos;
 
-	if (!MarkerRegistry.IsValid())
-	{
-		if (const UWorld* World = GetWorld())
-		{
-			MarkerRegistry = World->GetSubsystem<UVCMapMarkerRegistry>();
-		}
-	}
+	const FVector2D Player2D(PlayerPos.X, PlayerPos.Y);
+
+	// Offsets are from the ring's view centre, in unrotated ring pixels; the layer's render
+	// transform (same as the map image's) applies rotation and the sub-pixel glide.
+	const double HalfSize = CurrentTextureSize * 0.5;
+	const FVector2D ViewCentrePixel(RingOrigin.X + HalfSize, RingOrigin.Y + HalfSize);
 
-	TArray<FVCMapMarker> Markers;
+	MarkerScratch.Reset();
 	if (UVCMapMarkerRegistry* Registry = MarkerRegistry.Get())
 	{
-		// Gather slightly beyond the visible radius so dots slide in smoothly at the rim.
-		const FVector2D Player2D(PlayerPos.X, PlayerPos.Y);
+		// Gather slightly beyond the visible radius so dots slide in smoothly at the rim. The area
+		// follows the ring (whole pixels), so a still player never re-launches the async gather.
 		const float GatherRadius = MinimapWorldRadius * RotationOversize;
-		const FBox2D Area(Player2D - FVector2D(GatherRadius, GatherRadius), Player2D + FVector2D(GatherRadius, GatherRadius));
-		Registry->GatherMarkers(Area, Markers);
-	}
+		const FVector2D ViewCentre = ViewCentrePixel * RingWorldPerPixel;
+		const FBox2D Area(ViewCentre - FVector2D(GatherRadius, GatherRadius), ViewCentre + FVector2D(GatherRadius, GatherRadius));
+		Registry->GatherMarkers(Area, MarkerScratch);
 
-	// Highest priority first — they win the marker budget and draw on top (added last below).
-	Markers.Sort([](const FVCMapMarker& A, const FVCMapMarker& B) { return A.Priority > B.Priority; });
+		AsyncMarkers.Request(*Registry, Area);
+		MarkerScratch.Append(AsyncMarkers.GetMarkers());
+	}
 
-	const FVector2D Player2D(PlayerPos.X, PlayerPos.Y);
 	const float PixelsPerWorldUnit = MinimapSize / (2.0f * FMath::Max(MinimapWorldRadius, 1.0f));
 	const float VisibleRadiusPx = MinimapSize * 0.48f; // keep dots inside the square
 
-	int32 Used = 0;
-	for (const FVCMapMarker& Marker : Markers)
+	// Cull to the visible disc first (rotation does not change the distance), compacting the
+	// survivors to the front, then keep the highest-priority MaxMarkers of those.
+	const float VisibleRadiusWorld = VisibleRadiusPx / PixelsPerWorldUnit;
+	int32 NumVisible = 0;
+	for (int32 i = 0; i < MarkerScratch.Num(); ++i)
 	{
-		if (Used >= MaxMarkers)
-		{
-			break;
-		}
-
-		// World offset -> pixel offset -> rotate with the map image (same angle, same pivot).
-		const FVector2D PixelOffset = (Marker.WorldPosition - Player2D) * PixelsPerWorldUnit;
-		const FVector2D Rotated = PixelOffset.GetRotated(MapAngleDeg);
-		if (Rotated.SizeSquared() > VisibleRadiusPx * VisibleRadiusPx)
+		if (FVector2D::DistSquared(MarkerScratch[i].WorldPosition, Player2D) <= VisibleRadiusWorld * VisibleRadiusWorld)
 		{
-			continue;
-		}
-
-		// Pool: create on demand, reuse thereafter.
-		if (!MarkerDots.IsValidIndex(Used))
-		{
-			UImage* Dot = WidgetTree->ConstructWidget<UImage>(UImage::StaticClass());
-			Dot->SetDesiredSizeOverride(FVector2D(MarkerDotSize, MarkerDotSize));
-			if (UCanvasPanelSlot* DotSlot = MapCanvas->AddChildToCanvas(Dot))
+			if (i != NumVisible)
 			{
-				DotSlot->SetAnchors(FAnchors(0.5f, 0.5f, 0.5f, 0.5f));
-				DotSlot->SetAlignment(FVector2D(0.5f, 0.5f));
-				DotSlot->SetAutoSize(true);
+				Swap(MarkerScratch[NumVisible], MarkerScratch[i]);
 			}
-			MarkerDots.Add(Dot);
-		}
-
-		UImage* Dot = MarkerDots[Used];
-		Dot->SetVisibility(ESlateVisibility::HitTestInvisible);
-		Dot->SetColorAndOpacity(Marker.Color);
-		if (UCanvasPanelSlot* DotSlot = Cast<UCanvasPanelSlot>(Dot->Slot))
-		{
-			DotSlot->SetPosition(Rotated);
+			++NumVisible;
 		}
-		++Used;
 	}
 
-	// Hide the unused tail of the pool.
-	for (int32 i = Used; i < MarkerDots.Num(); ++i)
+	// Highest priority first — they win the marker budget.
+	const int32 NumSelected = UVCMapMarkerRegistry::SelectHighestPriority(
+		MakeArrayView(MarkerScratch.GetData(), NumVisible), MaxMarkers);
+
+	TArray<FVCMapMarkerDraw>& Draws = MarkerLayer->EditMarkers();
+	Draws.Reset();
+	for (int32 MarkerIndex = NumSelected - 1; MarkerIndex >= 0; --MarkerIndex)
 	{
-		MarkerDots[i]->SetVisibility(ESlateVisibility::Collapsed);
+		const FVCMapMarker& Marker = MarkerScratch[MarkerIndex];
+
+		// Lowest priority first so the highest draws on top.
+		FVCMapMarkerDraw& Draw = Draws.AddDefaulted_GetRef();
+		Draw.Offset = Marker.WorldPosition / RingWorldPerPixel - ViewCentrePixel;
+		Draw.Size = MarkerDotSize;
+		Draw.Color = Marker.Color;
 	}
+	MarkerLayer->CommitMarkers();
+	Budget.Count = Draws.Num();
 }
 
 // ---------------------------------------------------------------------------
@@ -315,123 +423,216 @@ void UVCMinimapWidget::EnsureTexture(int32 TexSize)
 	MapTexture->Filter = TF_Bilinear;
 	MapTexture->SRGB = true;
 	MapTexture->CompressionSettings = TC_VectorDisplacementmap;
-	MapTexture->AddressX = TA_Clamp;
-	MapTexture->AddressY = TA_Clamp;
+	MapTexture->AddressX = TA_Wrap;
+	MapTexture->AddressY = TA_Wrap;
+
+	// Create the RHI resource once; refreshes only push dirty regions into it.
+	MapTexture->UpdateResource();
 
 	CurrentTextureSize = TexSize;
+	bRingValid = false;
 }
 
-void UVCMinimapWidget::RefreshMapTexture()
+void UVCMinimapWidget::HandleMapTileReady(FIntPoint TileCoord)
 {
-	UVoxelMapSubsystem* Subsystem = MapSubsystem.Get();
-	if (!Subsystem || !MapImage)
+	// Only tiles overlapping the drawn view need patching; others are rasterized when scrolled
+	// in, and before the first full draw there is nothing to patch.
+	const UVoxelMapSubsystem* Subsystem = MapSubsystem.Get();
+	if (!bRingValid || !Subsystem || RingWorldPerPixel <= 0.0)
 	{
 		return;
 	}
 
-	const APlayerController* PC = GetOwningPlayer();
-	if (!PC || !PC->GetPawn())
+	const FVector TileWorldOrigin = Subsystem->TileCoordToWorld(TileCoord);
+	const double TileWorldSize = Subsystem->GetTileWorldSize();
+	const FVector2D ViewMin = FVector2D(RingOrigin) * RingWorldPerPixel;
+	const FVector2D ViewMax = FVector2D(RingOrigin + FIntPoint(CurrentTextureSize, CurrentTextureSize)) * RingWorldPerPixel;
+	if (TileWorldOrigin.X < ViewMax.X && TileWorldOrigin.X + TileWorldSize > ViewMin.X
+		&& TileWorldOrigin.Y < ViewMax.Y && TileWorldOrigin.Y + TileWorldSize > ViewMin.Y)
 	{
-		return;
+		ReadyTilesSinceRefresh.Add(TileCoord);
 	}
+}
 
-	const FVector PlayerPos = PC->GetPawn()->GetActorLocation();
-	const float TileWorldSize = Subsystem->GetTileWorldSize();
-	const int32 TileResolution = Subsystem->GetTileResolution();
-	if (TileWorldSize <= 0.f || TileResolution <= 0)
+void UVCMinimapWidget::HandleMapRegionUpdated(int32 Level, const FIntPoint& Coord)
+{
+	if (Level == 0)
 	{
-		return;
+		HandleMapTileReady(Coord);
 	}
+}
 
+void UVCMinimapWidget::GetRingGeometry(int32& OutTexSize, double& OutWorldPerPixel) const
+{
 	// Texture size matches the oversized display size exactly — no scaling.
 	// The image is sqrt(2) larger than the visible square so it fills the
 	// corners at any rotation angle. The SizeBox clips it to MinimapSize.
-	const int32 TexSize = FMath::CeilToInt(MinimapSize * RotationOversize);
-	const float ViewWorldExtent = MinimapWorldRadius * RotationOversize;
-	const float WorldPerPixel = (ViewWorldExtent * 2.0f) / static_cast<float>(TexSize);
+	OutTexSize = FMath::Max(1, FMath::CeilToInt(MinimapSize * RotationOversize));
+	OutWorldPerPixel = (MinimapWorldRadius * RotationOversize * 2.0) / static_cast<double>(OutTexSize);
+}
 
-	EnsureTexture(TexSize);
-	if (!MapTexture)
+void UVCMinimapWidget::RefreshMapTexture(const FVector& PlayerPos)
+{
+	UVoxelMapSubsystem* Subsystem = MapSubsystem.Get();
+	if (!Subsystem || !MapImage)
 	{
 		return;
 	}
+	FVCBudgetScope Budget(EVCBudget::MapRefresh, GetOwningPlayerPawn());
+	Budget.Location = PlayerPos;
+	Budget.Count = ReadyTilesSinceRefresh.Num();
 
-	// Lock texture for writing
-	FTexture2DMipMap& Mip = MapTexture->GetPlatformData()->Mips[0];
-	void* TextureData = Mip.BulkData.Lock(LOCK_READ_WRITE);
-	if (!TextureData)
+	const float TileWorldSize = Subsystem->GetTileWorldSize();
+	const int32 TileResolution = Subsystem->GetTileResolution();
+	if (TileWorldSize <= 0.f || TileResolution <= 0)
 	{
 		return;
 	}
 
-	uint8* PixelData = static_cast<uint8*>(TextureData);
-	const int32 TotalPixels = TexSize * TexSize;
+	int32 TexSize = 0;
+	double WorldPerPixel = 0.0;
+	GetRingGeometry(TexSize, WorldPerPixel);
 
-	// Clear to dark background (matches border color)
-	for (int32 i = 0; i < TotalPixels; ++i)
+	EnsureTexture(TexSize);
+	if (!MapTexture)
 	{
-		PixelData[i * 4 + 0] = 5;   // B
-		PixelData[i * 4 + 1] = 5;   // G
-		PixelData[i * 4 + 2] = 5;   // R
-		PixelData[i * 4 + 3] = 255; // A
+		return;
 	}
 
-	// World bounds of the texture, centered on player
-	const float WorldMinX = PlayerPos.X - ViewWorldExtent;
-	const float WorldMinY = PlayerPos.Y - ViewWorldExtent;
+	if (!bRingValid || RingBuffer.GetWidth() != TexSize || RingWorldPerPixel != WorldPerPixel)
+	{
+		RingBuffer.Reset(TexSize, TexSize);
+		RingWorldPerPixel = WorldPerPixel;
+		bRingValid = false;
+	}
 
-	// How many tiles from center to edge we need to iterate
-	const FIntPoint CenterTile = Subsystem->WorldToTileCoord(PlayerPos);
-	const int32 TileRadius = FMath::CeilToInt(ViewWorldExtent / TileWorldSize);
+	// World pixel grid: pixel (GX, GY) covers world [G, G + 1) * WorldPerPixel and always
+	// lives at texel (GX mod TexSize, GY mod TexSize), so scrolling never moves texels.
+	const FIntPoint CenterPixel(
+		FMath::FloorToInt(PlayerPos.X / WorldPerPixel),
+		FMath::FloorToInt(PlayerPos.Y / WorldPerPixel));
+	const FIntPoint NewOrigin = CenterPixel - FIntPoint(TexSize / 2, TexSize / 2);
+	const FIntPoint Delta = NewOrigin - RingOrigin;
 
-	// Blit tile data — map each tile's source pixels to destination via world coords
-	for (int32 TY = -TileRadius; TY <= TileRadius; ++TY)
+	bool bFullRedraw = false;
+	if (!bRingValid || FMath::Abs(Delta.X) >= TexSize || FMath::Abs(Delta.Y) >= TexSize)
 	{
-		for (int32 TX = -TileRadius; TX <= TileRadius; ++TX)
+		// First frame, resize or teleport — nothing in the ring is reusable.
+		RasterizeRingRect(NewOrigin, FIntPoint(TexSize, TexSize), WorldPerPixel);
+		ReadyTilesSinceRefresh.Reset();
+		bRingValid = true;
+		bFullRedraw = true;
+	}
+	else
+	{
+		// Newly exposed columns, full height of the new view...
+		if (Delta.X != 0)
 		{
-			const FIntPoint TileCoord(CenterTile.X + TX, CenterTile.Y + TY);
-			const FVoxelMapTile* Tile = Subsystem->GetTile(TileCoord);
-			if (!Tile)
-			{
-				continue;
-			}
+			const int32 MinX = Delta.X > 0 ? RingOrigin.X + TexSize : NewOrigin.X;
+			RasterizeRingRect(FIntPoint(MinX, NewOrigin.Y), FIntPoint(FMath::Abs(Delta.X), TexSize), WorldPerPixel);
+		}
 
-			const FVector TileWorldOrigin = Subsystem->TileCoordToWorld(TileCoord);
-			const int32 SrcRes = Tile->Resolution;
-			const float SrcPixelWorldSize = TileWorldSize / SrcRes;
+		// ...then newly exposed rows, minus the corner the columns already covered.
+		if (Delta.Y != 0 && FMath::Abs(Delta.X) < TexSize)
+		{
+			const int32 MinY = Delta.Y > 0 ? RingOrigin.Y + TexSize : NewOrigin.Y;
+			const int32 MinX = NewOrigin.X + FMath::Max(0, -Delta.X);
+			RasterizeRingRect(FIntPoint(MinX, MinY), FIntPoint(TexSize - FMath::Abs(Delta.X), FMath::Abs(Delta.Y)), WorldPerPixel);
+		}
 
-			for (int32 PY = 0; PY < SrcRes; ++PY)
+		// Tiles that finished generating since the last refresh — redraw their footprint in view.
+		for (const FIntPoint& TileCoord : ReadyTilesSinceRefresh)
+		{
+			const FVector TileWorldOrigin = Subsystem->TileCoordToWorld(TileCoord);
+			const int32 TileMinX = FMath::Max(NewOrigin.X, FMath::FloorToInt(TileWorldOrigin.X / WorldPerPixel));
+			const int32 TileMinY = FMath::Max(NewOrigin.Y, FMath::FloorToInt(TileWorldOrigin.Y / WorldPerPixel));
+			const int32 TileMaxX = FMath::Min(NewOrigin.X + TexSize, FMath::CeilToInt((TileWorldOrigin.X + TileWorldSize) / WorldPerPixel));
+			const int32 TileMaxY = FMath::Min(NewOrigin.Y + TexSize, FMath::CeilToInt((TileWorldOrigin.Y + TileWorldSize) / WorldPerPixel));
+			if (TileMinX < TileMaxX && TileMinY < TileMaxY)
 			{
-				for (int32 PX = 0; PX < SrcRes; ++PX)
-				{
-					const float PixWorldX = TileWorldOrigin.X + PX * SrcPixelWorldSize;
-					const float PixWorldY = TileWorldOrigin.Y + PY * SrcPixelWorldSize;
-
-					const int32 DstX = FMath::FloorToInt((PixWorldX - WorldMinX) / WorldPerPixel);
-					const int32 DstY = FMath::FloorToInt((PixWorldY - WorldMinY) / WorldPerPixel);
-
-					if (DstX < 0 || DstX >= TexSize || DstY < 0 || DstY >= TexSize)
-					{
-						continue;
-					}
-
-					const FColor& SrcColor = Tile->PixelData[PY * SrcRes + PX];
-					const int32 DstIdx = (DstY * TexSize + DstX) * 4;
-					PixelData[DstIdx + 0] = SrcColor.B;
-					PixelData[DstIdx + 1] = SrcColor.G;
-					PixelData[DstIdx + 2] = SrcColor.R;
-					PixelData[DstIdx + 3] = SrcColor.A;
-				}
+				RasterizeRingRect(FIntPoint(TileMinX, TileMinY), FIntPoint(TileMaxX - TileMinX, TileMaxY - TileMinY), WorldPerPixel);
 			}
 		}
+		ReadyTilesSinceRefresh.Reset();
 	}
 
-	Mip.BulkData.Unlock();
-	MapTexture->UpdateResource();
+	const bool bOriginChanged = NewOrigin != RingOrigin;
+	RingOrigin = NewOrigin;
+
+	// Only the rasterized rects go to the GPU; the RHI texture is never recreated.
+	RingBuffer.Flush(MapTexture);
+
+	// Display at 1:1 pixel ratio — the brush image size matches the texture, so the
+	// UV region spans exactly one texture and starts at the texel holding the view's
+	// min corner. Tiling makes Slate sample with wrap addressing, undoing the ring's
+	// wrap-around. The SizeBox clips the overflow to the visible MinimapSize square.
+	if (bFullRedraw || bOriginChanged)
+	{
+		const float U0 = static_cast<float>(WrapRingIndex(NewOrigin.X, TexSize)) / TexSize;
+		const float V0 = static_cast<float>(WrapRingIndex(NewOrigin.Y, TexSize)) / TexSize;
+
+		FSlateBrush Brush;
+		Brush.SetResourceObject(MapTexture);
+		Brush.ImageSize = FVector2D(static_cast<float>(TexSize), static_cast<float>(TexSize));
+		Brush.Tiling = ESlateBrushTileType::Both;
+		Brush.SetUVRegion(FBox2f(FVector2f(U0, V0), FVector2f(U0 + 1.0f, V0 + 1.0f)));
+		MapImage->SetBrush(Brush);
+		MapImage->SetDesiredSizeOverride(FVector2D(static_cast<float>(TexSize), static_cast<float>(TexSize)));
+	}
+}
+
+void UVCMinimapWidget::RasterizeRingRect(const FIntPoint& Min, const FIntPoint& Size, double WorldPerPixel)
+{
+	UVoxelMapSubsystem* Subsystem = MapSubsystem.Get();
+	const int32 TexSize = CurrentTextureSize;
+	if (!Subsystem || Size.X <= 0 || Size.Y <= 0 || RingBuffer.GetWidth() != TexSize)
+	{
+		return;
+	}
+
+	// Grid pixel (GX, GY) is world pixel (GX, GY) — the ring is anchored at the world origin.
+	FVCMapBlitView View;
+	View.Orientation = EVCMapBlitOrientation::WorldXRight;
+	View.GridWorldOrigin = FVector2D::ZeroVector;
+	View.WorldPerPixel = WorldPerPixel;
+	View.TileGridOrigin = FVector2D(Subsystem->TileCoordToWorld(FIntPoint::ZeroValue));
+	View.TileWorldSize = Subsystem->GetTileWorldSize();
+	View.TileResolution = Subsystem->GetTileResolution();
+
+	// Tiles come from the world's shared cache — converted once per version for every map widget.
+	if (!TileCache.IsValid())
+	{
+		TileCache = UVCMapTileCache::Get(this);
+	}
+	UVCMapTileCache* Cache = TileCache.Get();
+	if (!Cache)
+	{
+		return;
+	}
 
-	// Display at 1:1 pixel ratio — texture size matches display size exactly.
-	// The canvas slot with AutoSize respects this, and the SizeBox clips
-	// the overflow to the visible MinimapSize square.
-	MapImage->SetBrushFromTexture(MapTexture);
-	MapImage->SetDesiredSizeOverride(FVector2D(static_cast<float>(TexSize), static_cast<float>(TexSize)));
+	auto ResolveTile = [Cache](const FIntPoint& TileCoord)
+	{
+		return Cache->MakeBlitSource(TileCoord, EVCMapBlitOrientation::WorldXRight, MinimapEmptyColor);
+	};
+
+	// The rect may straddle the ring's wrap seam — blit it in pieces that are contiguous in the texture.
+	for (int32 Y = Min.Y; Y < Min.Y + Size.Y;)
+	{
+		const int32 RingY = WrapRingIndex(Y, TexSize);
+		const int32 PieceH = FMath::Min(Min.Y + Size.Y - Y, TexSize - RingY);
+
+		for (int32 X = Min.X; X < Min.X + Size.X;)
+		{
+			const int32 RingX = WrapRingIndex(X, TexSize);
+			const int32 PieceW = FMath::Min(Min.X + Size.X - X, TexSize - RingX);
+
+			Blitter.Prepare(View, FIntPoint(X, Y), FIntPoint(PieceW, PieceH));
+			Blitter.ResolveTiles(ResolveTile);
+			Blitter.Blit(RingBuffer.GetPixels() + RingY * TexSize + RingX, TexSize);
+			RingBuffer.MarkDirty(FIntRect(RingX, RingY, RingX + PieceW, RingY + PieceH));
+
+			X += PieceW;
+		}
+		Y += PieceH;
+	}
 }
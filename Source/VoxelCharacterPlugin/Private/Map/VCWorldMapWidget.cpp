@@ -2,8 +2,13 @@
 
 #include "Map/VCWorldMapWidget.h"
 #include "Map/VCMapMarkerRegistry.h"
+#include "Map/VCMapMarkerLayer.h"
+#include "Map/VCMapTileCache.h"
+#include "Map/VCMapTrailRecorder.h"
 #include "VoxelMapSubsystem.h"
 #include "VoxelCharacterPlugin.h"
+#include "Core/VCBudgetWatchdog.h"
+#include "Core/VCPerfReport.h"
 #include "Blueprint/WidgetTree.h"
 #include "Components/CanvasPanel.h"
 #include "Components/CanvasPanelSlot.h"
@@ -55,6 +60,14 @@ void UVCWorldMapWidget::BuildWidgetTree()
 		MapSlot->SetAutoSize(true);
 	}
 
+	// Registry markers — one leaf widget over the whole canvas, drawn relative to its centre.
+	MarkerLayer = WidgetTree->ConstructWidget<UVCMapMarkerLayer>(UVCMapMarkerLayer::StaticClass(), TEXT("WorldMapMarkers"));
+	if (UCanvasPanelSlot* LayerSlot = RootCanvas->AddChildToCanvas(MarkerLayer))
+	{
+		LayerSlot->SetAnchors(FAnchors(0.0f, 0.0f, 1.0f, 1.0f));
+		LayerSlot->SetOffsets(FMargin(0.0f));
+	}
+
 	// Player marker (small colored dot)
 	PlayerMarker = WidgetTree->ConstructWidget<UImage>(UImage::StaticClass(), TEXT("PlayerMarker"));
 	PlayerMarker->SetColorAndOpacity(FLinearColor(1.0f, 0.2f, 0.2f, 1.0f));
@@ -117,9 +130,23 @@ void UVCWorldMapWidget::NativeConstruct()
 	// Bind to tile ready events so we can refresh while map is open
 	if (MapSubsystem.IsValid() && !TileReadyHandle.IsValid())
 	{
-		TileReadyHandle = MapSubsystem->OnMapTileReady.AddLambda([this](FIntPoint)
+		TileReadyHandle = MapSubsystem->OnMapTileReady.AddLambda([this](FIntPoint TileCoord)
 		{
-			bMapDirty = true;
+			ReadyTilesSinceRender.Add(TileCoord);
+		});
+	}
+
+	// Newly explored tiles redraw like ready ones (at any level, which queues the stale super-tile
+	// above them), and zoomed out, super-tiles built over the next frames are patched in as they land.
+	TileCache = UVCMapTileCache::Get(this);
+	if (TileCache.IsValid() && !RegionUpdatedHandle.IsValid())
+	{
+		RegionUpdatedHandle = TileCache->OnRegionUpdated.AddLambda([this](int32 Level, const FIntPoint& Coord)
+		{
+			if (Level == 0 || Level == RenderedLodLevel || (bProgressiveActive && Level == PendingLodLevel))
+			{
+				ReadyTilesSinceRender.Add(FIntPoint(Coord.X << Level, Coord.Y << Level));
+			}
 		});
 	}
 
@@ -143,6 +170,11 @@ void UVCWorldMapWidget::NativeDestruct()
 		MapSubsystem->OnMapTileReady.Remove(TileReadyHandle);
 		TileReadyHandle.Reset();
 	}
+	if (TileCache.IsValid() && RegionUpdatedHandle.IsValid())
+	{
+		TileCache->OnRegionUpdated.Remove(RegionUpdatedHandle);
+	}
+	RegionUpdatedHandle.Reset();
 
 	Super::NativeDestruct();
 }
@@ -151,20 +183,60 @@ void UVCWorldMapWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTim
 {
 	Super::NativeTick(MyGeometry, InDeltaTime);
 
+	VC_PERF_SCOPE(VCMap, WorldMapUpdate);
+
 	bool bViewChanged = false;
 	if (bMapDirty)
 	{
 		RebuildMapTexture();
 		bMapDirty = false;
+		bZoomDirty = false;
+		bPanDirty = false;
 		bViewChanged = true;
 	}
+	else
+	{
+		if (bZoomDirty)
+		{
+			// Rescaled preview now, refined texture over the next frames.
+			StartProgressiveRender();
+			bZoomDirty = false;
+			bPanDirty = false;
+			bViewChanged = true;
+		}
+		else if (bPanDirty)
+		{
+			// A pending refinement follows the pan, keeping its finished rows; otherwise scroll the ring.
+			if (bProgressiveActive)
+			{
+				PanProgressiveRender();
+			}
+			else
+			{
+				ScrollToPan();
+			}
+			bPanDirty = false;
+			bViewChanged = true;
+		}
+
+		if (bProgressiveActive)
+		{
+			ContinueProgressiveRender();
+		}
+		else if (ReadyTilesSinceRender.Num() > 0)
+		{
+			// Same view, new tile data — patch just those tiles' footprints.
+			UpdateReadyTiles();
+		}
+	}
 
 	UpdatePlayerMarker();
 
-	// Registry markers refresh on view changes and at a slow cadence otherwise (gathering runs
-	// deterministic placement over the whole visible area, which can be large when zoomed out).
+	// Registry markers refresh on view changes, when a worker-safe gather finishes, and at a slow
+	// cadence otherwise (stored markers are a grid lookup, but game-thread sources may be costly).
 	TimeSinceMarkerUpdate += InDeltaTime;
-	if (bViewChanged || TimeSinceMarkerUpdate >= FMath::Max(MarkerUpdateInterval, 0.1f))
+	const bool bAsyncMarkersReady = AsyncMarkers.Poll();
+	if (bViewChanged || bAsyncMarkersReady || TimeSinceMarkerUpdate >= FMath::Max(MarkerUpdateInterval, 0.1f))
 	{
 		TimeSinceMarkerUpdate = 0.0f;
 		UpdateMarkers();
@@ -180,7 +252,7 @@ FReply UVCWorldMapWidget::NativeOnMouseWheel(const FGeometry& InGeometry, const
 	const float Delta = InMouseEvent.GetWheelDelta();
 	const float ZoomFactor = (Delta > 0) ? 1.25f : 0.8f;
 	CurrentZoom = FMath::Clamp(CurrentZoom * ZoomFactor, MinZoom, MaxZoom);
-	bMapDirty = true;
+	bZoomDirty = true;
 	return FReply::Handled();
 }
 
@@ -217,7 +289,7 @@ FReply UVCWorldMapWidget::NativeOnMouseMove(const FGeometry& InGeometry, const F
 		// screen Y = world -X north). Content follows the mouse.
 		PanOffset.Y -= Delta.X * RenderedWorldPerPixel;
 		PanOffset.X += Delta.Y * RenderedWorldPerPixel;
-		bMapDirty = true;
+		bPanDirty = true;
 
 		return FReply::Handled();
 	}
@@ -228,24 +300,36 @@ FReply UVCWorldMapWidget::NativeOnMouseMove(const FGeometry& InGeometry, const F
 // Map Texture
 // ---------------------------------------------------------------------------
 
+// Non-negative V mod N — grid pixel coordinates are signed, ring texels are not.
+static FORCEINLINE int32 WrapMapRingIndex(int32 V, int32 N)
+{
+	const int32 R = V % N;
+	return R < 0 ? R + N : R;
+}
+
 void UVCWorldMapWidget::RefreshMap()
 {
 	bMapDirty = true;
 }
 
-void UVCWorldMapWidget::RebuildMapTexture()
+bool UVCWorldMapWidget::ComputeView(float Zoom, FVCMapBlitView& OutView, int32& OutLodLevel)
 {
 	UVoxelMapSubsystem* Subsystem = MapSubsystem.Get();
-	if (!Subsystem || !MapImage)
+	if (!TileCache.IsValid())
 	{
-		return;
+		TileCache = UVCMapTileCache::Get(this);
+	}
+	UVCMapTileCache* Cache = TileCache.Get();
+	if (!Subsystem || !Cache)
+	{
+		return false;
 	}
 
 	const float TileWorldSize = Subsystem->GetTileWorldSize();
 	const int32 TileResolution = Subsystem->GetTileResolution();
 	if (TileWorldSize <= 0.f || TileResolution <= 0)
 	{
-		return;
+		return false;
 	}
 
 	const int32 TexSize = FMath::Clamp(MapTextureFixedSize, 256, 2048);
@@ -253,130 +337,410 @@ void UVCWorldMapWidget::RebuildMapTexture()
 	// How many world units does the entire texture cover?
 	// At zoom=1, we show a "base" world radius. Zooming in shrinks the world area.
 	// Base: the texture covers ~32 tiles per side (reasonable default view).
-	const float BaseWorldExtent = 32.0f * TileWorldSize;  // world units from center to edge
-	const float ViewWorldExtent = BaseWorldExtent / CurrentZoom;  // shrinks as zoom increases
+	const double BaseWorldExtent = 32.0 * TileWorldSize;  // world units from center to edge
+	const double ViewWorldExtent = BaseWorldExtent / FMath::Max(Zoom, UE_KINDA_SMALL_NUMBER);
+	const double WorldPerPixel = (ViewWorldExtent * 2.0) / TexSize;
+
+	// Zoomed out, render from the super-tile level whose texel density matches the view, so the
+	// cost follows output pixels rather than the explored area. Level 0 is the tiles themselves.
+	OutLodLevel = Cache->SelectLodLevel(WorldPerPixel);
+
+	// NORTH-UP orientation: world +X (north) points up on the map (screen -Y), world +Y (east)
+	// points right (screen +X) — matching the minimap's compass convention. The grid is anchored
+	// at the world origin: grid pixel (I, J) covers world Y [I, I + 1) * WPP, world X (-J - 1, -J] * WPP.
+	OutView.Orientation = EVCMapBlitOrientation::NorthUp;
+	OutView.GridWorldOrigin = FVector2D::ZeroVector;
+	OutView.WorldPerPixel = WorldPerPixel;
+	OutView.TileGridOrigin = FVector2D(Subsystem->TileCoordToWorld(FIntPoint::ZeroValue));
+	OutView.TileWorldSize = TileWorldSize * static_cast<double>(1 << OutLodLevel);
+	OutView.TileResolution = TileResolution;
+	return true;
+}
 
-	// World units per pixel
-	RenderedWorldPerPixel = (ViewWorldExtent * 2.0f) / static_cast<float>(TexSize);
+FIntPoint UVCWorldMapWidget::ComputeViewOrigin(const FVCMapBlitView& View, int32 TexSize) const
+{
+	// Min corner of the TexSize x TexSize grid window centred on PanOffset.
+	const FIntPoint Center(
+		FMath::FloorToInt(PanOffset.Y / View.WorldPerPixel),
+		FMath::FloorToInt(-PanOffset.X / View.WorldPerPixel));
+	return Center - FIntPoint(TexSize / 2, TexSize / 2);
+}
 
-	// How many tiles from center to edge
-	RenderedTileRadius = FMath::CeilToInt(ViewWorldExtent / TileWorldSize);
-	RenderedCenterTile = Subsystem->WorldToTileCoord(FVector(PanOffset.X, PanOffset.Y, 0.0f));
+bool UVCWorldMapWidget::EnsureMapTexture(int32 TexSize)
+{
+	if (WorldMapTexture && WorldMapTexture->GetSizeX() == TexSize)
+	{
+		return true;
+	}
+
+	WorldMapTexture = UTexture2D::CreateTransient(TexSize, TexSize, PF_B8G8R8A8, TEXT("WorldMapTexture"));
+	if (!WorldMapTexture)
+	{
+		return false;
+	}
+	WorldMapTexture->Filter = TF_Bilinear;
+	WorldMapTexture->SRGB = true;
+	WorldMapTexture->CompressionSettings = TC_VectorDisplacementmap;
+	WorldMapTexture->AddressX = TA_Wrap;
+	WorldMapTexture->AddressY = TA_Wrap;
+
+	// Create the RHI resource once; rebuilds only push regions into it.
+	WorldMapTexture->UpdateResource();
+	MapBuffer.Reset(TexSize, TexSize);
+	return true;
+}
+
+void UVCWorldMapWidget::RebuildMapTexture()
+{
+	if (!MapImage)
+	{
+		return;
+	}
+	FVCBudgetScope Budget(EVCBudget::MapRefresh, GetOwningPlayerPawn());
+
+	FVCMapBlitView View;
+	int32 LodLevel = 0;
+	if (!ComputeView(CurrentZoom, View, LodLevel))
+	{
+		return;
+	}
+
+	const int32 TexSize = FMath::Clamp(MapTextureFixedSize, 256, 2048);
+	if (!EnsureMapTexture(TexSize))
+	{
+		return;
+	}
+
+	// A synchronous rebuild supersedes any refinement in flight and everything pending.
+	bProgressiveActive = false;
+	ReadyTilesSinceRender.Reset();
+
+	RenderedView = View;
+	RenderedLodLevel = LodLevel;
 	RenderedTexSize = TexSize;
+	RenderedWorldPerPixel = View.WorldPerPixel;
+	RingOrigin = ComputeViewOrigin(View, TexSize);
+
+	RasterizeMapRect(FIntRect(RingOrigin, RingOrigin + FIntPoint(TexSize, TexSize)));
+	MapBuffer.Flush(WorldMapTexture);
+
+	UpdateMapBrush();
+	UpdateMapImageTransform();
+}
+
+void UVCWorldMapWidget::ScrollToPan()
+{
+	const int32 TexSize = RenderedTexSize;
+	if (!WorldMapTexture || TexSize <= 0 || MapBuffer.GetWidth() != TexSize)
+	{
+		bMapDirty = true;
+		return;
+	}
+
+	// The texture is a ring over the world-anchored grid (like the minimap): panning keeps
+	// every texel in place and only rasterizes the rows / columns that scrolled into view.
+	const FIntPoint NewOrigin = ComputeViewOrigin(RenderedView, TexSize);
+	const FIntPoint Delta = NewOrigin - RingOrigin;
+	if (Delta == FIntPoint::ZeroValue)
+	{
+		UpdateMapImageTransform();
+		return;
+	}
 
-	// Create or recreate texture
-	if (!WorldMapTexture || WorldMapTexture->GetSizeX() != TexSize)
+	if (FMath::Abs(Delta.X) >= TexSize || FMath::Abs(Delta.Y) >= TexSize)
+	{
+		RasterizeMapRect(FIntRect(NewOrigin, NewOrigin + FIntPoint(TexSize, TexSize)));
+	}
+	else
 	{
-		WorldMapTexture = UTexture2D::CreateTransient(TexSize, TexSize, PF_B8G8R8A8, TEXT("WorldMapTexture"));
-		if (!WorldMapTexture)
+		if (Delta.X != 0)
 		{
-			return;
+			const int32 MinX = Delta.X > 0 ? RingOrigin.X + TexSize : NewOrigin.X;
+			RasterizeMapRect(FIntRect(MinX, NewOrigin.Y, MinX + FMath::Abs(Delta.X), NewOrigin.Y + TexSize));
+		}
+		if (Delta.Y != 0)
+		{
+			const int32 MinY = Delta.Y > 0 ? RingOrigin.Y + TexSize : NewOrigin.Y;
+			const int32 MinX = NewOrigin.X + FMath::Max(0, -Delta.X);
+			RasterizeMapRect(FIntRect(MinX, MinY, MinX + TexSize - FMath::Abs(Delta.X), MinY + FMath::Abs(Delta.Y)));
 		}
-		WorldMapTexture->Filter = TF_Bilinear;
-		WorldMapTexture->SRGB = true;
-		WorldMapTexture->CompressionSettings = TC_VectorDisplacementmap;
-		WorldMapTexture->AddressX = TA_Clamp;
-		WorldMapTexture->AddressY = TA_Clamp;
 	}
 
-	// Lock texture
-	FTexture2DMipMap& Mip = WorldMapTexture->GetPlatformData()->Mips[0];
-	void* TextureData = Mip.BulkData.Lock(LOCK_READ_WRITE);
-	if (!TextureData)
+	RingOrigin = NewOrigin;
+	MapBuffer.Flush(WorldMapTexture);
+
+	UpdateMapBrush();
+	UpdateMapImageTransform();
+}
+
+void UVCWorldMapWidget::StartProgressiveRender()
+{
+	FVCMapBlitView View;
+	int32 LodLevel = 0;
+	const int32 TexSize = RenderedTexSize;
+	if (!ComputeView(CurrentZoom, View, LodLevel) || !WorldMapTexture || TexSize <= 0)
 	{
+		bMapDirty = true;
 		return;
 	}
 
-	uint8* PixelData = static_cast<uint8*>(TextureData);
-	const int32 TotalPixels = TexSize * TexSize;
+	PendingView = View;
+	PendingLodLevel = LodLevel;
+	PendingOrigin = ComputeViewOrigin(View, TexSize);
+	PendingNextRow = 0;
+	PendingPixels.SetNumUninitialized(TexSize * TexSize);
+	bProgressiveActive = true;
+
+	// The displayed texture is scaled / shifted to the new view right away (see UpdateMapImageTransform).
+	RenderedWorldPerPixel = View.WorldPerPixel;
+	UpdateMapImageTransform();
+}
 
-	// Clear to fog of war
-	FMemory::Memset(PixelData, 0, TotalPixels * 4);
-	for (int32 i = 0; i < TotalPixels; ++i)
+void UVCWorldMapWidget::PanProgressiveRender()
+{
+	const int32 TexSize = RenderedTexSize;
+	if (PendingPixels.Num() != TexSize * TexSize)
 	{
-		PixelData[i * 4 + 0] = 10;  // B
-		PixelData[i * 4 + 1] = 10;  // G
-		PixelData[i * 4 + 2] = 10;  // R
-		PixelData[i * 4 + 3] = 255; // A
+		StartProgressiveRender();
+		return;
 	}
 
-	// The view center in world space
-	const float ViewCenterX = PanOffset.X;
-	const float ViewCenterY = PanOffset.Y;
+	// The preview follows the pan right away; the refinement's window moves with it.
+	UpdateMapImageTransform();
+	const FIntPoint NewOrigin = ComputeViewOrigin(PendingView, TexSize);
+	const FIntPoint Delta = NewOrigin - PendingOrigin;
+	if (Delta == FIntPoint::ZeroValue)
+	{
+		return;
+	}
+	PendingOrigin = NewOrigin;
 
-	// World bounds of the texture. NORTH-UP orientation: world +X (north) points up on the
-	// map (screen -Y), world +Y (east) points right (screen +X) — matching the minimap's
-	// compass convention.
-	const float WorldMaxX = ViewCenterX + ViewWorldExtent;
-	const float WorldMinY = ViewCenterY - ViewWorldExtent;
+	// Finished rows still in view are kept: old row R is new row R - Delta.Y, old column C new column C - Delta.X.
+	const int32 FirstKept = FMath::Max(0, Delta.Y);
+	const int32 EndKept = FMath::Min(PendingNextRow, TexSize + Delta.Y);
+	if (FMath::Abs(Delta.X) >= TexSize || EndKept <= FirstKept)
+	{
+		PendingNextRow = 0;
+		return;
+	}
+	const int32 NumKept = EndKept - FirstKept;
+	const int32 DstFirst = FirstKept - Delta.Y;
+	const int32 SrcCol = FMath::Max(0, Delta.X);
+	const int32 DstCol = FMath::Max(0, -Delta.X);
+	const int32 Width = TexSize - FMath::Abs(Delta.X);
+
+	// Rows move in the order that never overwrites one not yet moved.
+	FColor* Pixels = PendingPixels.GetData();
+	for (int32 Index = 0; Index < NumKept; ++Index)
+	{
+		const int32 Row = DstFirst <= FirstKept ? Index : NumKept - 1 - Index;
+		FMemory::Memmove(Pixels + (DstFirst + Row) * TexSize + DstCol, Pixels + (FirstKept + Row) * TexSize + SrcCol, Width * sizeof(FColor));
+	}
 
-	// Iterate visible tiles and blit them into the texture
-	for (int32 TY = -RenderedTileRadius; TY <= RenderedTileRadius; ++TY)
+	// What scrolled in beside and above the kept rows is one pan step's worth — render it now, so
+	// the rows finished stay one contiguous run from the top and the refinement continues below it.
+	if (Delta.X != 0)
+	{
+		const int32 MinX = Delta.X > 0 ? Width : 0;
+		RenderPendingRect(FIntRect(MinX, DstFirst, MinX + FMath::Abs(Delta.X), DstFirst + NumKept));
+	}
+	if (DstFirst > 0)
 	{
-		for (int32 TX = -RenderedTileRadius; TX <= RenderedTileRadius; ++TX)
+		RenderPendingRect(FIntRect(0, 0, TexSize, DstFirst));
+	}
+	PendingNextRow = DstFirst + NumKept;
+}
+
+bool UVCWorldMapWidget::RenderPendingRect(const FIntRect& Rect)
+{
+	UVCMapTileCache* Cache = TileCache.Get();
+	const int32 TexSize = RenderedTexSize;
+	if (!Cache || PendingPixels.Num() != TexSize * TexSize)
+	{
+		return false;
+	}
+
+	const int32 LodLevel = PendingLodLevel;
+	Blitter.Prepare(PendingView, PendingOrigin + Rect.Min, Rect.Size());
+	Blitter.ResolveTiles([Cache, LodLevel](const FIntPoint& Coord)
+	{
+		return Cache->MakeFogLodBlitSource(LodLevel, Coord, EVCMapBlitOrientation::NorthUp);
+	});
+	Blitter.Blit(PendingPixels.GetData() + Rect.Min.Y * TexSize + Rect.Min.X, TexSize);
+	return true;
+}
+
+void UVCWorldMapWidget::ContinueProgressiveRender()
+{
+	const int32 TexSize = RenderedTexSize;
+
+	// Render whole row bands until this frame's budget is spent (always at least one band).
+	static constexpr int32 RowsPerSlice = 32;
+	const double Deadline = FPlatformTime::Seconds() + FMath::Max(ProgressiveRenderBudgetMs, 0.1f) * 0.001;
+	while (PendingNextRow < TexSize)
+	{
+		const int32 NumRows = FMath::Min(RowsPerSlice, TexSize - PendingNextRow);
+		if (!RenderPendingRect(FIntRect(0, PendingNextRow, TexSize, PendingNextRow + NumRows)))
 		{
-			const FIntPoint TileCoord(RenderedCenterTile.X + TX, RenderedCenterTile.Y + TY);
+			bProgressiveActive = false;
+			bMapDirty = true;
+			return;
+		}
+		PendingNextRow += NumRows;
+		if (FPlatformTime::Seconds() >= Deadline)
+		{
+			break;
+		}
+	}
 
-			// Fog of war: skip unexplored
-			const bool bExplored = Subsystem->IsTileExplored(TileCoord);
-			const FVoxelMapTile* Tile = bExplored ? Subsystem->GetTile(TileCoord) : nullptr;
+	if (PendingNextRow < TexSize)
+	{
+		return;
+	}
 
-			if (!bExplored)
-			{
-				continue;
-			}
+	// Done — swap in: copy the linear result into ring order and upload it in one go.
+	FColor* Ring = MapBuffer.GetPixels();
+	const int32 RingX = WrapMapRingIndex(PendingOrigin.X, TexSize);
+	for (int32 Row = 0; Row < TexSize; ++Row)
+	{
+		FColor* DstRow = Ring + WrapMapRingIndex(PendingOrigin.Y + Row, TexSize) * TexSize;
+		const FColor* SrcRow = PendingPixels.GetData() + Row * TexSize;
+		FMemory::Memcpy(DstRow + RingX, SrcRow, (TexSize - RingX) * sizeof(FColor));
+		FMemory::Memcpy(DstRow, SrcRow + (TexSize - RingX), RingX * sizeof(FColor));
+	}
 
-			// World origin of this tile
-			const FVector TileWorldOrigin = Subsystem->TileCoordToWorld(TileCoord);
+	RenderedView = PendingView;
+	RenderedLodLevel = PendingLodLevel;
+	RenderedWorldPerPixel = PendingView.WorldPerPixel;
+	RingOrigin = PendingOrigin;
+	bProgressiveActive = false;
 
-			// For each pixel in the tile source, compute where it lands in the texture
-			const int32 SrcRes = Tile ? Tile->Resolution : TileResolution;
-			const float PixelWorldSize = TileWorldSize / SrcRes;
+	MapBuffer.MarkAllDirty();
+	MapBuffer.Flush(WorldMapTexture);
 
-			for (int32 PY = 0; PY < SrcRes; ++PY)
-			{
-				for (int32 PX = 0; PX < SrcRes; ++PX)
-				{
-					const float PixWorldX = TileWorldOrigin.X + PX * PixelWorldSize;
-					const float PixWorldY = TileWorldOrigin.Y + PY * PixelWorldSize;
-
-					// Map to texture pixel (north-up: east right, north up)
-					const int32 DstX = FMath::FloorToInt((PixWorldY - WorldMinY) / RenderedWorldPerPixel);
-					const int32 DstY = FMath::FloorToInt((WorldMaxX - PixWorldX) / RenderedWorldPerPixel);
-
-					if (DstX < 0 || DstX >= TexSize || DstY < 0 || DstY >= TexSize)
-					{
-						continue;
-					}
-
-					const int32 DstIdx = (DstY * TexSize + DstX) * 4;
-
-					if (Tile)
-					{
-						const FColor& SrcColor = Tile->PixelData[PY * SrcRes + PX];
-						PixelData[DstIdx + 0] = SrcColor.B;
-						PixelData[DstIdx + 1] = SrcColor.G;
-						PixelData[DstIdx + 2] = SrcColor.R;
-						PixelData[DstIdx + 3] = SrcColor.A;
-					}
-					else
-					{
-						// Explored but not generated — slightly lighter fog
-						PixelData[DstIdx + 0] = 25;
-						PixelData[DstIdx + 1] = 25;
-						PixelData[DstIdx + 2] = 25;
-						PixelData[DstIdx + 3] = 255;
-					}
-				}
-			}
+	UpdateMapBrush();
+	UpdateMapImageTransform();
+}
+
+void UVCWorldMapWidget::UpdateMapBrush()
+{
+	if (!MapImage || !WorldMapTexture || RenderedTexSize <= 0)
+	{
+		return;
+	}
+
+	// Ring offset: the brush's UV region starts at the texel of the view's min corner and
+	// tiling makes Slate sample with wrap addressing.
+	const int32 TexSize = RenderedTexSize;
+	const float U0 = static_cast<float>(WrapMapRingIndex(RingOrigin.X, TexSize)) / TexSize;
+	const float V0 = static_cast<float>(WrapMapRingIndex(RingOrigin.Y, TexSize)) / TexSize;
+
+	FSlateBrush Brush;
+	Brush.SetResourceObject(WorldMapTexture);
+	Brush.ImageSize = FVector2D(TexSize, TexSize);
+	Brush.Tiling = ESlateBrushTileType::Both;
+	Brush.SetUVRegion(FBox2f(FVector2f(U0, V0), FVector2f(U0 + 1.0f, V0 + 1.0f)));
+	MapImage->SetBrush(Brush);
+	MapImage->SetDesiredSizeOverride(FVector2D(TexSize, TexSize));
+}
+
+void UVCWorldMapWidget::UpdateMapImageTransform()
+{
+	if (!MapImage || RenderedTexSize <= 0 || RenderedWorldPerPixel <= 0.f)
+	{
+		return;
+	}
+
+	// World position of the texture's centre (a texel edge of the world-anchored grid).
+	const double TextureWPP = RenderedView.WorldPerPixel;
+	const double CenterY = (RingOrigin.X + RenderedTexSize / 2) * TextureWPP;
+	const double CenterX = -(RingOrigin.Y + RenderedTexSize / 2) * TextureWPP;
+
+	// Scale: texture world-per-pixel vs display (differs while a zoom is refining).
+	// Translation: bring PanOffset to the canvas centre, where the player / marker math puts it.
+	FWidgetTransform Transform;
+	Transform.Scale = FVector2D(TextureWPP / RenderedWorldPerPixel);
+	Transform.Translation = FVector2D(
+		-(PanOffset.Y - CenterY) / RenderedWorldPerPixel,
+		-(CenterX - PanOffset.X) / RenderedWorldPerPixel);
+	MapImage->SetRenderTransform(Transform);
+}
+
+void UVCWorldMapWidget::UpdateReadyTiles()
+{
+	const int32 TexSize = RenderedTexSize;
+	if (!WorldMapTexture || TexSize <= 0 || MapBuffer.GetWidth() != TexSize)
+	{
+		ReadyTilesSinceRender.Reset();
+		return;
+	}
+
+	// At a super-tile level several ready tiles share one footprint — redraw each once.
+	TSet<FIntPoint> DirtyCells;
+	for (const FIntPoint& TileCoord : ReadyTilesSinceRender)
+	{
+		DirtyCells.Add(FIntPoint(TileCoord.X >> RenderedLodLevel, TileCoord.Y >> RenderedLodLevel));
+	}
+	ReadyTilesSinceRender.Reset();
+
+	const FIntRect ViewRect(RingOrigin, RingOrigin + FIntPoint(TexSize, TexSize));
+	const double CellWorldSize = RenderedView.TileWorldSize;
+	const double WorldPerPixel = RenderedView.WorldPerPixel;
+	for (const FIntPoint& Cell : DirtyCells)
+	{
+		// Cell world rect -> grid rect (north-up: I from world Y, J from -world X).
+		const double CellMinX = RenderedView.TileGridOrigin.X + Cell.X * CellWorldSize;
+		const double CellMinY = RenderedView.TileGridOrigin.Y + Cell.Y * CellWorldSize;
+		const FIntRect Rect(
+			FMath::Max(ViewRect.Min.X, FMath::FloorToInt(CellMinY / WorldPerPixel)),
+			FMath::Max(ViewRect.Min.Y, FMath::FloorToInt(-(CellMinX + CellWorldSize) / WorldPerPixel)),
+			FMath::Min(ViewRect.Max.X, FMath::CeilToInt((CellMinY + CellWorldSize) / WorldPerPixel)),
+			FMath::Min(ViewRect.Max.Y, FMath::CeilToInt(-CellMinX / WorldPerPixel)));
+		if (Rect.Min.X < Rect.Max.X && Rect.Min.Y < Rect.Max.Y)
+		{
+			RasterizeMapRect(Rect);
 		}
 	}
 
-	Mip.BulkData.Unlock();
-	WorldMapTexture->UpdateResource();
+	MapBuffer.Flush(WorldMapTexture);
+}
 
-	MapImage->SetBrushFromTexture(WorldMapTexture);
-	MapImage->SetDesiredSizeOverride(FVector2D(TexSize, TexSize));
+void UVCWorldMapWidget::RasterizeMapRect(const FIntRect& GridRect)
+{
+	UVCMapTileCache* Cache = TileCache.Get();
+	const int32 TexSize = RenderedTexSize;
+	if (!Cache || TexSize <= 0 || MapBuffer.GetWidth() != TexSize)
+	{
+		return;
+	}
+
+	const int32 LodLevel = RenderedLodLevel;
+	auto ResolveTile = [Cache, LodLevel](const FIntPoint& Coord)
+	{
+		// Fog of war comes from the cache: unexplored is dark, explored but not generated slightly lighter.
+		return Cache->MakeFogLodBlitSource(LodLevel, Coord, EVCMapBlitOrientation::NorthUp);
+	};
+
+	// The rect may straddle the ring's wrap seam — blit it in pieces that are contiguous in the texture.
+	for (int32 Y = GridRect.Min.Y; Y < GridRect.Max.Y;)
+	{
+		const int32 RingY = WrapMapRingIndex(Y, TexSize);
+		const int32 PieceH = FMath::Min(GridRect.Max.Y - Y, TexSize - RingY);
+
+		for (int32 X = GridRect.Min.X; X < GridRect.Max.X;)
+		{
+			const int32 RingX = WrapMapRingIndex(X, TexSize);
+			const int32 PieceW = FMath::Min(GridRect.Max.X - X, TexSize - RingX);
+
+			Blitter.Prepare(RenderedView, FIntPoint(X, Y), FIntPoint(PieceW, PieceH));
+			Blitter.ResolveTiles(ResolveTile);
+			Blitter.Blit(MapBuffer.GetPixels() + RingY * TexSize + RingX, TexSize);
+			MapBuffer.MarkDirty(FIntRect(RingX, RingY, RingX + PieceW, RingY + PieceH));
+
+			X += PieceW;
+		}
+		Y += PieceH;
+	}
 }
 
 // ---------------------------------------------------------------------------
@@ -427,10 +791,11 @@ void UVCWorldMapWidget::UpdatePlayerMarker()
 
 void UVCWorldMapWidget::UpdateMarkers()
 {
-	if (!RootCanvas || !WidgetTree || RenderedTexSize <= 0 || RenderedWorldPerPixel <= 0.0f)
+	if (!MarkerLayer || RenderedTexSize <= 0 || RenderedWorldPerPixel <= 0.0f)
 	{
 		return;
 	}
+	FVCBudgetScope Budget(EVCBudget::MarkerGather, GetOwningPlayerPawn());
 
 	if (!MarkerRegistry.IsValid())
 	{
@@ -440,87 +805,112 @@ void UVCWorldMapWidget::UpdateMarkers()
 		}
 	}
 
-	TArray<FVCMapMarker> Markers;
+	// The rendered view: PanOffset-centred, RenderedTexSize pixels at RenderedWorldPerPixel.
+	const float ViewWorldExtent = 0.5f * RenderedTexSize * RenderedWorldPerPixel;
+	const FBox2D Area(PanOffset - FVector2D(ViewWorldExtent, ViewWorldExtent),
+		PanOffset + FVector2D(ViewWorldExtent, ViewWorldExtent));
+
+	UpdateTrail(Area);
+
+	ClusterScratch.Reset();
 	if (UVCMapMarkerRegistry* Registry = MarkerRegistry.Get())
 	{
-		// The rendered view: PanOffset-centred, RenderedTexSize pixels at RenderedWorldPerPixel.
-		const float ViewWorldExtent = 0.5f * RenderedTexSize * RenderedWorldPerPixel;
-		const FBox2D Area(PanOffset - FVector2D(ViewWorldExtent, ViewWorldExtent),
-			PanOffset + FVector2D(ViewWorldExtent, ViewWorldExtent));
-		Registry->GatherMarkers(Area, Markers);
+		// Markers merge per screen cluster cell, so zoomed out the widget count stays bounded
+		// and clusters split apart again as the user zooms in.
+		const double ClusterWorldSize = FMath::Max(MarkerClusterCellSize, 1.0f) * RenderedWorldPerPixel;
+
+		// Worker-safe sources (placement over the whole view) run on a task; cluster the latest
+		// finished set with the rest and pick up the next one when it lands.
+		AsyncMarkers.Request(*Registry, Area);
+		Registry->GatherMarkerClusters(Area, ClusterWorldSize, ClusterScratch, AsyncMarkers.GetMarkers());
 	}
 
-	Markers.Sort([](const FVCMapMarker& A, const FVCMapMarker& B) { return A.Priority > B.Priority; });
-
-	const float HalfTex = 0.5f * RenderedTexSize;
-
-	int32 Used = 0;
-	for (const FVCMapMarker& Marker : Markers)
+	// Cull to the map image first (sources may append outside the area), compacting the
+	// survivors to the front, then keep the highest-priority MaxMarkers of those.
+	const float HalfViewWorld = 0.5f * RenderedTexSize * RenderedWorldPerPixel;
+	int32 NumVisible = 0;
+	for (int32 i = 0; i < ClusterScratch.Num(); ++i)
 	{
-		if (Used >= MaxMarkers)
+		const FVector2D Offset = ClusterScratch[i].WorldPosition - PanOffset;
+		if (FMath::Abs(Offset.X) <= HalfViewWorld && FMath::Abs(Offset.Y) <= HalfViewWorld)
 		{
-			break;
+			if (i != NumVisible)
+			{
+				Swap(ClusterScratch[NumVisible], ClusterScratch[i]);
+			}
+			++NumVisible;
 		}
+	}
 
-		// Same mapping as the player marker (north-up: east right, north up).
-		const FVector2D PixelOffset(
-			(Marker.WorldPosition.Y - PanOffset.Y) / RenderedWorldPerPixel,
-			(PanOffset.X - Marker.WorldPosition.X) / RenderedWorldPerPixel);
-		if (FMath::Abs(PixelOffset.X) > HalfTex || FMath::Abs(PixelOffset.Y) > HalfTex)
-		{
-			continue; // outside the map image
-		}
+	const int32 NumSelected = UVCMapMarkerRegistry::SelectHighestPriority(
+		MakeArrayView(ClusterScratch.GetData(), NumVisible), MaxMarkers);
+
+	TArray<FVCMapMarkerDraw>& Draws = MarkerLayer->EditMarkers();
+	Draws.Reset();
+	for (int32 ClusterIndex = NumSelected - 1; ClusterIndex >= 0; --ClusterIndex)
+	{
+		const FVCMapMarkerCluster& Cluster = ClusterScratch[ClusterIndex];
+		const bool bIsCluster = Cluster.Count > 1;
+
+		// Same mapping as the player marker (north-up: east right, north up). Lowest priority
+		// first so the highest draws on top. Clusters draw a larger dot in their top member's
+		// colour with the member count as the label.
+		FVCMapMarkerDraw& Draw = Draws.AddDefaulted_GetRef();
+		Draw.Offset = FVector2D(
+			(Cluster.WorldPosition.Y - PanOffset.Y) / RenderedWorldPerPixel,
+			(PanOffset.X - Cluster.WorldPosition.X) / RenderedWorldPerPixel);
+		Draw.Size = bIsCluster ? MarkerDotSize * 1.75f : MarkerDotSize;
+		Draw.Color = Cluster.Representative.Color;
+		Draw.Label = bIsCluster ? FText::AsNumber(Cluster.Count) : Cluster.Representative.Label;
+	}
+	MarkerLayer->CommitMarkers();
+	Budget.Count = Draws.Num();
+}
+
+void UVCWorldMapWidget::UpdateTrail(const FBox2D& ViewArea)
+{
+	TArray<FVCMapMarkerPolyline>& Lines = MarkerLayer->EditPolylines();
+	int32 NumLines = 0;
 
-		// Pool: dot + label per slot, created on demand.
-		if (!MarkerDots.IsValidIndex(Used))
+	const UVCMapTrailRecorder* Recorder = bShowTrail ? UVCMapTrailRecorder::Get(this) : nullptr;
+	const FVCMapTrail* Trail = Recorder ? Recorder->GetTrail(GetOwningPlayer()) : nullptr;
+	if (Trail)
+	{
+		// Vertices closer than a pixel add nothing at this zoom; only chunks overlapping the
+		// view are decoded. Entries (and their point arrays) are reused between refreshes.
+		const double MinStepSq = FMath::Square(RenderedWorldPerPixel);
+		Trail->ForEachStripInArea(ViewArea, [&](TConstArrayView<FVector2D> Strip)
 		{
-			UImage* Dot = WidgetTree->ConstructWidget<UImage>(UImage::StaticClass());
-			Dot->SetDesiredSizeOverride(FVector2D(MarkerDotSize, MarkerDotSize));
-			if (UCanvasPanelSlot* DotSlot = RootCanvas->AddChildToCanvas(Dot))
+			if (NumLines == Lines.Num())
 			{
-				DotSlot->SetAnchors(FAnchors(0.5f, 0.5f, 0.5f, 0.5f));
-				DotSlot->SetAlignment(FVector2D(0.5f, 0.5f));
-				DotSlot->SetAutoSize(true);
+				Lines.AddDefaulted();
 			}
-			MarkerDots.Add(Dot);
+			FVCMapMarkerPolyline& Line = Lines[NumLines++];
+			Line.Color = TrailColor;
+			Line.Thickness = TrailThickness;
+			Line.Points.Reset();
 
-			UTextBlock* Label = WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass());
-			FSlateFontInfo Font = Label->GetFont();
-			Font.Size = 9;
-			Label->SetFont(Font);
-			if (UCanvasPanelSlot* LabelSlot = RootCanvas->AddChildToCanvas(Label))
+			FVector2D Prev = Strip[0];
+			for (int32 i = 0; i < Strip.Num(); ++i)
 			{
-				LabelSlot->SetAnchors(FAnchors(0.5f, 0.5f, 0.5f, 0.5f));
-				LabelSlot->SetAlignment(FVector2D(0.0f, 0.5f));
-				LabelSlot->SetAutoSize(true);
-			}
-			MarkerLabels.Add(Label);
-		}
-
-		UImage* Dot = MarkerDots[Used];
-		Dot->SetVisibility(ESlateVisibility::HitTestInvisible);
-		Dot->SetColorAndOpacity(Marker.Color);
-		if (UCanvasPanelSlot* DotSlot = Cast<UCanvasPanelSlot>(Dot->Slot))
-		{
-			DotSlot->SetPosition(PixelOffset);
-		}
-
-		UTextBlock* Label = MarkerLabels[Used];
-		Label->SetVisibility(Marker.Label.IsEmpty() ? ESlateVisibility::Collapsed : ESlateVisibility::HitTestInvisible);
-		Label->SetText(Marker.Label);
-		Label->SetColorAndOpacity(FSlateColor(Marker.Color));
-		if (UCanvasPanelSlot* LabelSlot = Cast<UCanvasPanelSlot>(Label->Slot))
-		{
-			LabelSlot->SetPosition(PixelOffset + FVector2D(0.75f * MarkerDotSize + 2.0f, 0.0f));
-		}
+				const FVector2D& W = Strip[i];
+				if (i > 0 && i < Strip.Num() - 1 && FVector2D::DistSquared(W, Prev) < MinStepSq)
+				{
+					continue;
+				}
+				Prev = W;
 
-		++Used;
+				// North-up, as the markers.
+				Line.Points.Add(FVector2f(
+					(W.Y - PanOffset.Y) / RenderedWorldPerPixel,
+					(PanOffset.X - W.X) / RenderedWorldPerPixel));
+			}
+		});
 	}
 
-	// Hide the unused tail of the pools.
-	for (int32 i = Used; i < MarkerDots.Num(); ++i)
+	// Drop entries past the used count without freeing the arrays of the ones kept.
+	while (Lines.Num() > NumLines)
 	{
-		MarkerDots[i]->SetVisibility(ESlateVisibility::Collapsed);
-		MarkerLabels[i]->SetVisibility(ESlateVisibility::Collapsed);
+		Lines.Pop();
 	}
 }
@@ -7,6 +7,8 @@
 #include "VoxelEditManager.h"
 #include "VoxelEditTypes.h"
 #include "VoxelCharacterPlugin.h"
+#include "Core/VCBudgetWatchdog.h"
+#include "Core/VCPerfReport.h"
 #include "GameplayEffectTypes.h"
 
 UVCMovementComponent::UVCMovementComponent()
@@ -199,11 +201,15 @@ void UVCMovementComponent::PhysSwimming(float DeltaTime, int32 Iterations)
 
 void UVCMovementComponent::UpdateVoxelTerrainContext()
 {
+	VC_PERF_SCOPE(VCMovement, TerrainContext);
+
 	const AActor* Owner = GetOwner();
 	if (!Owner)
 	{
 		return;
 	}
+	FVCBudgetScope Budget(EVCBudget::TerrainRefresh, Owner);
+	Budget.Location = Owner->GetActorLocation();
 
 	// Query voxel terrain at the character's feet position
 	const float HalfHeight = Owner->GetSimpleCollisionHalfHeight();
@@ -279,6 +285,8 @@ void UVCMovementComponent::UpdateVoxelTerrainContext()
 
 void UVCMovementComponent::FindFloor(const FVector& CapsuleLocation, FFindFloorResult& OutFloorResult, bool bCanUseCachedLocation, const FHitResult* DownwardSweepResult) const
 {
+	VC_PERF_SCOPE(VCMovement, FindFloor);
+
 	Super::FindFloor(CapsuleLocation, OutFloorResult, bCanUseCachedLocation, DownwardSweepResult);
 
 	// --- Handle inverted normals from double-sided voxel trimesh collision ---
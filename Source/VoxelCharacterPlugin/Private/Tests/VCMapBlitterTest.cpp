@@ -0,0 +1,305 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#include "Map/VCMapBlitter.h"
+#include "Map/VCMapTileCache.h"
+#include "VoxelMapSubsystem.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Map rasterization regression test + benchmark (automation test VoxelCharacter.Map.Blitter).
+ *
+ * Feeds synthetic FVoxelMapTile data through FVCMapBlitter — the core of both widgets' texture
+ * rebuilds — over a matrix of orientations, zoom levels, view sizes and explored ratios. Each
+ * case must match a naive per-pixel rasterizer that follows the grid definition in
+ * FVCMapBlitView pixel for pixel, and the CRC golden below; ns/pixel is reported per case.
+ * CPU only, no world or RHI needed, so it runs headless:
+ *
+ *   UnrealEditor-Cmd <project> -ExecCmds="Automation RunTests VoxelCharacter.Map.Blitter; Quit" -nullrhi -unattended
+ */
+namespace VCMapBlitterTest
+{
+	static constexpr int32 TileResolution = 64;
+	static constexpr double TileWorldSize = 6400.0;
+
+	/** Timed runs per case; kept low so the test stays quick in CI. */
+	static constexpr int32 Iterations = 5;
+
+	/**
+	 * CRC32 of each case's output (the reference rasterizer's, which the blitter must match).
+	 * They change only with the synthetic tiles, the view setup or the grid definition — never
+	 * with a blitter optimization. A failing case logs the CRC it produced.
+	 */
+	struct FGolden
+	{
+		const TCHAR* Name;
+		uint32 Crc;
+	};
+
+	static const FGolden Goldens[] =
+	{
+		{ TEXT("XRight_z0.37_128_e0"), 0xfb2578ab },
+		{ TEXT("XRight_z0.37_128_e50"), 0xce344fcc },
+		{ TEXT("XRight_z0.37_128_e100"), 0xbf3ba44b },
+		{ TEXT("XRight_z0.37_512_e0"), 0x2f762d6c },
+		{ TEXT("XRight_z0.37_512_e50"), 0x13059db3 },
+		{ TEXT("XRight_z0.37_512_e100"), 0xd328bbf5 },
+		{ TEXT("XRight_z1.00_128_e0"), 0xfb2578ab },
+		{ TEXT("XRight_z1.00_128_e50"), 0x0a144038 },
+		{ TEXT("XRight_z1.00_128_e100"), 0x799a0ecf },
+		{ TEXT("XRight_z1.00_512_e0"), 0x2f762d6c },
+		{ TEXT("XRight_z1.00_512_e50"), 0x7984cd07 },
+		{ TEXT("XRight_z1.00_512_e100"), 0x1ab1929d },
+		{ TEXT("XRight_z2.50_128_e0"), 0xfb2578ab },
+		{ TEXT("XRight_z2.50_128_e50"), 0x18c64556 },
+		{ TEXT("XRight_z2.50_128_e100"), 0xfa7f77f0 },
+		{ TEXT("XRight_z2.50_512_e0"), 0x2f762d6c },
+		{ TEXT("XRight_z2.50_512_e50"), 0x1e8f9bd0 },
+		{ TEXT("XRight_z2.50_512_e100"), 0x36786114 },
+		{ TEXT("NorthUp_z0.37_128_e0"), 0xfb2578ab },
+		{ TEXT("NorthUp_z0.37_128_e50"), 0x5a133521 },
+		{ TEXT("NorthUp_z0.37_128_e100"), 0xc3b305a7 },
+		{ TEXT("NorthUp_z0.37_512_e0"), 0x2f762d6c },
+		{ TEXT("NorthUp_z0.37_512_e50"), 0xda760c4b },
+		{ TEXT("NorthUp_z0.37_512_e100"), 0xf59bc87a },
+		{ TEXT("NorthUp_z1.00_128_e0"), 0xfb2578ab },
+		{ TEXT("NorthUp_z1.00_128_e50"), 0x00e8de0d },
+		{ TEXT("NorthUp_z1.00_128_e100"), 0x7020eed0 },
+		{ TEXT("NorthUp_z1.00_512_e0"), 0x2f762d6c },
+		{ TEXT("NorthUp_z1.00_512_e50"), 0x191c7272 },
+		{ TEXT("NorthUp_z1.00_512_e100"), 0xa57c422d },
+		{ TEXT("NorthUp_z2.50_128_e0"), 0xfb2578ab },
+		{ TEXT("NorthUp_z2.50_128_e50"), 0x2f860241 },
+		{ TEXT("NorthUp_z2.50_128_e100"), 0xd7813cd3 },
+		{ TEXT("NorthUp_z2.50_512_e0"), 0x2f762d6c },
+		{ TEXT("NorthUp_z2.50_512_e50"), 0x4d1e798b },
+		{ TEXT("NorthUp_z2.50_512_e100"), 0x0074c59f },
+	};
+
+	struct FCase
+	{
+		EVCMapBlitOrientation Orientation = EVCMapBlitOrientation::WorldXRight;
+		/** Destination pixels per source texel edge (< 1 = zoomed out). */
+		double Zoom = 1.0;
+		int32 Size = 256;
+		/** Fraction of tiles with data; the rest are unexplored fills. */
+		float ExploredRatio = 1.0f;
+
+		FString GetName() const
+		{
+			return FString::Printf(TEXT("%s_z%.2f_%d_e%d"),
+				Orientation == EVCMapBlitOrientation::NorthUp ? TEXT("NorthUp") : TEXT("XRight"),
+				Zoom, Size, FMath::RoundToInt(ExploredRatio * 100.0f));
+		}
+	};
+
+	static const FGolden* FindGolden(const FString& Name)
+	{
+		for (const FGolden& Golden : Goldens)
+		{
+			if (Name == Golden.Name)
+			{
+				return &Golden;
+			}
+		}
+		return nullptr;
+	}
+
+	static uint32 HashTile(const FIntPoint& Coord)
+	{
+		return HashCombine(GetTypeHash(Coord.X * 73856093), GetTypeHash(Coord.Y * 19349663));
+	}
+
+	/** Deterministic tile contents: a per-tile gradient with a texel checker, unique per coordinate. */
+	static const FVoxelMapTile& GetSyntheticTile(TMap<FIntPoint, FVoxelMapTile>& Tiles, const FIntPoint& Coord)
+	{
+		if (const FVoxelMapTile* Existing = Tiles.Find(Coord))
+		{
+			return *Existing;
+		}
+
+		FVoxelMapTile& Tile = Tiles.Add(Coord);
+		Tile.Resolution = TileResolution;
+		Tile.PixelData.SetNumUninitialized(TileResolution * TileResolution);
+		const uint32 Seed = HashTile(Coord);
+		for (int32 PY = 0; PY < TileResolution; ++PY)
+		{
+			for (int32 PX = 0; PX < TileResolution; ++PX)
+			{
+				Tile.PixelData[PY * TileResolution + PX] = FColor(
+					static_cast<uint8>((Seed & 0xFF) ^ (PX * 4)),
+					static_cast<uint8>(((Seed >> 8) & 0xFF) ^ (PY * 4)),
+					static_cast<uint8>(((PX ^ PY) & 1) ? 255 : (Seed >> 16) & 0xFF),
+					255);
+			}
+		}
+		return Tile;
+	}
+
+	static bool IsExplored(const FIntPoint& Coord, float Ratio)
+	{
+		return (HashTile(Coord) % 1000u) < static_cast<uint32>(Ratio * 1000.0f);
+	}
+
+	static FVCMapBlitView MakeView(const FCase& Case)
+	{
+		FVCMapBlitView View;
+		View.Orientation = Case.Orientation;
+		View.TileGridOrigin = FVector2D(-1000.0, 500.0);
+		View.TileWorldSize = TileWorldSize;
+		View.TileResolution = TileResolution;
+		View.WorldPerPixel = (TileWorldSize / TileResolution) / Case.Zoom;
+
+		// Off-grid and straddling tile (0, 0), so spans start mid-tile and coordinates go negative.
+		const double HalfExtent = 0.5 * Case.Size * View.WorldPerPixel;
+		View.GridWorldOrigin = Case.Orientation == EVCMapBlitOrientation::WorldXRight
+			? FVector2D(-HalfExtent + 137.0, -HalfExtent - 311.0)
+			: FVector2D(HalfExtent + 137.0, -HalfExtent - 311.0);
+		return View;
+	}
+
+	/** Per-pixel rasterizer straight from the FVCMapBlitView grid definition. */
+	static void RasterizeReference(const FVCMapBlitView& View, int32 Size, float ExploredRatio,
+		TMap<FIntPoint, FVoxelMapTile>& Tiles, TArray<FColor>& Out)
+	{
+		const double TexelWorldSize = View.TileWorldSize / View.TileResolution;
+		const bool bNorthUp = View.Orientation == EVCMapBlitOrientation::NorthUp;
+
+		Out.SetNumUninitialized(Size * Size);
+		for (int32 J = 0; J < Size; ++J)
+		{
+			for (int32 I = 0; I < Size; ++I)
+			{
+				const double LocalX = bNorthUp
+					? View.GridWorldOrigin.X + -1.0 * (J + 0.5) * View.WorldPerPixel - View.TileGridOrigin.X
+					: View.GridWorldOrigin.X + (I + 0.5) * View.WorldPerPixel - View.TileGridOrigin.X;
+				const double LocalY = bNorthUp
+					? View.GridWorldOrigin.Y + (I + 0.5) * View.WorldPerPixel - View.TileGridOrigin.Y
+					: View.GridWorldOrigin.Y + (J + 0.5) * View.WorldPerPixel - View.TileGridOrigin.Y;
+
+				const FIntPoint Coord(FMath::FloorToInt(LocalX / View.TileWorldSize), FMath::FloorToInt(LocalY / View.TileWorldSize));
+				FColor& Pixel = Out[J * Size + I];
+				if (!IsExplored(Coord, ExploredRatio))
+				{
+					Pixel = UVCMapTileCache::UnexploredColor;
+					continue;
+				}
+
+				const int32 PX = FMath::Clamp(FMath::FloorToInt((LocalX - Coord.X * View.TileWorldSize) / TexelWorldSize), 0, View.TileResolution - 1);
+				const int32 PY = FMath::Clamp(FMath::FloorToInt((LocalY - Coord.Y * View.TileWorldSize) / TexelWorldSize), 0, View.TileResolution - 1);
+				Pixel = GetSyntheticTile(Tiles, Coord).PixelData[PY * View.TileResolution + PX];
+			}
+		}
+	}
+
+	static int32 CountMismatched(const TArray<FColor>& Output, const TArray<FColor>& Reference)
+	{
+		int32 NumMismatched = 0;
+		for (int32 i = 0; i < Output.Num(); ++i)
+		{
+			NumMismatched += Output[i] != Reference[i] ? 1 : 0;
+		}
+		return NumMismatched;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVCMapBlitterTest, "VoxelCharacter.Map.Blitter",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FVCMapBlitterTest::RunTest(const FString& Parameters)
+{
+	using namespace VCMapBlitterTest;
+
+	TArray<FCase> Cases;
+	for (EVCMapBlitOrientation Orientation : { EVCMapBlitOrientation::WorldXRight, EVCMapBlitOrientation::NorthUp })
+	{
+		for (double Zoom : { 0.37, 1.0, 2.5 })
+		{
+			for (int32 Size : { 128, 512 })
+			{
+				for (float Explored : { 0.0f, 0.5f, 1.0f })
+				{
+					Cases.Add({ Orientation, Zoom, Size, Explored });
+				}
+			}
+		}
+	}
+
+	TMap<FIntPoint, FVoxelMapTile> Tiles;
+	TArray<FColor> Reference;
+	TArray<FColor> Output;
+	FVCMapBlitter Blitter;
+
+	for (const FCase& Case : Cases)
+	{
+		const FString Name = Case.GetName();
+		const FVCMapBlitView View = MakeView(Case);
+		const FIntPoint Size(Case.Size, Case.Size);
+		auto Resolve = [&Tiles, &Case](const FIntPoint& Coord)
+		{
+			return IsExplored(Coord, Case.ExploredRatio)
+				? FVCMapBlitSource::MakeFromTile(GetSyntheticTile(Tiles, Coord), Case.Orientation)
+				: FVCMapBlitSource::MakeFill(UVCMapTileCache::UnexploredColor);
+		};
+
+		RasterizeReference(View, Case.Size, Case.ExploredRatio, Tiles, Reference);
+
+		// Correctness: parallel Blit and a single-threaded BlitRows must both match the reference.
+		Blitter.Prepare(View, FIntPoint::ZeroValue, Size);
+		Blitter.ResolveTiles(Resolve);
+		Output.SetNumZeroed(Case.Size * Case.Size);
+		Blitter.Blit(Output.GetData(), Case.Size);
+		const int32 BlitMismatched = CountMismatched(Output, Reference);
+		FMemory::Memzero(Output.GetData(), Output.Num() * sizeof(FColor));
+		Blitter.BlitRows(Output.GetData(), Case.Size, 0, Case.Size);
+		const int32 RowsMismatched = CountMismatched(Output, Reference);
+		if (BlitMismatched > 0 || RowsMismatched > 0)
+		{
+			AddError(FString::Printf(TEXT("%s: %d (Blit) / %d (BlitRows) pixels differ from the reference rasterizer"),
+				*Name, BlitMismatched, RowsMismatched));
+		}
+
+		const uint32 Crc = FCrc::MemCrc32(Reference.GetData(), Reference.Num() * sizeof(FColor));
+		const FGolden* Golden = FindGolden(Name);
+		if (!Golden)
+		{
+			AddError(FString::Printf(TEXT("%s: no golden (crc %08x)"), *Name, Crc));
+		}
+		else if (Golden->Crc != Crc)
+		{
+			AddError(FString::Printf(TEXT("%s: crc %08x, golden %08x"), *Name, Crc, Golden->Crc));
+		}
+
+		// Timing: table build + tile resolve, then the blit itself (serial and as configured).
+		const uint64 PrepareStart = FPlatformTime::Cycles64();
+		for (int32 It = 0; It < Iterations; ++It)
+		{
+			Blitter.Prepare(View, FIntPoint::ZeroValue, Size);
+			Blitter.ResolveTiles(Resolve);
+		}
+		const uint64 SerialStart = FPlatformTime::Cycles64();
+		for (int32 It = 0; It < Iterations; ++It)
+		{
+			Blitter.BlitRows(Output.GetData(), Case.Size, 0, Case.Size);
+		}
+		const uint64 BlitStart = FPlatformTime::Cycles64();
+		for (int32 It = 0; It < Iterations; ++It)
+		{
+			Blitter.Blit(Output.GetData(), Case.Size);
+		}
+		const uint64 End = FPlatformTime::Cycles64();
+
+		const double NsPerPixel = 1.0e9 / (static_cast<double>(Iterations) * Case.Size * Case.Size);
+		AddInfo(FString::Printf(TEXT("%-24s prepare %6.2f ns/px  serial %6.2f ns/px  blit %6.2f ns/px"),
+			*Name,
+			FPlatformTime::ToSeconds64(SerialStart - PrepareStart) * NsPerPixel,
+			FPlatformTime::ToSeconds64(BlitStart - SerialStart) * NsPerPixel,
+			FPlatformTime::ToSeconds64(End - BlitStart) * NsPerPixel));
+	}
+
+	return !HasAnyErrors();
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
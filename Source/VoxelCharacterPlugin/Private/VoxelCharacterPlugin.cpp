@@ -1,15 +1,27 @@
 #include "VoxelCharacterPlugin.h"
+#include "VoxelCharacterStats.h"
+#include "Core/VCPerfReport.h"
 
 DEFINE_LOG_CATEGORY(LogVoxelCharacter);
 
+CSV_DEFINE_CATEGORY_MODULE(VOXELCHARACTERPLUGIN_API, VCEdits, true);
+CSV_DEFINE_CATEGORY_MODULE(VOXELCHARACTERPLUGIN_API, VCMovement, true);
+CSV_DEFINE_CATEGORY_MODULE(VOXELCHARACTERPLUGIN_API, VCCamera, true);
+CSV_DEFINE_CATEGORY_MODULE(VOXELCHARACTERPLUGIN_API, VCMap, true);
+CSV_DEFINE_CATEGORY_MODULE(VOXELCHARACTERPLUGIN_API, VCSpawn, true);
+CSV_DEFINE_CATEGORY_MODULE(VOXELCHARACTERPLUGIN_API, VCStress, true);
+CSV_DEFINE_CATEGORY_MODULE(VOXELCHARACTERPLUGIN_API, VCNet, true);
+
 #define LOCTEXT_NAMESPACE "FVoxelCharacterPluginModule"
 
 void FVoxelCharacterPluginModule::StartupModule()
 {
+	FVCPerfCapture::StartSessionFromCommandLine();
 }
 
 void FVoxelCharacterPluginModule::ShutdownModule()
 {
+	FVCPerfCapture::Shutdown();
 }
 
 #undef LOCTEXT_NAMESPACE
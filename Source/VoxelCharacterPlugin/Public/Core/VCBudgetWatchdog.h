@@ -0,0 +1,113 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Plugin systems with a per-frame millisecond budget (vc.Budget.<Name>Ms). */
+enum class EVCBudget : uint8
+{
+	/** UVCMovementComponent terrain context refresh. */
+	TerrainRefresh,
+	/** UVCCameraManager::UpdateCamera (mode blend + collision). */
+	Camera,
+	/** UVCUnderwaterPostProcess tick. */
+	UnderwaterPP,
+	/** Minimap / world map texture refresh. */
+	MapRefresh,
+	/** Minimap / world map marker gather + layout. */
+	MarkerGather,
+	/** Server-side voxel edit application. */
+	EditApply,
+
+	Num
+};
+
+/** One over-budget scope, with whatever context its call site supplied. */
+struct FVCBudgetEvent
+{
+	EVCBudget Budget = EVCBudget::Num;
+	float Milliseconds = 0.0f;
+	float BudgetMilliseconds = 0.0f;
+	uint64 Frame = 0;
+	double Time = 0.0;
+
+	/** Context object's name (character, widget owner), if any. */
+	FString Context;
+
+	/** Voxel chunk of the context location, if the scope had one. */
+	FIntVector Chunk = FIntVector::ZeroValue;
+	bool bHasChunk = false;
+
+	/** Call-site count (markers, tiles, chunks edited), INDEX_NONE if none. */
+	int32 Count = INDEX_NONE;
+};
+
+/**
+ * Per-subsystem frame budget watchdog.
+ *
+ * Each watched system times itself with an FVCBudgetScope. A scope that runs past its system's
+ * budget (vc.Budget.<Name>Ms; 0 disables one) records an FVCBudgetEvent into a fixed ring, so
+ * a production spike shows which system blew up, for which character / chunk / marker count.
+ * `vc.Budget.Dump` logs the ring and per-system totals; `vc.Budget.Reset` clears them.
+ * Overruns also appear as CSV events and in FVCPerfCapture reports (VCBudget/<Name>).
+ *
+ * Costs two cycle reads per scope when within budget. Game thread only (other threads are ignored).
+ */
+class VOXELCHARACTERPLUGIN_API FVCBudgetWatchdog
+{
+public:
+	/** Events kept; older ones are overwritten. */
+	static constexpr int32 RingCapacity = 256;
+
+	/** Budget in ms for a system (0 = unwatched), or always 0 while vc.Budget.Enable is 0. */
+	static float GetBudgetMs(EVCBudget Budget);
+
+	/** Record an overrun (called by FVCBudgetScope). */
+	static void RecordOverrun(FVCBudgetEvent&& Event);
+
+	/** Log the newest MaxEvents events (newest first) and per-system overrun totals. */
+	static void DumpToLog(int32 MaxEvents = RingCapacity);
+
+	/** Clear events and totals. */
+	static void Reset();
+
+	static const TCHAR* GetBudgetName(EVCBudget Budget);
+
+private:
+	static TArray<FVCBudgetEvent> Ring;
+	static int32 RingNext;
+	static int64 OverrunCounts[static_cast<int32>(EVCBudget::Num)];
+	static float WorstMs[static_cast<int32>(EVCBudget::Num)];
+};
+
+/**
+ * Times its scope against a system budget. Fill in context on the scope as the call site
+ * learns it; it is only read (and the chunk resolved) when the budget was exceeded.
+ *
+ *   FVCBudgetScope Budget(EVCBudget::MarkerGather, GetOwningPlayerPawn());
+ *   ...
+ *   Budget.Count = Draws.Num();
+ */
+class VOXELCHARACTERPLUGIN_API FVCBudgetScope
+{
+public:
+	FVCBudgetScope(EVCBudget InBudget, const UObject* InContext);
+	~FVCBudgetScope();
+
+	FVCBudgetScope(const FVCBudgetScope&) = delete;
+	FVCBudgetScope& operator=(const FVCBudgetScope&) = delete;
+
+	/** Object the work was for (character, widget owner); its name goes in the event. */
+	const UObject* Context = nullptr;
+
+	/** World location of the work, reported as its voxel chunk. */
+	TOptional<FVector> Location;
+
+	/** Call-site count (markers, tiles, chunks edited). */
+	int32 Count = INDEX_NONE;
+
+private:
+	EVCBudget Budget;
+	uint64 StartCycles = 0;
+};
@@ -32,6 +32,8 @@ public:
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 	virtual void PreAttributeChange(const FGameplayAttribute& Attribute, float& NewValue) override;
 	virtual void PostGameplayEffectExecute(const FGameplayEffectModCallbackData& Data) override;
+	virtual void PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue) override;
+	virtual void PostAttributeBaseChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue) const override;
 
 	// ==================== Vitals ====================
 
@@ -88,4 +90,8 @@ protected:
 	void OnRep_MiningSpeed(const FGameplayAttributeData& OldValue);
 	UFUNCTION()
 	void OnRep_InteractionRange(const FGameplayAttributeData& OldValue);
+
+private:
+	/** Server: account a changed replicated value (base or current) for UVCNetTrafficTracker. */
+	void RecordReplicatedChange(const FGameplayAttribute& Attribute, bool bBaseValue) const;
 };
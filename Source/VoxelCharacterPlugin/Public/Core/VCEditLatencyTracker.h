@@ -0,0 +1,139 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Core/VCTypes.h"
+#include "VoxelCharacterStats.h"
+#include "VCEditLatencyTracker.generated.h"
+
+class UAbilitySystemComponent;
+class UGameplayAbility;
+class UVoxelCollisionManager;
+
+/** Measured intervals of a voxel edit / ability activation. */
+enum class EVCEditLatencyStage : uint8
+{
+	/** Client send -> server RPC receipt (reliable queue + transit), in GameState-synced server time. */
+	QueueWait,
+	/** Server RPC receipt -> edit applied to voxel data. */
+	ServerApply,
+	/** Server edit applied -> edited chunk's collision rebuilt from the new mesh. */
+	Remesh,
+	/** Client input -> edited chunk's collision rebuilt on the client (hole visible and walkable). */
+	InputToVisible,
+	/** Client action input -> locally controlled ability activation. */
+	InputToAbility,
+
+	Num
+};
+
+/**
+ * Per-world latency instrumentation for voxel edits and ability activations.
+ *
+ * Edit requests carry an FVCEditRequestStamp from the input frame. Each stage lands in a rolling
+ * FVCSampleWindow; p50/p95/p99 are published to `stat VoxelCharacter` and the VCEdits CSV
+ * category every frame, and `vc.EditLatency.Dump` logs them.
+ *
+ * "Remesh complete" and "client visible" are observed through UVoxelCollisionManager::OnCollisionReady
+ * for the edited chunk — collision is cooked from the rebuilt mesh, so it is the first point at which
+ * the hole is both rendered and walkable. Only the chunk containing the edit centre is tracked.
+ */
+UCLASS()
+class VOXELCHARACTERPLUGIN_API UVCEditLatencyTracker : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Convenience lookup (null outside game worlds). */
+	static UVCEditLatencyTracker* Get(const UObject* WorldContextObject);
+
+	// --- Client ---
+
+	/** Stamp a locally-initiated edit of ChunkCoord and start its input->visible timer. */
+	FVCEditRequestStamp BeginClientEdit(const FIntVector& ChunkCoord);
+
+	/** Record a primary/secondary/interact input that may activate an ability. */
+	void RecordActionInput();
+
+	/** Watch an ASC for ability activations (idempotent per ASC). */
+	void ObserveAbilitySystem(UAbilitySystemComponent* ASC);
+
+	// --- Server ---
+
+	/** Record RPC receipt. Returns the receipt time to pass to RecordServerApplied. */
+	double RecordServerReceipt(const FVCEditRequestStamp& Stamp);
+
+	/** Record the edit applied at ReceiptTime and start the remesh timer for ChunkCoord. */
+	void RecordServerApplied(const FVCEditRequestStamp& Stamp, double ReceiptTime, const FIntVector& ChunkCoord);
+
+	// --- Readout ---
+
+	/** Percentile (0..1) of the given stage over the rolling window, in milliseconds. */
+	float GetPercentileMs(EVCEditLatencyStage Stage, float Fraction) const;
+
+	/** Log count + p50/p95/p99 of every stage. */
+	void DumpToLog() const;
+
+	// --- UTickableWorldSubsystem ---
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override
+	{
+		if (const UWorld* World = Cast<UWorld>(Outer))
+		{
+			return World->IsGameWorld();
+		}
+		return false;
+	}
+
+private:
+	/** An edit waiting for its chunk's collision to be rebuilt. */
+	struct FPendingChunkEdit
+	{
+		FIntVector ChunkCoord = FIntVector::ZeroValue;
+		double StartTime = 0.0;
+		bool bClient = false;
+	};
+
+	/** Pending edits older than this are dropped (chunk never rebuilt, e.g. edit vetoed). */
+	static constexpr double PendingTimeoutSeconds = 5.0;
+
+	/** Action input counts towards an activation only within this window. */
+	static constexpr double AbilityInputWindowSeconds = 0.5;
+
+	void AddSample(EVCEditLatencyStage Stage, double Seconds);
+	void AddPending(const FIntVector& ChunkCoord, double StartTime, bool bClient);
+	void EnsureCollisionBinding();
+	void HandleCollisionReady(const FIntVector& ChunkCoord);
+	void HandleAbilityActivated(UGameplayAbility* Ability);
+
+	/** Server world time (GameState-synced on clients), the shared clock of QueueWait. */
+	double GetSyncedServerTime() const;
+
+	FVCSampleWindow Windows[static_cast<int32>(EVCEditLatencyStage::Num)];
+
+	/** Percentiles last published per stage, and the window's total sample count they were computed at. */
+	struct FStagePercentiles
+	{
+		int64 TotalCount = 0;
+		float P50 = 0.0f;
+		float P95 = 0.0f;
+		float P99 = 0.0f;
+	};
+	FStagePercentiles Published[static_cast<int32>(EVCEditLatencyStage::Num)];
+
+	TArray<FPendingChunkEdit> PendingEdits;
+
+	TWeakObjectPtr<UVoxelCollisionManager> BoundCollisionManager;
+	FDelegateHandle CollisionReadyHandle;
+
+	TArray<TWeakObjectPtr<UAbilitySystemComponent>> ObservedAbilitySystems;
+
+	uint32 NextSequence = 1;
+	double LastActionInputTime = -1.0;
+};
@@ -0,0 +1,162 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "VCNetTrafficTracker.generated.h"
+
+class AActor;
+class UNetConnection;
+
+/** Plugin network traffic kinds accounted per connection. */
+enum class EVCNetTraffic : uint8
+{
+	/** Server_RequestVoxelModification (client -> server). */
+	EditRequest,
+	/** Client_NotifyVoxelEditBlocked (server -> owning client). */
+	EditBlocked,
+	/** AVCCharacterBase::CurrentViewMode replication. */
+	ViewMode,
+	/** UVCCharacterAttributeSet replication. */
+	Attributes,
+
+	Num
+};
+
+/**
+ * Per-connection bandwidth accounting for the plugin's own RPCs and replicated properties.
+ *
+ * - RPCs are measured where they are sent: FVCNetSendScope takes the bits the call added to
+ *   the connection's send buffer (bunch header + parameters). Received RPCs (edit requests on
+ *   the server) are sized by a model of the same bunch.
+ * - Properties are accounted when they change on the server: each changed field is charged
+ *   once per frame (the engine sends at most one update per frame) to every connection with
+ *   an open channel for the owning actor, using the wire size of the field (handle + value).
+ *
+ * Rates (bytes/s over one-second windows) go to `stat VoxelCharacter` (totals), the VCNet CSV
+ * category (totals and `<Connection>/<Traffic>` per connection), FVCPerfCapture reports
+ * (VCNet/<Traffic>), and `vc.Net.Dump`. Packet headers and UDP/IP overhead are not attributed.
+ */
+UCLASS()
+class VOXELCHARACTERPLUGIN_API UVCNetTrafficTracker : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Convenience lookup (null outside game worlds). */
+	static UVCNetTrafficTracker* Get(const UObject* WorldContextObject);
+
+	static const TCHAR* GetTrafficName(EVCNetTraffic Traffic);
+
+	/** Modelled wire size of one RPC of the given kind (bunch header + parameters), 0 for properties. */
+	static int64 GetRpcModelBits(EVCNetTraffic Traffic);
+
+	/** Add Bits of Traffic to Connection (ignored for a null connection, i.e. local calls). */
+	void RecordBits(const UNetConnection* Connection, EVCNetTraffic Traffic, int64 Bits);
+
+	/**
+	 * Server: a replicated field of Actor changed. Field identifies it within the actor so
+	 * repeated changes in one frame are charged once; ValueBits is its serialized value size.
+	 */
+	void RecordPropertyChange(const AActor* Actor, EVCNetTraffic Traffic, FName Field, int32 ValueBits);
+
+	/** Log per-connection rates and totals. */
+	void DumpToLog() const;
+
+	/** Clear all totals. */
+	void Reset();
+
+	// --- UTickableWorldSubsystem ---
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override
+	{
+		if (const UWorld* World = Cast<UWorld>(Outer))
+		{
+			return World->IsGameWorld();
+		}
+		return false;
+	}
+
+private:
+	static constexpr int32 NumTraffic = static_cast<int32>(EVCNetTraffic::Num);
+
+	/** Rates are averaged over windows of this length. */
+	static constexpr double WindowSeconds = 1.0;
+
+	struct FConnectionTraffic
+	{
+		TWeakObjectPtr<const UNetConnection> Connection;
+		FString Name;
+
+		/** Bits / messages in the current window. */
+		int64 WindowBits[NumTraffic] = {};
+		int32 WindowCount[NumTraffic] = {};
+
+		/** Rates of the last finished window. */
+		float BytesPerSecond[NumTraffic] = {};
+		float CountPerSecond[NumTraffic] = {};
+
+		int64 TotalBits[NumTraffic] = {};
+		int64 TotalCount[NumTraffic] = {};
+
+		/** "<Name>/<Traffic>" CSV stat names, built with the name. */
+		FName CsvNames[NumTraffic];
+	};
+
+	/** A replicated field changed this frame, charged at the end of the frame. */
+	struct FPendingField
+	{
+		TWeakObjectPtr<const AActor> Actor;
+		EVCNetTraffic Traffic = EVCNetTraffic::Num;
+		int32 ValueBits = 0;
+	};
+
+	FConnectionTraffic& FindOrAddConnection(const UNetConnection* Connection);
+
+	/** Charge this frame's changed fields to the connections replicating their actors. */
+	void FlushPropertyChanges();
+
+	/** Close the current window: compute rates, refresh names, drop closed connections. */
+	void RollWindow(double Now);
+
+	/** Publish the last window's rates (stats, CSV, perf report). */
+	void PublishRates() const;
+
+	TMap<const UNetConnection*, FConnectionTraffic> Connections;
+	TMap<TPair<FObjectKey, FName>, FPendingField> PendingFields;
+
+	double WindowStart = 0.0;
+};
+
+/**
+ * Measures one RPC send: the bits the call wrote to the connection's send buffer are charged to
+ * Traffic. Falls back to the RPC's modelled size when the send buffer cannot show it (the packet
+ * was flushed mid-send, or the replication system queues RPCs itself).
+ *
+ *   {
+ *       FVCNetSendScope NetScope(this, GetNetConnection(), EVCNetTraffic::EditBlocked);
+ *       Client_NotifyVoxelEditBlocked(RejectedVoxels);
+ *   }
+ */
+class VOXELCHARACTERPLUGIN_API FVCNetSendScope
+{
+public:
+	FVCNetSendScope(const UObject* WorldContextObject, UNetConnection* InConnection, EVCNetTraffic InTraffic);
+	~FVCNetSendScope();
+
+	FVCNetSendScope(const FVCNetSendScope&) = delete;
+	FVCNetSendScope& operator=(const FVCNetSendScope&) = delete;
+
+private:
+	UVCNetTrafficTracker* Tracker = nullptr;
+	UNetConnection* Connection = nullptr;
+	EVCNetTraffic Traffic;
+	int64 StartBits = 0;
+	int32 StartPacketId = 0;
+};
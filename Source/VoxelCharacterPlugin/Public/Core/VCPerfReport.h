@@ -0,0 +1,169 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "VoxelCharacterStats.h"
+
+class FJsonObject;
+
+/**
+ * Time the enclosing scope under Category/StatName: a CSV timing stat (Category is one of the
+ * VC* CSV categories) and, while an FVCPerfCapture runs, a per-frame sample for the perf report.
+ * Game thread scopes only are captured for the report; the CSV stat works on any thread.
+ */
+#define VC_PERF_SCOPE(Category, StatName) \
+	CSV_SCOPED_TIMING_STAT(Category, StatName); \
+	static const int32 PREPROCESSOR_JOIN(VCPerfTimer_, StatName) = FVCPerfCapture::RegisterTimer(TEXT(#Category "/" #StatName)); \
+	const FVCPerfScope PREPROCESSOR_JOIN(VCPerfScope_, StatName)(PREPROCESSOR_JOIN(VCPerfTimer_, StatName))
+
+/**
+ * Bounded-memory distribution of one metric over a capture of any length: exact count / sum /
+ * max and log-spaced buckets (5% wide) for percentiles.
+ */
+struct VOXELCHARACTERPLUGIN_API FVCPerfHistogram
+{
+	void Add(double Value);
+	void Reset();
+
+	/** Percentile (Fraction in [0,1]), accurate to one bucket (5%); 0 when empty. */
+	double GetPercentile(double Fraction) const;
+
+	double GetAverage() const { return Count > 0 ? Sum / Count : 0.0; }
+	double GetMax() const { return Max; }
+	int64 GetCount() const { return Count; }
+
+private:
+	TArray<uint32> Buckets;
+	int64 Count = 0;
+	double Sum = 0.0;
+	double Max = 0.0;
+};
+
+/**
+ * Collects the plugin's per-frame costs and events into a summary report (average, p95, p99,
+ * max, count per metric) for soak tests, and compares reports against a stored baseline.
+ *
+ * - VC_PERF_SCOPE timers are summed per frame; each frame a timer ran adds one sample (ms).
+ * - RecordValue() adds one-off samples (edit latencies, spawn wait) under their own name.
+ * - "Frame/GameThread" is the frame delta (ms).
+ *
+ * Driven by `vc.Perf.Begin` / `vc.Perf.End`, or headless with `-VCPerfSession=<seconds>`, which
+ * captures after a warmup, writes the JSON report, compares it against `-VCPerfBaseline=` and
+ * exits with status 1 on a regression (see Documentation/PROFILING.md). Game thread only.
+ */
+class VOXELCHARACTERPLUGIN_API FVCPerfCapture
+{
+public:
+	/** Settings for a headless session. */
+	struct FSessionSettings
+	{
+		/** Seconds after start before capturing (level load, terrain streaming). */
+		double WarmupSeconds = 10.0;
+		/** Seconds captured. */
+		double CaptureSeconds = 60.0;
+		/** Report path (empty = Saved/Profiling/VCPerfReport.json). */
+		FString ReportPath;
+		/** Baseline report to compare against (empty = no comparison). */
+		FString BaselinePath;
+		/** Allowed relative growth of a metric's average / p95 over the baseline. */
+		double Threshold = 0.10;
+		/** Also write a CSV profile for the captured frames. */
+		bool bCsvCapture = true;
+		/** Quit when done (exit status 1 on regression). */
+		bool bExitWhenDone = true;
+	};
+
+	/** Register a named timer (VC_PERF_SCOPE does this once per call site). Any thread. */
+	static int32 RegisterTimer(const TCHAR* Name);
+
+	/** True while capturing (cheap; checked by every scope). */
+	static bool IsCapturing() { return bCapturing; }
+
+	/** Add a timer's scope time (game thread). */
+	static void AddTimerSample(int32 TimerIndex, double Milliseconds);
+
+	/** Add one sample of a named event metric (game thread, ignored when not capturing). */
+	static void RecordValue(const TCHAR* Name, double Value);
+
+	/** Start capturing now (clears previous samples). */
+	static void Begin();
+
+	/** Stop capturing and build the report. */
+	static TSharedRef<FJsonObject> End();
+
+	/** Run a capture session by settings (headless soak test). */
+	static void StartSession(const FSessionSettings& Settings);
+
+	/** Parse -VCPerfSession= and friends; starts a session if present. Called at module startup. */
+	static void StartSessionFromCommandLine();
+
+	/** Stop listening for frame ends (module shutdown). */
+	static void Shutdown();
+
+	/** Write a report as JSON. */
+	static bool SaveReport(const TSharedRef<FJsonObject>& Report, const FString& Path);
+
+	/** Load a report written by SaveReport. */
+	static TSharedPtr<FJsonObject> LoadReport(const FString& Path);
+
+	/**
+	 * Compare Report against Baseline: a metric regresses when its average or p95 grew by more
+	 * than Threshold (relative) and by more than a small absolute floor (timing noise), or when a
+	 * baseline metric is missing from Report (budget overrun events excepted). Each regression is
+	 * appended to OutRegressions. True if none.
+	 */
+	static bool CompareReports(const FJsonObject& Report, const FJsonObject& Baseline, double Threshold, TArray<FString>& OutRegressions);
+
+	/** Default report location. */
+	static FString GetDefaultReportPath();
+
+private:
+	struct FTimer
+	{
+		FString Name;
+		FVCPerfHistogram Histogram;
+		double FrameMs = 0.0;
+		int32 FrameCalls = 0;
+		int64 TotalCalls = 0;
+	};
+
+	static void HandleEndFrame();
+	static void FinishSession();
+
+	static bool bCapturing;
+	static TArray<FTimer> Timers;
+	static TMap<FString, FVCPerfHistogram> Values;
+	static FVCPerfHistogram FrameTimes;
+	static FCriticalSection TimersLock;
+	static double CaptureStartTime;
+	static int64 CapturedFrames;
+
+	/** Active headless session, if any. */
+	static TOptional<FSessionSettings> Session;
+	static double SessionStartTime;
+	static FDelegateHandle EndFrameHandle;
+};
+
+/** RAII helper behind VC_PERF_SCOPE. */
+class FVCPerfScope
+{
+public:
+	explicit FVCPerfScope(int32 InTimerIndex)
+		: TimerIndex(InTimerIndex)
+		, StartCycles(FVCPerfCapture::IsCapturing() && IsInGameThread() ? FPlatformTime::Cycles64() : 0)
+	{
+	}
+
+	~FVCPerfScope()
+	{
+		if (StartCycles != 0)
+		{
+			FVCPerfCapture::AddTimerSample(TimerIndex, FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles));
+		}
+	}
+
+private:
+	int32 TimerIndex;
+	uint64 StartCycles;
+};
@@ -60,6 +60,8 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "VoxelCharacter|UI")
 	void ToggleWorldMapUI();
 
+	bool IsWorldMapOpen() const { return bWorldMapOpen; }
+
 	/** Show the interaction prompt for the given interactable actor. */
 	UFUNCTION(BlueprintCallable, Category = "VoxelCharacter|UI")
 	void ShowInteractionPrompt(AActor* InteractableActor);
@@ -105,12 +107,32 @@ public:
 	UFUNCTION(Exec)
 	void SpawnWorldItem(FString AssetName, int32 Count = 1);
 
+	// --- Voxel Modification ---
+
+	/**
+	 * Request a server-authoritative voxel modification (owning client). Stamps the request for
+	 * latency tracking (UVCEditLatencyTracker) and sends Server_RequestVoxelModification.
+	 * BlueprintCallable so BP tools/UI can request edits through the same validated path as
+	 * input-driven digging.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VoxelCharacter|Voxel")
+	void RequestVoxelModification(const FIntVector& VoxelCoord, EVoxelModificationType ModType, uint8 MaterialID);
+
 	// --- Server RPCs ---
 
-	/** Request a server-authoritative voxel modification. BlueprintCallable so BP tools/UI can
-	 *  request edits through the same validated path as input-driven digging. */
-	UFUNCTION(Server, Reliable, BlueprintCallable, Category = "VoxelCharacter|Voxel")
-	void Server_RequestVoxelModification(const FIntVector& VoxelCoord, EVoxelModificationType ModType, uint8 MaterialID);
+	/** Validate and apply a voxel modification. Call through RequestVoxelModification. */
+	UFUNCTION(Server, Reliable)
+	void Server_RequestVoxelModification(const FIntVector& VoxelCoord, EVoxelModificationType ModType, uint8 MaterialID, const FVCEditRequestStamp& Stamp);
+
+	/**
+	 * Server-side body of Server_RequestVoxelModification: range / capsule validation and the
+	 * brush edit, on behalf of EditingPawn. Shared with server-driven editors (stress bots) so
+	 * they load the same path as players. Authority only.
+	 * @param OutRejectedVoxels Voxels an edit validator vetoed (protected areas).
+	 * @param OutChunkCoord Chunk the edit landed in.
+	 * @return True if the edit was applied (possibly partly vetoed), false if it was rejected.
+	 */
+	static bool ApplyVoxelModification(APawn* EditingPawn, const FIntVector& VoxelCoord, EVoxelModificationType ModType, uint8 MaterialID, int32& OutRejectedVoxels, FIntVector& OutChunkCoord);
 
 	// --- Edit feedback ---
 
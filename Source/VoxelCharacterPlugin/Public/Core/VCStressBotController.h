@@ -0,0 +1,99 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Controller.h"
+#include "Core/VCTypes.h"
+#include "VCStressBotController.generated.h"
+
+class ACharacter;
+
+/**
+ * The load-test script, independent of who runs it: AVCStressBotController drives server-side
+ * bots with it, and UVCStressTestSubsystem's scripted perf session drives the local player.
+ *
+ * Wanders between random waypoints around its home point — some of them under water, so the
+ * character swims — hops when stuck, and periodically picks a voxel ahead of the feet to dig or
+ * place (alternating). Movement goes through the character and its controller's rotation; edits
+ * are handed back to the caller, which sends them through its own edit path.
+ */
+struct VOXELCHARACTERPLUGIN_API FVCStressBotScript
+{
+	/** Seed the script and set the point it roams around. */
+	void Init(int32 Seed, const FVector& InHomeLocation);
+
+	/**
+	 * Steer Bot for one frame (yaw set on Controller). True when an edit is due and a target was
+	 * found; the edit is returned in the out params.
+	 */
+	bool Tick(ACharacter* Bot, AController* Controller, float DeltaSeconds, FIntVector& OutVoxelCoord, EVoxelModificationType& OutModType, uint8& OutMaterialID);
+
+	/** Radius around home that waypoints are picked in (world units). */
+	float WanderRadius = 4000.f;
+
+	/** Chance a new waypoint is picked over water, when the world has a water level. */
+	float SwimChance = 0.25f;
+
+	/** Average seconds between voxel edits (0 = never edit). */
+	float EditInterval = 3.f;
+
+	/** Material placed by place edits (2 = Stone, as the player's secondary action). */
+	uint8 PlaceMaterialID = 2;
+
+private:
+	/** Choose the next waypoint (land or water). */
+	void PickWaypoint(UWorld* World);
+
+	/** Trace ahead and down; the dig or place (alternating) target at the hit. */
+	bool FindEditTarget(ACharacter* Bot, FIntVector& OutVoxelCoord, EVoxelModificationType& OutModType, uint8& OutMaterialID);
+
+	FRandomStream Random;
+	FVector HomeLocation = FVector::ZeroVector;
+	FVector Waypoint = FVector::ZeroVector;
+
+	float WaypointTime = 0.f;
+	float StuckTime = 0.f;
+	float EditCountdown = 0.f;
+	bool bPlaceNext = false;
+};
+
+/**
+ * Scripted server-side driver for a load-test character (see UVCStressTestSubsystem).
+ *
+ * Runs FVCStressBotScript and applies its edits through AVCPlayerController::ApplyVoxelModification,
+ * the same validated path player edit RPCs use. The possessed character runs its real movement,
+ * camera-less terrain queries and replication, and the bot owns an AVCPlayerState (flagged as a
+ * bot), so GAS, attribute replication and the player state's own net cost scale with bot count
+ * as they would with players.
+ *
+ * A plain AController rather than an AI controller: the script only needs movement input, so the
+ * plugin does not take an AIModule / navmesh dependency (voxel terrain has no navmesh anyway).
+ */
+UCLASS(NotBlueprintable, Transient)
+class VOXELCHARACTERPLUGIN_API AVCStressBotController : public AController
+{
+	GENERATED_BODY()
+
+public:
+	AVCStressBotController();
+
+	/** Seed the script and set the point it roams around. Call before possessing. */
+	void InitBot(int32 Seed, const FVector& InHomeLocation);
+
+	virtual void Tick(float DeltaSeconds) override;
+
+	/** The bot's script and its settings (wander radius, swim chance, edit rate). */
+	FVCStressBotScript Script;
+
+	int32 GetEditsApplied() const { return EditsApplied; }
+	int32 GetEditsRejected() const { return EditsRejected; }
+
+protected:
+	/** Spawn an AVCPlayerState (the GameMode's class if it is one) so possession initializes GAS. */
+	virtual void InitPlayerState() override;
+
+private:
+	int32 EditsApplied = 0;
+	int32 EditsRejected = 0;
+};
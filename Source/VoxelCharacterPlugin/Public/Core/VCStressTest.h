@@ -0,0 +1,146 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Core/VCStressBotController.h"
+#include "VCStressTest.generated.h"
+
+class AVCCharacterBase;
+class AVCPlayerController;
+
+/**
+ * Server-side load test for the character stack: spawns N characters driven by
+ * AVCStressBotController (walk, swim, dig / place through the player edit path) and measures
+ * what they cost.
+ *
+ * Every frame it publishes bot count, bot edits and net driver bandwidth to the VCStress CSV
+ * category and, during an FVCPerfCapture, to the report as VCStress/<Metric> — next to the
+ * frame time and the per-system VC_PERF_SCOPE timers. A ramp (`vc.Stress.Ramp`) steps N up and
+ * writes one report per step plus a scaling table, so cost per bot is visible at a glance.
+ *
+ * The scripted session (`vc.Stress.Script`, `-VCPerfScript`) is the fixed workload perf
+ * baselines are recorded with: a set number of bots with fixed seeds, plus the local player
+ * driven by the same script, with view mode switches and world map use on a fixed schedule.
+ *
+ * Bots are server-owned, so bandwidth only shows replication to real connected clients; attach
+ * null-RHI client processes for network numbers (Documentation/PROFILING.md). Authority only.
+ */
+UCLASS()
+class VOXELCHARACTERPLUGIN_API UVCStressTestSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** A stepped load test: Start bots, +Step each step, up to Max. */
+	struct FRampSettings
+	{
+		int32 StartBots = 0;
+		int32 StepBots = 8;
+		int32 MaxBots = 64;
+		/** Seconds captured per step. */
+		double StepSeconds = 30.0;
+		/** Seconds after changing the bot count before capturing (spawn wait, streaming). */
+		double SettleSeconds = 10.0;
+		/** Quit when the ramp finishes. */
+		bool bExitWhenDone = false;
+	};
+
+	/** Convenience lookup (null outside game worlds). */
+	static UVCStressTestSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Spawn or destroy bots until exactly Count are alive. */
+	void SetBotCount(int32 Count);
+
+	/** Destroy all bots (and stop a running ramp or scripted session). */
+	void ClearBots();
+
+	/**
+	 * Start the scripted session: NumBots bots seeded 1..NumBots and, once this machine's local
+	 * player has a character, that character driven by FVCStressBotScript (seed 0) — walking,
+	 * swimming, dig / place through the player's edit RPC — switching view mode every 15 s and
+	 * opening the world map for the last 8 s of every 30 s. Runs until ClearBots().
+	 */
+	void StartScriptedSession(int32 NumBots);
+
+	/** Start a ramp (replaces any running one). Reports go to Saved/Profiling/VCStress/. */
+	void StartRamp(const FRampSettings& Settings);
+
+	/** Log bot count, edits, bandwidth and connection count. */
+	void LogStatus() const;
+
+	int32 GetNumBots() const { return Bots.Num(); }
+
+	/** Bot character class: the GameMode's default pawn if it is an AVCCharacterBase, else AVCCharacterBase. */
+	TSubclassOf<AVCCharacterBase> GetBotClass() const;
+
+	// --- UTickableWorldSubsystem ---
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override
+	{
+		if (const UWorld* World = Cast<UWorld>(Outer))
+		{
+			return World->IsGameWorld();
+		}
+		return false;
+	}
+
+private:
+	struct FBot
+	{
+		TWeakObjectPtr<AVCStressBotController> Controller;
+		TWeakObjectPtr<AVCCharacterBase> Character;
+	};
+
+	/** One finished ramp step, for the scaling table. */
+	struct FRampRow
+	{
+		int32 Bots = 0;
+		double FrameAvgMs = 0.0;
+		double FrameP95Ms = 0.0;
+		double NetOutKBps = 0.0;
+		double NetInKBps = 0.0;
+		/** Costliest per-system timers, "Name ms/frame". */
+		FString TopSystems;
+	};
+
+	bool SpawnBot();
+
+	/** Edits by all bots this session, live and destroyed. */
+	void GetBotEdits(int32& OutApplied, int32& OutRejected) const;
+
+	/** Centre bots spawn around: the first player pawn, else the world origin. */
+	FVector GetSpawnCenter() const;
+
+	/** End the capture of the current ramp step, save its report, and advance. */
+	void FinishRampStep();
+
+	void LogRampTable() const;
+
+	/** Scripted session: pick up the local player, then drive it and run the camera / map schedule. */
+	void TickPilot(float DeltaTime);
+
+	TArray<FBot> Bots;
+	int32 NextBotSeed = 1;
+
+	/** Edits by bots destroyed so far (live bots are summed on demand). */
+	int32 RetiredEditsApplied = 0;
+	int32 RetiredEditsRejected = 0;
+
+	TOptional<FRampSettings> Ramp;
+	int32 RampBots = 0;
+	double RampPhaseStart = 0.0;
+	bool bRampCapturing = false;
+	TArray<FRampRow> RampRows;
+
+	bool bScriptedSession = false;
+	TWeakObjectPtr<AVCPlayerController> Pilot;
+	FVCStressBotScript PilotScript;
+	double PilotStartTime = 0.0;
+};
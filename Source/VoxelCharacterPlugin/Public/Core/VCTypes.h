@@ -126,6 +126,24 @@ struct VOXELCHARACTERPLUGIN_API FVCEquipmentSocketMapping
 	FName ArmsSocket;
 };
 
+/** Latency stamp carried by a voxel edit request from the input frame to the server.
+ *  See UVCEditLatencyTracker for how the stages are measured. */
+USTRUCT()
+struct VOXELCHARACTERPLUGIN_API FVCEditRequestStamp
+{
+	GENERATED_BODY()
+
+	/** Client-local sequence number (0 = unstamped request, e.g. from Blueprint tools). */
+	UPROPERTY()
+	uint32 Sequence = 0;
+
+	/** Client's estimate of server world time when the request was sent (GameState-synced). */
+	UPROPERTY()
+	double ClientSendServerTime = 0.0;
+
+	bool IsValid() const { return Sequence != 0; }
+};
+
 // ---------------------------------------------------------------------------
 // Delegates
 // ---------------------------------------------------------------------------
@@ -0,0 +1,63 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Compact fog-of-war store: one explored bit per map tile.
+ *
+ * Tiles live in 64 x 64 chunks allocated on first touch; each chunk row is a single uint64, so
+ * rectangle queries test a whole row of up to 64 tiles with one mask, and counts are popcounts
+ * (FMath::CountBits, a POPCNT on current CPUs). Exploration is monotonic: explored tiles stay
+ * explored until Reset().
+ *
+ * Save() / Load() run-length encode the explored bits (varint runs per chunk), which is a few
+ * bytes for typical contiguous exploration — small enough for save games and network sync.
+ */
+class VOXELCHARACTERPLUGIN_API FVCExploredTileSet
+{
+public:
+	/** Tiles per chunk edge (log2). */
+	static constexpr int32 ChunkShift = 6;
+	static constexpr int32 ChunkSize = 1 << ChunkShift;
+
+	bool IsExplored(const FIntPoint& Tile) const;
+
+	/** Mark a tile explored. True if it was not explored before. */
+	bool SetExplored(const FIntPoint& Tile);
+
+	/** Any explored tile in [Rect.Min, Rect.Max). */
+	bool AnyExplored(const FIntRect& Rect) const;
+
+	/** Explored tiles in [Rect.Min, Rect.Max). */
+	int64 CountExplored(const FIntRect& Rect) const;
+
+	/** Visit every explored tile (chunk by chunk, empty rows skipped). */
+	void ForEachExplored(TFunctionRef<void(const FIntPoint& Tile)> Func) const;
+
+	/** Explored tiles overall. */
+	int64 GetNumExplored() const { return NumExplored; }
+
+	/** Chunks allocated (each is 1 KB). */
+	int32 GetNumChunks() const { return Chunks.Num(); }
+
+	void Reset();
+
+	/** Append the run-length encoded explored bits to Out. */
+	void Save(TArray<uint8>& Out) const;
+
+	/** Replace the contents with data from Save(). Returns false (and leaves the set unchanged) on malformed data. */
+	bool Load(TConstArrayView<uint8> Data);
+
+private:
+	struct FChunk
+	{
+		/** Row Y of the chunk, bit X = tile (X, Y). */
+		uint64 Explored[ChunkSize] = {};
+		int32 NumExplored = 0;
+	};
+
+	TMap<FIntPoint, FChunk> Chunks;
+	int64 NumExplored = 0;
+};
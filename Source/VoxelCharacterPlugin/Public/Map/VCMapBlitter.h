@@ -0,0 +1,132 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FVoxelMapTile;
+
+/** How destination pixel axes relate to world axes. */
+enum class EVCMapBlitOrientation : uint8
+{
+	/** Destination +X = world +X, +Y = world +Y (minimap — rotated on screen). */
+	WorldXRight,
+	/** North-up: destination +X = world +Y (east), +Y = world -X (north at the top). */
+	NorthUp,
+};
+
+/**
+ * Destination grid in world space.
+ *
+ * Grid pixel (I, J) samples the world at the centre of its cell:
+ *   WorldXRight: X = GridWorldOrigin.X + (I + 0.5) * WorldPerPixel, Y = GridWorldOrigin.Y + (J + 0.5) * WorldPerPixel
+ *   NorthUp:     Y = GridWorldOrigin.Y + (I + 0.5) * WorldPerPixel, X = GridWorldOrigin.X - (J + 0.5) * WorldPerPixel
+ */
+struct FVCMapBlitView
+{
+	EVCMapBlitOrientation Orientation = EVCMapBlitOrientation::WorldXRight;
+	FVector2D GridWorldOrigin = FVector2D::ZeroVector;
+	double WorldPerPixel = 1.0;
+
+	/** Map tile grid: world position of tile (0, 0), tile edge length, and texels per edge. */
+	FVector2D TileGridOrigin = FVector2D::ZeroVector;
+	double TileWorldSize = 1.0;
+	int32 TileResolution = 1;
+};
+
+/** One tile's pixels as seen by the blitter, resolved once per blit on the game thread. */
+struct FVCMapBlitSource
+{
+	/** BGRA texels (FColor memory layout, already in the texture's format). Null = solid Fill. */
+	const FColor* Pixels = nullptr;
+
+	/** Texels per tile edge. */
+	int32 Resolution = 0;
+
+	/** Source texel step per destination column / row step. */
+	int32 ColStride = 1;
+	int32 RowStride = 0;
+
+	/** Colour written when Pixels is null (fog, not generated yet, ...). */
+	FColor Fill = FColor::Black;
+
+	/** Solid-colour source. */
+	static FVCMapBlitSource MakeFill(const FColor& InFill);
+
+	/** Source for a row-major FVoxelMapTile (PixelData[PY * Res + PX], PX along world X). */
+	static FVCMapBlitSource MakeFromTile(const FVoxelMapTile& Tile, EVCMapBlitOrientation Orientation);
+};
+
+/**
+ * Shared tile -> texture resampler for the map widgets.
+ *
+ * Iterates destination pixels, never source texels, so zoomed-out views never touch texels
+ * that would be overwritten anyway. Prepare() builds per-column and per-row lookup tables
+ * (tile index + texel along the axis) once per view; the grid is separable, so a pixel costs
+ * two table reads. Columns are grouped into spans that share a tile: a span whose texels are
+ * consecutive in memory is a single memcpy, and rows that sample the same source row as the
+ * previous one (zoomed in) copy that destination row.
+ *
+ * Usage: Prepare() -> ResolveTiles() on the game thread, then Blit(). BlitRows() is const and
+ * only reads tables and resolved sources, so disjoint row ranges run on any thread — Blit()
+ * uses that to rasterize large views as parallel row bands.
+ */
+class VOXELCHARACTERPLUGIN_API FVCMapBlitter
+{
+public:
+	/** Build the resampling tables for grid pixels [Min, Min + Size). */
+	void Prepare(const FVCMapBlitView& InView, const FIntPoint& Min, const FIntPoint& Size);
+
+	/** Resolve each tile the prepared rect touches (called once per tile, world tile coordinates). */
+	void ResolveTiles(TFunctionRef<FVCMapBlitSource(const FIntPoint& TileCoord)> Resolve);
+
+	/** Write the whole prepared rect. Dst points at the rect's top-left pixel, DstPitch is in pixels.
+	 *  Large rects are split into row bands across task graph workers (vc.Map.ParallelBlit). */
+	void Blit(FColor* Dst, int32 DstPitch) const;
+
+	/** Write rows [FirstRow, FirstRow + NumRows) of the prepared rect (same Dst as Blit()). */
+	void BlitRows(FColor* Dst, int32 DstPitch, int32 FirstRow, int32 NumRows) const;
+
+	/** Size of the prepared rect in pixels. */
+	FIntPoint GetSize() const { return FIntPoint(Cols.Num(), Rows.Num()); }
+
+private:
+	/** Per destination column / row: tile index relative to the axis' first tile, texel within it. */
+	struct FAxisSample
+	{
+		int32 Tile = 0;
+		int32 Texel = 0;
+
+		bool operator==(const FAxisSample& Other) const { return Tile == Other.Tile && Texel == Other.Texel; }
+	};
+
+	/** Run of destination columns that sample the same tile. */
+	struct FColumnSpan
+	{
+		int32 First = 0;
+		int32 Count = 0;
+		int32 Tile = 0;
+		/** Texels advance by exactly one per column — a contiguous source run when ColStride is 1. */
+		bool bUnitStep = false;
+	};
+
+	/** Fill Out for Count grid pixels starting at First along one destination axis. Returns the first tile index. */
+	int32 BuildAxis(int32 First, int32 Count, bool bColumnAxis, TArray<FAxisSample>& Out) const;
+
+	void BlitSpan(FColor* Out, const FColumnSpan& Span, const FVCMapBlitSource& Src, int32 RowTexel) const;
+
+	FVCMapBlitView View;
+
+	TArray<FAxisSample> Cols;
+	TArray<FAxisSample> Rows;
+	TArray<FColumnSpan> Spans;
+
+	/** First tile index along the column / row axis, and tile counts. */
+	int32 FirstColTile = 0;
+	int32 FirstRowTile = 0;
+	int32 NumColTiles = 0;
+	int32 NumRowTiles = 0;
+
+	/** NumColTiles * NumRowTiles sources, row-major by destination axes. */
+	TArray<FVCMapBlitSource> Sources;
+};
@@ -0,0 +1,141 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "Tasks/Pipe.h"
+
+class IFileHandle;
+
+/**
+ * Paged on-disk store for converted map tiles and super-tiles, one per generated world.
+ *
+ * Two files under Saved/VoxelMapCache/: "<Fingerprint>.pages" holds fixed-size pages (one tile's
+ * BGRA texels each, addressed by page index), and "<Fingerprint>.index" maps (level, coord) to a
+ * page plus a CRC of its contents, followed by an opaque blob the owner persists alongside
+ * (the fog the pages were baked with). Pages are read and written individually through one
+ * open file handle, so only pages that are actually drawn are ever read and rewriting a changed
+ * tile touches only its page; the index is rewritten on Flush(). Removed pages are recycled.
+ *
+ * The index lives on the game thread; page I/O does not. Reads, writes and index rewrites run
+ * in order on one task pipe, so a read queued after a write sees it and a flushed index never
+ * names a page that is not on disk yet. Finished reads are collected with PollReads(); a read
+ * whose page was rewritten or removed meanwhile is dropped there. Close() and the destructor
+ * wait for the pipe to drain.
+ *
+ * The public API is game thread only, like the tile cache that owns it.
+ */
+class VOXELCHARACTERPLUGIN_API FVCMapDiskCache
+{
+public:
+	FVCMapDiskCache() = default;
+	~FVCMapDiskCache();
+
+	FVCMapDiskCache(const FVCMapDiskCache&) = delete;
+	FVCMapDiskCache& operator=(const FVCMapDiskCache&) = delete;
+
+	/**
+	 * Open (or create) the cache for a world fingerprint. An index written for another
+	 * fingerprint or resolution is discarded. OutBlob receives the persisted owner blob.
+	 */
+	bool Open(uint32 InFingerprint, int32 InResolution, TArray<uint8>& OutBlob);
+
+	/** Wait for queued I/O, write the index (with Blob) and close the page file. */
+	void Close(TConstArrayView<uint8> Blob);
+
+	bool IsOpen() const { return PageFile != nullptr; }
+
+	bool HasPage(int32 Level, const FIntPoint& Coord) const;
+
+	/** A page read back by the worker (Resolution^2 texels). */
+	struct FLoadedPage
+	{
+		int32 Level = 0;
+		FIntPoint Coord = FIntPoint::ZeroValue;
+		TArray<FColor> Pixels;
+	};
+
+	/** Queue a read of one page. False if the store has no such page; a read already in flight is not queued twice. */
+	bool RequestPage(int32 Level, const FIntPoint& Coord);
+
+	/** Whether a read of the page is in flight. */
+	bool IsReadPending(int32 Level, const FIntPoint& Coord) const;
+
+	/** Append reads finished since the last call whose page is still current. Torn pages and
+	 *  failed writes are dropped from the index here. */
+	void PollReads(TArray<FLoadedPage>& Out);
+
+	/** Queue one page (Resolution^2 texels) for writing. Returns false (and queues nothing) when the
+	 *  stored page already has the same CRC, so callers can tell whether dependent pages went stale. */
+	bool WritePage(int32 Level, const FIntPoint& Coord, TConstArrayView<FColor> Pixels);
+
+	/** Forget a page (its slot is reused by later writes). */
+	void RemovePage(int32 Level, const FIntPoint& Coord);
+
+	/** Forget every page at MinLevel and above. */
+	void RemovePagesFromLevel(int32 MinLevel);
+
+	/** Queue an index rewrite (with Blob) behind the page writes already queued. */
+	void Flush(TConstArrayView<uint8> Blob);
+
+	/** Pages written or removed since the last Flush(). */
+	bool IsIndexDirty() const { return bIndexDirty; }
+
+	int32 GetNumPages() const { return Pages.Num(); }
+	int32 GetResolution() const { return Resolution; }
+
+private:
+	struct FPageKey
+	{
+		int32 Level = 0;
+		FIntPoint Coord = FIntPoint::ZeroValue;
+
+		bool operator==(const FPageKey& Other) const { return Level == Other.Level && Coord == Other.Coord; }
+		friend uint32 GetTypeHash(const FPageKey& Key) { return HashCombine(::GetTypeHash(Key.Level), ::GetTypeHash(Key.Coord)); }
+	};
+
+	struct FPageEntry
+	{
+		int32 PageIndex = INDEX_NONE;
+		uint32 Crc = 0;
+	};
+
+	/** A read or write finished on the pipe (writes only report failures). */
+	struct FCompletion
+	{
+		FPageKey Key;
+		FPageEntry Entry;
+		bool bSucceeded = false;
+		bool bRead = false;
+		TArray<FColor> Pixels;
+	};
+
+	FString GetIndexPath() const;
+	FString GetPagesPath() const;
+	int64 GetPageBytes() const { return static_cast<int64>(Resolution) * Resolution * sizeof(FColor); }
+
+	/** Index file contents for the current pages and Blob. */
+	TArray<uint8> SerializeIndex(TConstArrayView<uint8> Blob) const;
+
+	/** Write IndexData next to the live index and swap, so a crash mid-write keeps the previous one. */
+	static void WriteIndexFile(const FString& IndexPath, const TArray<uint8>& IndexData);
+
+	/** Whether Key still names the page Entry describes (not rewritten or removed since). */
+	bool IsCurrent(const FPageKey& Key, const FPageEntry& Entry) const;
+
+	TMap<FPageKey, FPageEntry> Pages;
+	TArray<int32> FreePages;
+	int32 NumPageSlots = 0;
+	bool bIndexDirty = false;
+
+	uint32 Fingerprint = 0;
+	int32 Resolution = 0;
+
+	/** Used only by tasks on IoPipe once open. */
+	IFileHandle* PageFile = nullptr;
+
+	UE::Tasks::FPipe IoPipe{ TEXT("VCMapDiskCache") };
+	TQueue<FCompletion, EQueueMode::Mpsc> Completions;
+	TSet<FPageKey> PendingReads;
+};
@@ -0,0 +1,58 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+#include "Map/VCMapMarkerRegistry.h"
+
+/**
+ * Runs a registry's worker-safe marker sources for one map view on a task, double-buffered.
+ *
+ * At most one gather is in flight. The task fills a back buffer owned by a shared job, so the
+ * view can be destroyed (or request again) without waiting; Poll() swaps a finished buffer to
+ * the front. Views draw GetMarkers() — the latest completed set — alongside their synchronous
+ * markers, and never block on a running gather. The front set may be for a slightly older area
+ * or revision; views already cull what they draw.
+ *
+ * Game thread only (the sources themselves run on the worker).
+ */
+class VOXELCHARACTERPLUGIN_API FVCMapMarkerAsyncGather
+{
+public:
+	FVCMapMarkerAsyncGather();
+
+	/** Publish a finished gather to the front buffer. True when GetMarkers() changed. */
+	bool Poll();
+
+	/**
+	 * Start a gather for Area unless one is running or the front set already matches Area and the
+	 * registry's revision. Without worker-safe sources the front set is simply cleared.
+	 */
+	void Request(const UVCMapMarkerRegistry& Registry, const FBox2D& Area);
+
+	/** Latest completed markers. */
+	const TArray<FVCMapMarker>& GetMarkers() const { return Front; }
+
+	/** Whether a gather is running. */
+	bool IsRunning() const { return bRunning; }
+
+private:
+	/** Shared with the task so neither side outlives the other's buffers. */
+	struct FJob
+	{
+		FBox2D Area = FBox2D(ForceInit);
+		uint32 Revision = 0;
+		TArray<FVCWorkerMarkerSourceRef> Sources;
+		TArray<FVCMapMarker> Markers;
+	};
+
+	TSharedRef<FJob, ESPMode::ThreadSafe> Job;
+	UE::Tasks::FTask Task;
+	bool bRunning = false;
+
+	TArray<FVCMapMarker> Front;
+	FBox2D FrontArea = FBox2D(ForceInit);
+	uint32 FrontRevision = 0;
+	bool bHasFront = false;
+};
@@ -0,0 +1,75 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/Widget.h"
+#include "VCMapMarkerLayer.generated.h"
+
+class SVCMapMarkerLayer;
+
+/** One marker as drawn by UVCMapMarkerLayer. */
+struct FVCMapMarkerDraw
+{
+	/** Dot centre in pixels, relative to the layer's centre. */
+	FVector2D Offset = FVector2D::ZeroVector;
+
+	/** Dot edge length in pixels. */
+	float Size = 8.0f;
+
+	FLinearColor Color = FLinearColor::White;
+
+	/** Drawn to the right of the dot; empty = dot only. */
+	FText Label;
+};
+
+/** One polyline (trail, route) drawn by UVCMapMarkerLayer beneath the markers. */
+struct FVCMapMarkerPolyline
+{
+	/** Vertices in pixels, relative to the layer's centre. */
+	TArray<FVector2f> Points;
+
+	FLinearColor Color = FLinearColor::White;
+
+	/** Line width in pixels. */
+	float Thickness = 2.0f;
+};
+
+/**
+ * Draws every map marker (dots + labels) and polyline from plain arrays in a single OnPaint.
+ *
+ * Replaces per-marker UImage / UTextBlock widgets in canvas slots: a refresh rewrites the array
+ * and invalidates paint on one leaf widget, with no slot layout or per-marker visibility changes,
+ * so cost does not grow with the number of widgets. Place it over the map (fill anchors); it has
+ * no desired size and never takes hit tests.
+ */
+UCLASS()
+class VOXELCHARACTERPLUGIN_API UVCMapMarkerLayer : public UWidget
+{
+	GENERATED_BODY()
+
+public:
+	/** Label font size. */
+	UPROPERTY(EditAnywhere, Category = "Map")
+	int32 LabelFontSize = 9;
+
+	/** Markers to draw. Rewrite in place (capacity is kept), then call CommitMarkers(). */
+	TArray<FVCMapMarkerDraw>& EditMarkers() { return Markers; }
+
+	/** Polylines to draw under the markers. Same contract as EditMarkers(). */
+	TArray<FVCMapMarkerPolyline>& EditPolylines() { return Polylines; }
+
+	/** Repaint with the current contents of EditMarkers() / EditPolylines(). */
+	void CommitMarkers();
+
+	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
+
+protected:
+	virtual TSharedRef<SWidget> RebuildWidget() override;
+	virtual void SynchronizeProperties() override;
+
+private:
+	TArray<FVCMapMarkerDraw> Markers;
+	TArray<FVCMapMarkerPolyline> Polylines;
+	TSharedPtr<SVCMapMarkerLayer> MyMarkerLayer;
+};
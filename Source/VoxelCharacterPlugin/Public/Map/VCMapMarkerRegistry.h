@@ -32,19 +32,65 @@ struct FVCMapMarker
 	int32 Priority = 0;
 };
 
+/**
+ * Stable reference to a marker stored in the registry. Slots are reused; the serial makes a
+ * handle to a removed marker stay invalid after its slot is recycled.
+ */
+struct FVCMapMarkerHandle
+{
+	int32 Index = INDEX_NONE;
+	uint32 Serial = 0;
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+	void Reset() { Index = INDEX_NONE; Serial = 0; }
+
+	bool operator==(const FVCMapMarkerHandle& Other) const { return Index == Other.Index && Serial == Other.Serial; }
+	bool operator!=(const FVCMapMarkerHandle& Other) const { return !(*this == Other); }
+};
+
+/** Markers merged for a zoomed-out view: one badge standing for Count markers. */
+struct FVCMapMarkerCluster
+{
+	/** Mean position of the members. */
+	FVector2D WorldPosition = FVector2D::ZeroVector;
+
+	/** Members merged into this cluster (1 = a lone marker, drawn as itself). */
+	int32 Count = 0;
+
+	/** Highest-priority member — supplies colour, priority and (for lone markers) the label. */
+	FVCMapMarker Representative;
+};
+
 /**
  * Marker sources append their markers for a queried world area.
- * Fired on the game thread; sources must be cheap (called at map refresh cadence).
+ * Fired on the game thread; sources must be cheap (called when a map view refreshes its markers).
+ * A source whose output changes calls UVCMapMarkerRegistry::NotifyMarkersChanged() — idle map
+ * views only gather again when the registry's revision moves.
  */
 DECLARE_MULTICAST_DELEGATE_TwoParams(FVCOnGatherMapMarkers, const FBox2D& /*WorldArea*/, TArray<FVCMapMarker>& /*InOutMarkers*/);
 
+/**
+ * Marker source that is safe to run on a worker thread: it reads only data it owns or shares
+ * thread-safely (no UObject access) and appends markers for the area. Run by
+ * FVCMapMarkerAsyncGather, never on the game thread.
+ */
+using FVCWorkerMarkerSource = TFunction<void(const FBox2D& /*WorldArea*/, TArray<FVCMapMarker>& /*InOutMarkers*/)>;
+using FVCWorkerMarkerSourceRef = TSharedRef<const FVCWorkerMarkerSource, ESPMode::ThreadSafe>;
+
 /**
  * Registration point between the map widgets and anything that wants markers on them.
  *
  * The map system (VCMinimapWidget / VCWorldMapWidget) stays source-agnostic and reusable: it asks
  * this registry for markers in its view area and draws whatever comes back. Game-level systems
- * (POIs, quests, party) bind OnGatherMarkers and append theirs — the same seam pattern as the
- * rest of the project (the map knows markers, never their producers).
+ * (POIs, quests, party) publish theirs — the same seam pattern as the rest of the project (the
+ * map knows markers, never their producers).
+ *
+ * Markers that persist (POIs, quest targets) are added once and kept in a uniform grid, so an
+ * area query only visits the cells it overlaps; producers update or remove them through their
+ * handle. Truly dynamic sources (party members, projectiles) can still bind OnGatherMarkers and
+ * append per query. Expensive sources that need no game-thread state (deterministic placement
+ * over the view) register with AddWorkerSafeSource() instead; map views run those on a task and
+ * draw the latest finished set.
  */
 UCLASS()
 class VOXELCHARACTERPLUGIN_API UVCMapMarkerRegistry : public UWorldSubsystem
@@ -52,14 +98,68 @@ class VOXELCHARACTERPLUGIN_API UVCMapMarkerRegistry : public UWorldSubsystem
 	GENERATED_BODY()
 
 public:
-	/** Bind a source here (game thread). Keep the FDelegateHandle to unbind on teardown. */
+	/** Grid cell edge in world units. */
+	static constexpr float MarkerCellSize = 8192.0f;
+
+	/** Bind a dynamic source here (game thread). Keep the FDelegateHandle to unbind on teardown. */
 	FVCOnGatherMapMarkers OnGatherMarkers;
 
-	/** Collect markers from every bound source for WorldArea (appended in bind order). */
-	void GatherMarkers(const FBox2D& WorldArea, TArray<FVCMapMarker>& OutMarkers) const
-	{
-		OnGatherMarkers.Broadcast(WorldArea, OutMarkers);
-	}
+	/** Store a persistent marker; it appears in every query covering its position until removed. */
+	FVCMapMarkerHandle AddMarker(const FVCMapMarker& Marker);
+
+	/** Replace a stored marker (moving it between cells as needed). False if the handle is stale. */
+	bool UpdateMarker(const FVCMapMarkerHandle& Handle, const FVCMapMarker& Marker);
+
+	/** Move a stored marker. False if the handle is stale. */
+	bool SetMarkerPosition(const FVCMapMarkerHandle& Handle, const FVector2D& WorldPosition);
+
+	/** Remove a stored marker. False if the handle is stale (already removed). */
+	bool RemoveMarker(const FVCMapMarkerHandle& Handle);
+
+	/** The stored marker, or null for a stale handle. */
+	const FVCMapMarker* FindMarker(const FVCMapMarkerHandle& Handle) const;
+
+	/** Persistent markers currently stored. */
+	int32 GetNumMarkers() const { return NumMarkers; }
+
+	/** Changes whenever stored markers change or a source reports new output; views compare it to skip re-gathering. */
+	uint32 GetRevision() const { return Revision; }
+
+	/** For OnGatherMarkers / worker-safe sources: what you would append has changed. */
+	void NotifyMarkersChanged() { ++Revision; }
+
+	/** Register a worker-safe source (game thread). Returns an id for RemoveWorkerSafeSource(). */
+	int32 AddWorkerSafeSource(FVCWorkerMarkerSource Source);
+
+	/** Unregister a worker-safe source. A gather already running may still call it once; the
+	 *  callable itself stays alive until that gather finishes. */
+	void RemoveWorkerSafeSource(int32 SourceId);
+
+	/** Snapshot of the worker-safe sources for one asynchronous gather. */
+	void GetWorkerSafeSources(TArray<FVCWorkerMarkerSourceRef>& OutSources) const;
+
+	/** Collect stored markers inside WorldArea (grid lookup), then markers from every bound source (in bind order). */
+	void GatherMarkers(const FBox2D& WorldArea, TArray<FVCMapMarker>& OutMarkers) const;
+
+	/**
+	 * Collect markers inside WorldArea merged per ClusterWorldSize world-grid cell. Stored markers
+	 * come from per-cell aggregates (count, position sum, top marker) whenever a cluster cell is at
+	 * least one index cell, so the cost follows the number of cells, not markers; dynamic sources
+	 * are binned as they are gathered, followed by ExtraMarkers (e.g. a finished async gather).
+	 */
+	void GatherMarkerClusters(const FBox2D& WorldArea, double ClusterWorldSize, TArray<FVCMapMarkerCluster>& OutClusters,
+		TConstArrayView<FVCMapMarker> ExtraMarkers = {}) const;
+
+	/**
+	 * Reorder Markers so the MaxCount highest-priority ones come first, highest first; returns how
+	 * many that is. Bounded min-heap selection — O(n log K), in place, no allocation.
+	 */
+	static int32 SelectHighestPriority(TArrayView<FVCMapMarker> Markers, int32 MaxCount);
+
+	/** Same selection for clusters, by their representative's priority. */
+	static int32 SelectHighestPriority(TArrayView<FVCMapMarkerCluster> Clusters, int32 MaxCount);
+
+	virtual void Deinitialize() override;
 
 protected:
 	virtual bool ShouldCreateSubsystem(UObject* Outer) const override
@@ -70,4 +170,52 @@ protected:
 		}
 		return false;
 	}
+
+private:
+	struct FSlot
+	{
+		FVCMapMarker Marker;
+		FIntPoint Cell = FIntPoint::ZeroValue;
+		uint32 Serial = 0;
+		bool bUsed = false;
+	};
+
+	static FIntPoint CellOf(const FVector2D& WorldPosition);
+
+	FSlot* FindSlot(const FVCMapMarkerHandle& Handle);
+	const FSlot* FindSlot(const FVCMapMarkerHandle& Handle) const;
+
+	/** Occupied index cell: member slots plus the aggregates clustering reads instead of the members. */
+	struct FCell
+	{
+		TArray<int32> Markers;
+		FVector2D PositionSum = FVector2D::ZeroVector;
+		int32 BestIndex = INDEX_NONE;
+	};
+
+	void LinkToCell(int32 Index, const FIntPoint& Cell);
+	void UnlinkFromCell(int32 Index, const FIntPoint& Cell);
+
+	/** Recompute a cell's highest-priority member. */
+	void RefreshCellBest(FCell& Cell) const;
+
+	/** Visit the occupied cells overlapping WorldArea (probing small areas, walking the map for huge ones). */
+	void ForEachCellInArea(const FBox2D& WorldArea, TFunctionRef<void(const FIntPoint& CellCoord, const FCell& Cell)> Func) const;
+
+	/** Marker storage; freed slots are recycled through FreeSlots. */
+	TArray<FSlot> Slots;
+	TArray<int32> FreeSlots;
+	int32 NumMarkers = 0;
+	uint32 NextSerial = 1;
+	uint32 Revision = 0;
+
+	/** Occupied grid cells. */
+	TMap<FIntPoint, FCell> Cells;
+
+	/** Worker-safe sources by id (shared so a running gather keeps its snapshot alive). */
+	TArray<TPair<int32, FVCWorkerMarkerSourceRef>> WorkerSources;
+	int32 NextWorkerSourceId = 1;
+
+	/** Dynamic-source markers during GatherMarkerClusters (capacity reused). */
+	mutable TArray<FVCMapMarker> DynamicScratch;
 };
@@ -0,0 +1,39 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Light and blend for the map's hillshade. */
+struct FVCMapReliefSettings
+{
+	/** Sun direction around the vertical, degrees from world +X towards +Y. */
+	float SunAzimuthDegrees = 225.0f;
+
+	/** Sun height above the horizon, degrees. */
+	float SunElevationDegrees = 45.0f;
+
+	/** Vertical exaggeration applied to slopes before shading. */
+	float ZFactor = 2.0f;
+
+	/** 0 = flat colour, 1 = full hillshade. Flat ground keeps its colour at any strength. */
+	float Strength = 0.5f;
+};
+
+/**
+ * Hillshade for one map tile, computed once per tile version by UVCMapTileCache.
+ *
+ * Slope comes from central differences on a height grid with a one-texel apron; the light
+ * term is evaluated four texels at a time per row with the engine's vector intrinsics, then
+ * the tile's colours are scaled by the resulting factor. Flat terrain maps to factor 1.
+ */
+struct VOXELCHARACTERPLUGIN_API FVCMapRelief
+{
+	/**
+	 * Shade Pixels (Res x Res, [PY * Res + PX]) in place.
+	 * @param Heights         (Res + 2)^2 world heights, [(PY + 1) * (Res + 2) + PX + 1] for texel (PX, PY).
+	 * @param TexelWorldSize  World distance between neighbouring texel centres.
+	 */
+	static void ApplyHillshade(TConstArrayView<float> Heights, int32 Res, float TexelWorldSize,
+		const FVCMapReliefSettings& Settings, TArrayView<FColor> Pixels);
+};
@@ -0,0 +1,51 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UTexture2D;
+
+/**
+ * Persistent CPU staging copy of a map texture, uploaded in dirty rectangles.
+ *
+ * Callers rasterize into GetPixels() (BGRA, row-major, Width x Height), mark what they
+ * touched, and Flush() once per refresh. Each dirty rect is packed into its own heap block
+ * and handed to UTexture2D::UpdateTextureRegions; the render thread frees it after the copy,
+ * so the game thread never waits and the RHI texture is never recreated.
+ *
+ * The texture must already have a resource — call UpdateResource() once after CreateTransient.
+ */
+class VOXELCHARACTERPLUGIN_API FVCMapTextureUploader
+{
+public:
+	/** Resize the staging buffer (contents undefined) and mark everything dirty. */
+	void Reset(int32 InWidth, int32 InHeight);
+
+	/** Staging pixels, Width * Height, row-major. */
+	FColor* GetPixels() { return Pixels.GetData(); }
+	const FColor* GetPixels() const { return Pixels.GetData(); }
+
+	int32 GetWidth() const { return Width; }
+	int32 GetHeight() const { return Height; }
+
+	/** Mark [Rect.Min, Rect.Max) for upload (clipped to the buffer). */
+	void MarkDirty(const FIntRect& Rect);
+
+	/** Mark the whole buffer for upload. */
+	void MarkAllDirty();
+
+	bool HasDirty() const { return DirtyRects.Num() > 0; }
+
+	/** Upload dirty rects to mip 0 of Texture (same size as the buffer) and clear them. */
+	void Flush(UTexture2D* Texture);
+
+private:
+	/** More rects than this are uploaded as their bounding box (one command instead of many). */
+	static constexpr int32 MaxRegionsPerFlush = 16;
+
+	TArray<FColor> Pixels;
+	TArray<FIntRect> DirtyRects;
+	int32 Width = 0;
+	int32 Height = 0;
+};
@@ -0,0 +1,345 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Map/VCMapBlitter.h"
+#include "Map/VCExploredTileSet.h"
+#include "Map/VCMapDiskCache.h"
+#include "Map/VCMapRelief.h"
+#include "Tasks/Task.h"
+#include "VCMapTileCache.generated.h"
+
+class UVoxelMapSubsystem;
+struct FVoxelMapTile;
+
+/** The cached image of (Level, Coord) changed — widgets drawing that level redraw its footprint. */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FVCOnMapCacheRegionUpdated, int32 /*Level*/, const FIntPoint& /*Coord*/);
+
+/** One map tile, converted once per tile version for every map widget in the world. */
+struct FVCCachedMapTile
+{
+	/** Texels per tile edge. */
+	int32 Resolution = 0;
+
+	/** Tile version this entry was built from (see UVCMapTileCache::GetTileVersion). */
+	uint32 Version = 0;
+
+	/** BGRA texels in FVoxelMapTile layout: [PY * Resolution + PX], PX along world X. Hillshaded
+	 *  when relief is on (level 0 only; super-tiles inherit it from their children). */
+	TArray<FColor> Pixels;
+
+	/** Transposed copy ([PX * Resolution + PY]) so north-up destination rows read contiguously. Built on first use. */
+	TArray<FColor> PixelsNorthUp;
+};
+
+/**
+ * Per-world cache of map tiles in texture-ready form, shared by the minimap and world map of
+ * every local player.
+ *
+ * Entries are built lazily from UVoxelMapSubsystem on first use and rebuilt only when the
+ * tile's version changes (each OnMapTileReady bumps it), so a tile is converted at most once
+ * per version no matter how many widgets draw it. Least-recently-used entries are evicted past
+ * MaxCachedTiles; entries touched this frame never are, so blit sources resolved from the
+ * cache stay valid for the rest of the frame.
+ *
+ * For zoomed-out views the cache also keeps a quadtree of super-tiles: a level-L super-tile
+ * covers 2^L x 2^L tiles, box-filtered down to one tile's resolution from its four level L-1
+ * children. Lookups never build: a missing super-tile is queued and drawn as UnloadedColor,
+ * and Tick() builds queued ones depth-first within SuperTileBuildBudgetMs, broadcasting
+ * OnRegionUpdated as each finishes. A tile becoming ready marks the super-tiles above it stale;
+ * they keep drawing until rebuilt. Explored tiles becoming ready, and tiles becoming explored,
+ * also queue the super-tiles above them, so the pyramid is built as tiles arrive and is warm
+ * before the world map opens. Rendering at the level matching the view's world-per-pixel
+ * keeps cost proportional to output pixels instead of explored area. Super-tiles bake in the
+ * world map's fog colours.
+ *
+ * With relief on (vc.Map.Relief), each tile version is hillshaded once on a worker task, which
+ * samples the generated surface height over the tile: the tile draws with its previous texels
+ * (flat if it had none) until Tick() swaps the shaded texels in and broadcasts OnRegionUpdated
+ * at level 0.
+ *
+ * Exploration is mirrored in an FVCExploredTileSet. Every ExplorationSyncInterval the map
+ * subsystem is asked only about candidates — unexplored tiles within ExplorationWatchRadius of a
+ * local player, and tiles reported ready since the last sync — so a sync never scales with the
+ * explored area. Newly explored tiles mark the super-tiles above them stale and broadcast
+ * OnRegionUpdated at level 0; super-tiles over unexplored regions are answered from the bitset
+ * without visiting their tiles.
+ *
+ * Converted tiles and built super-tiles are also persisted per world in an FVCMapDiskCache
+ * (vc.Map.DiskCache), with the explored tiles their fog was baked from. Once the voxel world is
+ * up, the world map opens from disk pages — only the pages it draws are read, on the store's
+ * worker, landing in Tick() — instead of rebuilding the pyramid, and tiles the map subsystem no
+ * longer holds still draw. A tile whose texels or fog change drops the disk super-tiles above
+ * it, so the store is updated incrementally rather than rewritten; the index is flushed every
+ * DiskIndexFlushInterval while it has changes.
+ */
+UCLASS()
+class VOXELCHARACTERPLUGIN_API UVCMapTileCache : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Convenience lookup (null outside game worlds). */
+	static UVCMapTileCache* Get(const UObject* WorldContextObject);
+
+	/** Fog colour of unexplored tiles (world map, and baked into super-tiles). */
+	static const FColor UnexploredColor;
+
+	/** Colour of explored tiles whose data has not been generated yet. */
+	static const FColor UnloadedColor;
+
+	/** Deepest super-tile level (2^MaxLodLevel tiles per side). */
+	static constexpr int32 MaxLodLevel = 8;
+
+	/** Entries kept before least-recently-used ones are evicted. */
+	int32 MaxCachedTiles = 2048;
+
+	/** Super-tiles (all levels) kept before least-recently-used ones are evicted. */
+	int32 MaxCachedSuperTiles = 1024;
+
+	/** Game-thread time per frame spent building queued super-tiles (at least one step runs). */
+	float SuperTileBuildBudgetMs = 1.0f;
+
+	/** Seconds between index flushes of the disk store while pages or exploration changed. */
+	float DiskIndexFlushInterval = 30.0f;
+
+	/** Seconds between exploration syncs with the map subsystem. */
+	float ExplorationSyncInterval = 0.25f;
+
+	/** Tiles around each local player's pawn probed for exploration every sync (must cover the map
+	 *  subsystem's exploration reach). */
+	int32 ExplorationWatchRadius = 8;
+
+	/** Level 0: a tile became explored, was read back from disk or finished shading. Level >= 1: a
+	 *  super-tile finished building (or was read back from disk) after a lookup had to skip it. */
+	FVCOnMapCacheRegionUpdated OnRegionUpdated;
+
+	/** Hillshade light and blend (applied per tile version; set before tiles are drawn). */
+	FVCMapReliefSettings ReliefSettings;
+
+	/** Texels between height samples for the hillshade (bilinear in between; 1 = every texel). */
+	int32 ReliefSampleStep = 2;
+
+	/** The tile at its current version, converting on first use; null while the map has no data for it.
+	 *  The pointer is valid until the next lookup; the pixel data until the end of the frame. */
+	const FVCCachedMapTile* FindOrBuild(const FIntPoint& TileCoord);
+
+	/** Blit source for TileCoord in the given orientation, or a MissingFill source without data. */
+	FVCMapBlitSource MakeBlitSource(const FIntPoint& TileCoord, EVCMapBlitOrientation Orientation, const FColor& MissingFill);
+
+	/**
+	 * Fog-composited source at Level: Level 0 is TileCoord itself (unexplored -> UnexploredColor,
+	 * no data -> UnloadedColor); Level >= 1 is the super-tile at Coord (tiles Coord * 2^Level ..),
+	 * or UnloadedColor while it is queued for building.
+	 */
+	FVCMapBlitSource MakeFogLodBlitSource(int32 Level, const FIntPoint& Coord, EVCMapBlitOrientation Orientation);
+
+	/** Super-tile level whose texels best match WorldPerPixel (0 = full-resolution tiles). */
+	int32 SelectLodLevel(double WorldPerPixel) const;
+
+	/** Whether TileCoord is explored, as of the last sync. */
+	bool IsTileExplored(const FIntPoint& TileCoord);
+
+	/** Whether any tile in [TileRect.Min, TileRect.Max) is explored, as of the last sync. */
+	bool IsAnyTileExplored(const FIntRect& TileRect);
+
+	/** Exploration mirrored so far (stats, persistence). */
+	const FVCExploredTileSet& GetExploredTiles() const { return ExploredTiles; }
+
+	/** Run-length encoded exploration for save games / network sync. */
+	void SaveExploration(TArray<uint8>& OutData) const;
+
+	/** Add the explored tiles in SaveExploration() data (exploration only grows); super-tiles over them are rebuilt. */
+	bool LoadExploration(TConstArrayView<uint8> Data);
+
+	/** Bumped by every OnMapTileReady for the tile (0 = never reported). */
+	uint32 GetTileVersion(const FIntPoint& TileCoord) const;
+
+	/** Entries currently cached. */
+	int32 GetNumCachedTiles() const { return Entries.Num(); }
+
+	/** Tile conversions since creation — each tile version should count once. */
+	int64 GetNumConversions() const { return NumConversions; }
+
+	/** Pages in the on-disk store (0 while it is closed or disabled). */
+	int32 GetNumDiskPages() const { return DiskCache.IsOpen() ? DiskCache.GetNumPages() : 0; }
+
+	/** Super-tiles queued or partly built. */
+	int32 GetNumPendingSuperTiles() const { return SuperTileRequests.Num() + SuperTileBuildStack.Num(); }
+
+	// --- UTickableWorldSubsystem ---
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override
+	{
+		if (const UWorld* World = Cast<UWorld>(Outer))
+		{
+			return World->IsGameWorld();
+		}
+		return false;
+	}
+
+private:
+	struct FEntry
+	{
+		FVCCachedMapTile Tile;
+		uint64 LastUsedFrame = 0;
+	};
+
+	/** Super-tile; regions with no detail at all (unexplored) collapse to a solid colour. */
+	struct FSuperEntry
+	{
+		FVCCachedMapTile Tile;
+		FColor SolidColor = FColor::Black;
+		bool bSolid = false;
+
+		/** A tile underneath changed; still drawn until the rebuild replaces it. */
+		bool bStale = false;
+		uint64 LastUsedFrame = 0;
+	};
+
+	struct FSuperKey
+	{
+		int32 Level = 0;
+		FIntPoint Coord = FIntPoint::ZeroValue;
+
+		bool operator==(const FSuperKey& Other) const { return Level == Other.Level && Coord == Other.Coord; }
+		friend uint32 GetTypeHash(const FSuperKey& Key) { return HashCombine(::GetTypeHash(Key.Level), ::GetTypeHash(Key.Coord)); }
+	};
+
+	FVCCachedMapTile* FindOrBuildMutable(const FIntPoint& TileCoord);
+
+	/** Level >= 1 super-tile at Coord if current or solid fog; else a stale entry, or null. */
+	FSuperEntry* FindOrLoadSuperTile(int32 Level, const FIntPoint& Coord);
+
+	/** Solid fog for a super-tile not current in memory, else null — after queuing a read if it is on disk. */
+	FSuperEntry* LoadSuperTile(int32 Level, const FIntPoint& Coord);
+
+	enum class ESuperTileStep : uint8
+	{
+		Done,
+		NeedsChildren,
+		/** A disk read or a child's hillshade is still in flight. */
+		Waiting,
+	};
+
+	/** Queue a super-tile for Tick() (most recent requests are built first). */
+	void RequestSuperTile(int32 Level, const FIntPoint& Coord);
+
+	/** Queue every super-tile above TileCoord, level 1 to be built first. */
+	void RequestAncestorSuperTiles(const FIntPoint& TileCoord);
+
+	/** Work through queued super-tiles until Deadline (FPlatformTime::Seconds). */
+	void BuildSuperTiles(double Deadline);
+
+	/** Downsample Key from its children, or push the children that are not current yet, or wait for disk reads / shading. */
+	ESuperTileStep BuildSuperTile(const FSuperKey& Key);
+
+	/** The entry at (Level, Coord), added if absent (counted, evicting past the budget), reset and used this frame. */
+	FSuperEntry& AddSuperTile(int32 Level, const FIntPoint& Coord);
+
+	/** Source for a cached tile in the given orientation (transposes for north-up on first use). */
+	static FVCMapBlitSource MakeSourceFromCached(FVCCachedMapTile& Cached, EVCMapBlitOrientation Orientation, const FColor& Fill);
+
+	/** Bind OnMapTileReady once the map subsystem exists. */
+	UVoxelMapSubsystem* ResolveMapSubsystem();
+
+	void HandleMapTileReady(FIntPoint TileCoord);
+
+	/** Mirror tiles the map subsystem explored since the last sync (candidates only). */
+	void SyncExploration();
+
+	/** Regather ExplorationWatch when a local player moved to another tile. */
+	void UpdateExplorationWatch(const UVoxelMapSubsystem& Subsystem);
+
+	/** TileCoord just became explored: the fog baked above it is stale. */
+	void HandleTileExplored(const FIntPoint& TileCoord);
+
+	/** Open the disk store once the voxel world's configuration is known (from tile-ready events, throttled). */
+	FVCMapDiskCache* ResolveDiskCache();
+
+	/**
+	 * Start hillshading Source at Version on a worker, unless that version is already underway.
+	 * False with relief off or no voxel world to sample heights from — its texels are final as they are.
+	 */
+	bool QueueRelief(const FIntPoint& TileCoord, const FVoxelMapTile& Source, uint32 Version);
+
+	/** Take finished hillshades into the cache and the disk store, and announce them. */
+	void PollRelief();
+
+	/** Persist a level-0 tile as drawn; if its texels changed, the disk super-tiles above it are stale. */
+	void StoreTilePage(const FIntPoint& TileCoord, TConstArrayView<FColor> Pixels);
+
+	/** Drop the disk super-tile pages above TileCoord. */
+	void RemoveDiskSuperTiles(const FIntPoint& TileCoord);
+
+	/** Take finished disk reads into the cache and announce them. */
+	void PollDiskReads();
+
+	/** Flush the disk index if it or the exploration changed since the last flush. */
+	void FlushDiskIndex();
+
+	/** Drop least-recently-used entries (never ones used this frame) down to ~90% of the budget. */
+	void EvictLeastRecentlyUsed();
+	void EvictLeastRecentlyUsedSuperTiles();
+
+	TMap<FIntPoint, FEntry> Entries;
+
+	/** SuperTiles[L - 1] holds level L. */
+	TMap<FIntPoint, FSuperEntry> SuperTiles[MaxLodLevel];
+	int32 NumSuperTiles = 0;
+
+	/** Super-tiles lookups skipped, newest last (capped at MaxCachedSuperTiles), and the set for dedup. */
+	TArray<FSuperKey> SuperTileRequests;
+	TSet<FSuperKey> RequestedSuperTiles;
+
+	/** Super-tile being built on top, the children it waits for above it. */
+	TArray<FSuperKey> SuperTileBuildStack;
+	TMap<FIntPoint, uint32> Versions;
+
+	FVCExploredTileSet ExploredTiles;
+
+	/** Unexplored tiles near local players, probed every sync, and the player tiles they were gathered around. */
+	TSet<FIntPoint> ExplorationWatch;
+	TArray<FIntPoint> WatchedPlayerTiles;
+
+	/** Unexplored tiles reported ready since the last sync, probed once. */
+	TSet<FIntPoint> ExplorationProbes;
+
+	bool bExplorationSynced = false;
+	float TimeSinceExplorationSync = 0.0f;
+
+	/** vc.Map.Relief, latched at Initialize so cached and persisted tiles never mix shaded / flat. */
+	bool bReliefEnabled = false;
+
+	/** Hillshade of one tile version; the task owns its texels, samples the chunk manager's
+	 *  generated surface, and returns the shaded texels. */
+	struct FReliefJob
+	{
+		uint32 Version = 0;
+		UE::Tasks::TTask<TArray<FColor>> Task;
+	};
+
+	/** At most one per tile — a newer version replaces the job. */
+	TMap<FIntPoint, FReliefJob> ReliefJobs;
+
+	/** Replaced jobs still running — they read the chunk manager, so Deinitialize waits for them too. */
+	TArray<UE::Tasks::TTask<TArray<FColor>>> SupersededReliefTasks;
+
+	FVCMapDiskCache DiskCache;
+	bool bDiskCacheResolved = false;
+	uint64 NextDiskCacheAttemptFrame = 0;
+	float TimeSinceDiskFlush = 0.0f;
+	int64 FlushedExploredCount = 0;
+
+	TWeakObjectPtr<UVoxelMapSubsystem> MapSubsystem;
+	FDelegateHandle TileReadyHandle;
+
+	int64 NumConversions = 0;
+};
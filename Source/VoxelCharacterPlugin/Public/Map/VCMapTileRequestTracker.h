@@ -0,0 +1,71 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UVoxelMapSubsystem;
+
+/**
+ * Tracks which map tiles a view has already asked UVoxelMapSubsystem for, so each refresh only
+ * submits tiles that newly entered the view.
+ *
+ * When the view's centre tile changes, tiles that left the view are forgotten (they are asked
+ * for again if they come back) and the newly entered, non-resident ones are queued, ordered by
+ * distance weighted towards the view direction. Each Update() submits at most
+ * MaxRequestsPerUpdate of them, nearest / most-ahead first, so the subsystem sees a short,
+ * prioritized trickle instead of the whole disc every refresh.
+ *
+ * A request is not trusted forever: a tile in view still not resident after RequestTimeoutSeconds
+ * (dropped by the subsystem, or evicted after it was ready) is queued again. Tiles already
+ * resident when they enter the view are tracked the same way. Resident tiles restart their clock at each check, so an eviction is noticed within
+ * one timeout; NeedsUpdate() reports when a check is due even though the view is still.
+ *
+ * Game thread only.
+ */
+class VOXELCHARACTERPLUGIN_API FVCMapTileRequestTracker
+{
+public:
+	/** Tiles submitted per Update() at most; the rest stay queued for the next one. */
+	int32 MaxRequestsPerUpdate = 16;
+
+	/** Preference for tiles ahead: 0 = distance only, 1 = a tile straight ahead ranks as if at distance 0. */
+	float HeadingWeight = 0.5f;
+
+	/** Seconds a submitted tile may stay non-resident before it is requested again. */
+	double RequestTimeoutSeconds = 10.0;
+
+	/**
+	 * Queue newly visible tiles (when the centre tile or radius changed) and timed-out requests,
+	 * then submit the next batch.
+	 * @param ViewDirection  Unit XY direction the view faces (zero = no preference).
+	 */
+	void Update(UVoxelMapSubsystem& Subsystem, const FVector2D& Center, double Radius, const FVector2D& ViewDirection);
+
+	/** Tiles queued but not yet submitted — keep calling Update() until false. */
+	bool HasPending() const { return Pending.Num() > 0; }
+
+	/** Whether Update() has work without the view moving: queued tiles, or requests due a residency check. */
+	bool NeedsUpdate() const;
+
+	/** Forget everything (view teleported to another world, widget rebuilt, ...). */
+	void Reset();
+
+private:
+	/** Tile edge and tile (0, 0) origin, cached per Update(). */
+	double TileWorldSize = 0.0;
+	FVector2D TileGridOrigin = FVector2D::ZeroVector;
+
+	FIntPoint LastCenterTile = FIntPoint(MAX_int32, MAX_int32);
+	double LastRadius = -1.0;
+
+	/** Tiles in view that were submitted or found resident, with when that was or when they were last seen
+	 *  resident (FPlatformTime::Seconds). */
+	TMap<FIntPoint, double> Requested;
+
+	/** Earliest time a request in Requested can time out. */
+	double NextExpiryTime = MAX_dbl;
+
+	/** Tiles in view waiting to be submitted, highest priority first. */
+	TArray<FIntPoint> Pending;
+};
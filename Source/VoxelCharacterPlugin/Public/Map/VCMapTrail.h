@@ -0,0 +1,96 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * A player's travel path, simplified as it is recorded and stored compactly.
+ *
+ * Samples go through an online Douglas–Peucker pass (opening window): a sample only becomes a
+ * vertex once the straight segment from the previous vertex can no longer cover every sample
+ * since it within Tolerance, so straight runs collapse to their end points as they are walked.
+ * Vertices are quantized to Quantum and stored as zigzag-varint deltas in chunks of up to
+ * MaxPointsPerChunk, each with its bounds, so area queries skip whole chunks and memory stays
+ * at a few bytes per vertex. Past MaxChunks the oldest chunk is dropped, bounding memory on
+ * arbitrarily long sessions.
+ *
+ * A chunk is one polyline strip: a full chunk's successor repeats its last vertex, and Break()
+ * (teleport, respawn) starts an unconnected strip.
+ */
+class VOXELCHARACTERPLUGIN_API FVCMapTrail
+{
+public:
+	/** Max distance (world units) a dropped sample may lie from the simplified path. */
+	float Tolerance = 150.0f;
+
+	/** Vertex quantization step (world units). */
+	float Quantum = 25.0f;
+
+	/** Vertices per chunk. */
+	int32 MaxPointsPerChunk = 256;
+
+	/** Chunks kept; the oldest is dropped beyond this. */
+	int32 MaxChunks = 128;
+
+	/** Record a sample. */
+	void AddPoint(const FVector2D& WorldPosition);
+
+	/** End the current strip (the live tail becomes a vertex); the next sample starts a new one. */
+	void Break();
+
+	/** Drop everything. */
+	void Reset();
+
+	/**
+	 * Visit every strip whose bounds overlap Area, decoded to world positions. The strip that is
+	 * still being recorded includes the live tail (the newest sample), so the path reaches the player.
+	 * The view is valid only during the call.
+	 */
+	void ForEachStripInArea(const FBox2D& Area, TFunctionRef<void(TConstArrayView<FVector2D> Points)> Func) const;
+
+	/** Stored vertices across all chunks. */
+	int32 GetNumVertices() const;
+
+	/** Bytes held by chunk storage. */
+	int64 GetAllocatedSize() const;
+
+	/** Chunks as a versioned byte blob (the unsimplified tail since the last vertex is not included). */
+	void Save(TArray<uint8>& OutData) const;
+
+	/** Replace the trail with Save() data. False (trail unchanged) if the data is malformed. */
+	bool Load(TConstArrayView<uint8> Data);
+
+private:
+	struct FChunk
+	{
+		/** Quantized first / last vertex and bounds of all vertices. */
+		FIntPoint First = FIntPoint::ZeroValue;
+		FIntPoint Last = FIntPoint::ZeroValue;
+		FIntRect Bounds;
+
+		int32 NumPoints = 0;
+
+		/** Zigzag varint (dX, dY) per vertex after the first. */
+		TArray<uint8> Deltas;
+	};
+
+	/** Quantize P and append it to the open chunk (opening a new one when needed). */
+	void CommitVertex(const FVector2D& P);
+
+	/** Decode a chunk's vertices to world positions. */
+	void DecodeChunk(const FChunk& Chunk, TArray<FVector2D>& Out) const;
+
+	/** Oldest first. */
+	TArray<FChunk> Chunks;
+
+	/** Whether the newest chunk continues the strip being recorded. */
+	bool bChunkOpen = false;
+
+	/** Online simplification: last committed vertex and the samples since it (the newest is the live tail). */
+	bool bHasAnchor = false;
+	FVector2D Anchor = FVector2D::ZeroVector;
+	TArray<FVector2D> Window;
+
+	mutable TArray<FVector2D> DecodeScratch;
+};
@@ -0,0 +1,80 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Map/VCMapTrail.h"
+#include "VCMapTrailRecorder.generated.h"
+
+class APlayerController;
+
+/**
+ * Records where each local player has been, for the world map's breadcrumb trail.
+ *
+ * Every SampleInterval the controlled pawn's XY position goes into that player's FVCMapTrail,
+ * which simplifies and packs it as it arrives (see FVCMapTrail). A jump of more than
+ * TeleportDistance between samples, or a new pawn (respawn), breaks the trail instead of drawing
+ * a line across the map. Trails are per world and not replicated; SaveTrail / LoadTrail hand the
+ * packed form to whatever persists the player's state.
+ */
+UCLASS()
+class VOXELCHARACTERPLUGIN_API UVCMapTrailRecorder : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Convenience lookup (null outside game worlds). */
+	static UVCMapTrailRecorder* Get(const UObject* WorldContextObject);
+
+	/** Seconds between position samples. */
+	float SampleInterval = 0.5f;
+
+	/** A move farther than this (world units) between samples starts a new strip. */
+	float TeleportDistance = 5000.0f;
+
+	/** The player's trail, or null if nothing was recorded for it yet. */
+	const FVCMapTrail* GetTrail(const APlayerController* PlayerController) const;
+
+	/** Forget a player's trail. */
+	void ClearTrail(const APlayerController* PlayerController);
+
+	/** Packed trail for persistence (empty if none). */
+	void SaveTrail(const APlayerController* PlayerController, TArray<uint8>& OutData) const;
+
+	/** Restore a SaveTrail() blob; recording continues as a new strip. False if the data is malformed. */
+	bool LoadTrail(const APlayerController* PlayerController, TConstArrayView<uint8> Data);
+
+	// --- UTickableWorldSubsystem ---
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override
+	{
+		if (const UWorld* World = Cast<UWorld>(Outer))
+		{
+			return World->IsGameWorld();
+		}
+		return false;
+	}
+
+private:
+	struct FPlayerTrail
+	{
+		TWeakObjectPtr<const APlayerController> PlayerController;
+		TWeakObjectPtr<const APawn> Pawn;
+		FVCMapTrail Trail;
+		FVector2D LastSample = FVector2D::ZeroVector;
+		bool bHasSample = false;
+	};
+
+	FPlayerTrail* FindEntry(const APlayerController* PlayerController);
+	const FPlayerTrail* FindEntry(const APlayerController* PlayerController) const;
+	FPlayerTrail& FindOrAddEntry(const APlayerController* PlayerController);
+
+	TArray<FPlayerTrail> Players;
+
+	float TimeUntilSample = 0.0f;
+};
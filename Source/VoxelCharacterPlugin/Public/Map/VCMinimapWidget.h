@@ -4,10 +4,16 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "Map/VCMapBlitter.h"
+#include "Map/VCMapTextureUploader.h"
+#include "Map/VCMapMarkerRegistry.h"
+#include "Map/VCMapMarkerAsyncGather.h"
+#include "Map/VCMapTileRequestTracker.h"
 #include "VCMinimapWidget.generated.h"
 
 class UVoxelMapSubsystem;
-class UVCMapMarkerRegistry;
+class UVCMapTileCache;
+class UVCMapMarkerLayer;
 class UImage;
 class UTextBlock;
 class UCanvasPanel;
@@ -23,6 +29,17 @@ class USizeBox;
  * The map image is oversized by sqrt(2) so it fills the visible square
  * at any rotation angle. A SizeBox with ClipToBounds crops the result.
  *
+ * The texture is a toroidal ring buffer anchored to a world-space pixel
+ * grid: world pixel (GX, GY) always lives at texel (GX mod Size, GY mod Size).
+ * When the player moves, only the newly exposed rows/columns (and tiles that
+ * became ready in view) are rasterized; the wrap-around is undone by the
+ * image brush's UV region with tiled (wrap) sampling.
+ *
+ * Refreshes are gated on a change key: the view moving by a whole map pixel,
+ * a tile in view becoming ready, or the marker registry's revision. Rotation
+ * and the sub-pixel glide are render transforms on the map image and marker
+ * layer, so an idle player (even one turning the camera) rebuilds nothing.
+ *
  * Widget tree is built programmatically in NativeOnInitialized()
  * following the project's C++ widget construction pattern.
  */
@@ -40,7 +57,7 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "Minimap")
 	float MinimapWorldRadius = 16000.0f;
 
-	/** Seconds between texture refreshes (throttle). */
+	/** Seconds between change checks (refreshes only happen when something changed). */
 	UPROPERTY(EditDefaultsOnly, Category = "Minimap")
 	float UpdateInterval = 0.1f;
 
@@ -54,23 +71,36 @@ public:
 
 protected:
 	virtual void NativeOnInitialized() override;
+	virtual void NativeDestruct() override;
 	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
 
 private:
 	/** Build the widget tree programmatically. */
 	void BuildWidgetTree();
 
-	/** Rebuild the map texture from tile data. */
-	void RefreshMapTexture();
+	/** Texture edge (oversized for rotation) and world units per texel for the current settings. */
+	void GetRingGeometry(int32& OutTexSize, double& OutWorldPerPixel) const;
+
+	/** Scroll the ring buffer to the player and rasterize what became visible or ready. */
+	void RefreshMapTexture(const FVector& PlayerPos);
 
 	/** Create or recreate the dynamic texture. */
 	void EnsureTexture(int32 TexSize);
 
+	/** Rasterize world pixels [Min, Min + Size) into their ring-buffer texels. */
+	void RasterizeRingRect(const FIntPoint& Min, const FIntPoint& Size, double WorldPerPixel);
+
+	/** OnMapTileReady — queue the tile for re-rasterization if it is in view. */
+	void HandleMapTileReady(FIntPoint TileCoord);
+
+	/** Tile cache OnRegionUpdated — level-0 updates (tiles read back from disk) patch like ready tiles. */
+	void HandleMapRegionUpdated(int32 Level, const FIntPoint& Coord);
+
 	/**
-	 * Refresh marker dots from the marker registry: world offsets from the player are scaled to
-	 * pixels and rotated by the same angle as the map image, so dots stay glued to the terrain.
+	 * Refresh marker dots from the marker registry, laid out in unrotated ring pixels around the
+	 * view centre; the layer carries the map image's render transform, so dots stay glued to the terrain.
 	 */
-	void UpdateMarkers(const FVector& PlayerPos, float MapAngleDeg);
+	void UpdateMarkers(const FVector& PlayerPos);
 
 	// Widget tree references
 	UPROPERTY()
@@ -98,12 +128,55 @@ private:
 	UPROPERTY()
 	TObjectPtr<UTexture2D> MapTexture;
 
-	/** Pooled marker dot widgets (created on demand, hidden when unused). */
+	/** All marker dots, painted by one leaf widget. */
 	UPROPERTY()
-	TArray<TObjectPtr<UImage>> MarkerDots;
+	TObjectPtr<UVCMapMarkerLayer> MarkerLayer;
 
 	TWeakObjectPtr<UVoxelMapSubsystem> MapSubsystem;
 	TWeakObjectPtr<UVCMapMarkerRegistry> MarkerRegistry;
+
+	/** Gathered markers, reused across refreshes (capacity kept, so steady-state refreshes don't allocate). */
+	TArray<FVCMapMarker> MarkerScratch;
+	TWeakObjectPtr<UVCMapTileCache> TileCache;
 	float TimeSinceLastUpdate = 0.0f;
 	int32 CurrentTextureSize = 0;
+
+	/** CPU staging copy of the ring-buffer texture (CurrentTextureSize^2), uploaded in dirty rects. */
+	FVCMapTextureUploader RingBuffer;
+
+	/** World-pixel coordinate of the view's min corner for the content in RingBuffer. */
+	FIntPoint RingOrigin = FIntPoint::ZeroValue;
+
+	/** World units per pixel the ring was rasterized at (a change forces a full redraw). */
+	double RingWorldPerPixel = 0.0;
+
+	/** False until the ring holds a complete view (first refresh, resize, teleport). */
+	bool bRingValid = false;
+
+	/** Tile -> ring resampler (tables reused across refreshes). */
+	FVCMapBlitter Blitter;
+
+	/** Tiles already asked of the map subsystem; only newly visible ones are requested. */
+	FVCMapTileRequestTracker TileRequests;
+
+	/** Worker-safe marker sources for the current view, run on a task; the latest finished set is drawn. */
+	FVCMapMarkerAsyncGather AsyncMarkers;
+
+	/** Registry revision the marker layer was built from (see bMarkersValid). */
+	uint32 DrawnMarkerRevision = 0;
+	bool bMarkersValid = false;
+
+	/** Last coordinate text / render transform applied, so unchanged values are not re-set. */
+	FIntPoint DisplayedVoxelCoord = FIntPoint(MAX_int32, MAX_int32);
+	float AppliedMapAngleDeg = TNumericLimits<float>::Max();
+	FVector2D AppliedMapTranslation = FVector2D::ZeroVector;
+
+	/** Tiles in view that became ready since the last refresh. */
+	TSet<FIntPoint> ReadyTilesSinceRefresh;
+
+	/** Delegate handle for tile ready events. */
+	FDelegateHandle TileReadyHandle;
+
+	/** Delegate handle for the tile cache's region updates. */
+	FDelegateHandle RegionUpdatedHandle;
 };
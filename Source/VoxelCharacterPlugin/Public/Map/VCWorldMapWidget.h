@@ -4,10 +4,15 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "Map/VCMapBlitter.h"
+#include "Map/VCMapTextureUploader.h"
+#include "Map/VCMapMarkerRegistry.h"
+#include "Map/VCMapMarkerAsyncGather.h"
 #include "VCWorldMapWidget.generated.h"
 
 class UVoxelMapSubsystem;
-class UVCMapMarkerRegistry;
+class UVCMapTileCache;
+class UVCMapMarkerLayer;
 class UImage;
 class UTextBlock;
 class UCanvasPanel;
@@ -51,10 +56,30 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "WorldMap")
 	float MarkerDotSize = 8.0f;
 
+	/** Screen-space cluster cell in pixels: markers closer than about this merge into one count badge. */
+	UPROPERTY(EditDefaultsOnly, Category = "WorldMap")
+	float MarkerClusterCellSize = 48.0f;
+
 	/** Seconds between marker refreshes (gathering runs deterministic placement over the view). */
 	UPROPERTY(EditDefaultsOnly, Category = "WorldMap")
 	float MarkerUpdateInterval = 0.5f;
 
+	/** Draw the owning player's breadcrumb trail (UVCMapTrailRecorder) under the markers. */
+	UPROPERTY(EditDefaultsOnly, Category = "WorldMap")
+	bool bShowTrail = true;
+
+	/** Trail line colour. */
+	UPROPERTY(EditDefaultsOnly, Category = "WorldMap")
+	FLinearColor TrailColor = FLinearColor(1.0f, 0.85f, 0.3f, 0.8f);
+
+	/** Trail line width in pixels. */
+	UPROPERTY(EditDefaultsOnly, Category = "WorldMap")
+	float TrailThickness = 2.0f;
+
+	/** Milliseconds per frame spent refining the map after a zoom (the rescaled old texture shows meanwhile). */
+	UPROPERTY(EditDefaultsOnly, Category = "WorldMap")
+	float ProgressiveRenderBudgetMs = 4.0f;
+
 	/** Refresh the map texture from subsystem data. Call after opening or when new tiles arrive. */
 	void RefreshMap();
 
@@ -72,15 +97,54 @@ private:
 	/** Build the widget tree programmatically. */
 	void BuildWidgetTree();
 
-	/** Rebuild the map texture to show tiles around PanOffset at CurrentZoom. */
+	/** Blit view and super-tile level for Zoom (world-anchored north-up grid). False without map data. */
+	bool ComputeView(float Zoom, FVCMapBlitView& OutView, int32& OutLodLevel);
+
+	/** Min grid pixel of the TexSize-square window centred on PanOffset. */
+	FIntPoint ComputeViewOrigin(const FVCMapBlitView& View, int32 TexSize) const;
+
+	/** Create WorldMapTexture (wrap addressing) and MapBuffer at TexSize if needed. */
+	bool EnsureMapTexture(int32 TexSize);
+
+	/** Synchronously rebuild the whole map texture around PanOffset at CurrentZoom. */
 	void RebuildMapTexture();
 
+	/** Move the ring window to PanOffset, rasterizing only the strips that scrolled into view. */
+	void ScrollToPan();
+
+	/** Begin refining the view for CurrentZoom; the current texture is shown rescaled until it completes. */
+	void StartProgressiveRender();
+
+	/** Move the pending view's window to PanOffset, keeping the rows already finished. */
+	void PanProgressiveRender();
+
+	/** Rasterize Rect (window pixels of the pending view) into PendingPixels. False without a cache or buffer. */
+	bool RenderPendingRect(const FIntRect& Rect);
+
+	/** Render row bands of the pending view within ProgressiveRenderBudgetMs; swap it in when complete. */
+	void ContinueProgressiveRender();
+
+	/** Point the image brush at the ring (UV offset of RingOrigin, wrap sampling). */
+	void UpdateMapBrush();
+
+	/** Scale / translate the image so the texture lines up with PanOffset at RenderedWorldPerPixel. */
+	void UpdateMapImageTransform();
+
+	/** Re-rasterize only the footprints of tiles that became ready since the last render. */
+	void UpdateReadyTiles();
+
+	/** Rasterize grid pixels [GridRect.Min, GridRect.Max) of the rendered view into the ring and mark them dirty. */
+	void RasterizeMapRect(const FIntRect& GridRect);
+
 	/** Update the player marker position on the map. */
 	void UpdatePlayerMarker();
 
 	/** Refresh registry markers (dots + labels) over the rendered view (throttled). */
 	void UpdateMarkers();
 
+	/** Rewrite the marker layer's polylines with the trail strips in the rendered view. */
+	void UpdateTrail(const FBox2D& ViewArea);
+
 	// Widget tree references
 	UPROPERTY()
 	TObjectPtr<UCanvasPanel> RootCanvas;
@@ -101,15 +165,20 @@ private:
 	UPROPERTY()
 	TObjectPtr<UTexture2D> WorldMapTexture;
 
-	/** Pooled marker widgets (created on demand, hidden when unused). */
+	/** All marker dots and labels, painted by one leaf widget. */
 	UPROPERTY()
-	TArray<TObjectPtr<UImage>> MarkerDots;
-
-	UPROPERTY()
-	TArray<TObjectPtr<UTextBlock>> MarkerLabels;
+	TObjectPtr<UVCMapMarkerLayer> MarkerLayer;
 
 	TWeakObjectPtr<UVoxelMapSubsystem> MapSubsystem;
 	TWeakObjectPtr<UVCMapMarkerRegistry> MarkerRegistry;
+
+	/** Gathered marker clusters, reused across refreshes (capacity kept, so steady-state refreshes don't allocate). */
+	TArray<FVCMapMarkerCluster> ClusterScratch;
+
+	/** Worker-safe marker sources for the rendered view, run on a task; the latest finished set is clustered in. */
+	FVCMapMarkerAsyncGather AsyncMarkers;
+
+	TWeakObjectPtr<UVCMapTileCache> TileCache;
 	float TimeSinceMarkerUpdate = 1000.0f; // refresh immediately on open
 
 	/** Pan offset in world units (center of the map view). */
@@ -124,12 +193,43 @@ private:
 	/** Delegate handle for tile ready events. */
 	FDelegateHandle TileReadyHandle;
 
+	/** Delegate handle for the tile cache's exploration updates and super-tile builds. */
+	FDelegateHandle RegionUpdatedHandle;
+
+	/** Tile -> texture resampler (tables reused across rebuilds). */
+	FVCMapBlitter Blitter;
+
+	/** CPU staging copy of WorldMapTexture, uploaded in dirty rects. */
+	FVCMapTextureUploader MapBuffer;
+
 	/** Whether the map needs a texture rebuild. */
 	bool bMapDirty = true;
 
+	/** Zoom changed since the last tick (progressive refinement) / pan changed (ring scroll). */
+	bool bZoomDirty = false;
+	bool bPanDirty = false;
+
+	/** Tiles reported ready or explored (and min tiles of built super-tiles) since the last render — patched without a full rebuild. */
+	TSet<FIntPoint> ReadyTilesSinceRender;
+
 	// Cached from last render — used by player marker positioning
-	FIntPoint RenderedCenterTile = FIntPoint(0, 0);
-	int32 RenderedTileRadius = 0;
 	int32 RenderedTexSize = 0;
+
+	/** Displayed world units per screen pixel (changes on zoom before the texture catches up). */
 	float RenderedWorldPerPixel = 0.0f;
+
+	/** Blit view and super-tile level of the texture contents. */
+	FVCMapBlitView RenderedView;
+	int32 RenderedLodLevel = 0;
+
+	/** Grid pixel held by the texture's view min corner; grid pixel G lives at texel G mod RenderedTexSize. */
+	FIntPoint RingOrigin = FIntPoint::ZeroValue;
+
+	/** Progressive refinement in flight: target view, its window, rows done, linear pixels. */
+	bool bProgressiveActive = false;
+	FVCMapBlitView PendingView;
+	int32 PendingLodLevel = 0;
+	FIntPoint PendingOrigin = FIntPoint::ZeroValue;
+	int32 PendingNextRow = 0;
+	TArray<FColor> PendingPixels;
 };
@@ -0,0 +1,90 @@
+// Copyright Daniel Raquel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+/**
+ * Profiling hooks shared across the plugin.
+ *
+ * `stat VoxelCharacter` shows the on-screen counters; the CSV categories below are written by
+ * `csvprofile start` / `-csvprofile` so soak tests get per-frame numbers in files.
+ */
+DECLARE_STATS_GROUP(TEXT("VoxelCharacter"), STATGROUP_VoxelCharacter, STATCAT_Advanced);
+
+/** Voxel edit round-trip and ability activation latencies (milliseconds). */
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(VOXELCHARACTERPLUGIN_API, VCEdits);
+
+/** Movement terrain queries: terrain context refresh and voxel floor traces. */
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(VOXELCHARACTERPLUGIN_API, VCMovement);
+
+/** Camera mode blending and voxel camera collision. */
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(VOXELCHARACTERPLUGIN_API, VCCamera);
+
+/** Minimap / world map refreshes, tile conversion and blits. */
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(VOXELCHARACTERPLUGIN_API, VCMap);
+
+/** Terrain-ready spawn wait (seconds waited, chunks pending). */
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(VOXELCHARACTERPLUGIN_API, VCSpawn);
+
+/** Stress test load: bot count, bot edits, net driver bandwidth (vc.Stress.*). */
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(VOXELCHARACTERPLUGIN_API, VCStress);
+
+/** Plugin RPC / property bandwidth, totals and per connection (bytes per second). */
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(VOXELCHARACTERPLUGIN_API, VCNet);
+
+/**
+ * Fixed-size rolling window of samples with percentile readout.
+ * Cheap to feed every event; percentiles sort a copy of at most Capacity floats.
+ */
+struct FVCSampleWindow
+{
+	static constexpr int32 Capacity = 256;
+
+	void Add(float Value)
+	{
+		if (Samples.Num() < Capacity)
+		{
+			Samples.Add(Value);
+		}
+		else
+		{
+			Samples[Next] = Value;
+		}
+		Next = (Next + 1) % Capacity;
+		++TotalCount;
+	}
+
+	/** Nearest-rank percentile (Fraction in [0,1]) over the current window; 0 when empty. */
+	float GetPercentile(float Fraction) const
+	{
+		if (Samples.Num() == 0)
+		{
+			return 0.0f;
+		}
+		TArray<float, TInlineAllocator<Capacity>> Sorted(Samples);
+		Sorted.Sort();
+		const int32 Rank = FMath::Clamp(FMath::CeilToInt(Fraction * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+		return Sorted[Rank];
+	}
+
+	/** Samples currently in the window. */
+	int32 Num() const { return Samples.Num(); }
+
+	/** Samples ever added (including ones rolled out of the window). */
+	int64 GetTotalCount() const { return TotalCount; }
+
+	void Reset()
+	{
+		Samples.Reset();
+		Next = 0;
+		TotalCount = 0;
+	}
+
+private:
+	TArray<float> Samples;
+	int32 Next = 0;
+	int64 TotalCount = 0;
+};